@@ -0,0 +1,100 @@
+/*
+ * arena.cpp - monotonic memory arena for temporary objects
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arena.h"
+
+#include <vector>
+#include <new>
+#include <cstddef>
+using namespace std;
+
+Arena::Arena(size_t bs)
+{
+    blockSize = bs;
+    current = 0;
+    used = 0;
+    allocs = 0;
+    heapAllocs = 0;
+    requests = 0;
+    size = 0;
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+// returns memory of size bytes (aligned to ALIGNMENT)
+void *Arena::allocate(size_t n)
+{
+    requests++;
+    n = (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    // the first block with enough free space
+    while (current < blocks.size() && used + n > blocks[current].size) {
+        current++;
+        used = 0;
+    }
+
+    // new block
+    if (current == blocks.size()) {
+        Block b;
+        b.size = (n > blockSize)? n: blockSize;
+        b.data = static_cast<char *>(::operator new(b.size));
+        blocks.push_back(b);
+        allocs++;
+        size += b.size;
+    }
+
+    void *p = blocks[current].data + used;
+    used += n;
+    return p;
+}
+
+// returns memory of size bytes from the heap
+void *Arena::allocateHeap(size_t n)
+{
+    heapAllocs++;
+    return ::operator new(n);
+}
+
+// releases all memory allocated after mark m
+void Arena::rewind(const Mark &m)
+{
+    current = m.block;
+    used = m.used;
+}
+
+// releases all memory (blocks are kept)
+void Arena::reset()
+{
+    current = 0;
+    used = 0;
+}
+
+// frees all blocks
+void Arena::release()
+{
+    for (unsigned i = 0; i < blocks.size(); i++)
+        ::operator delete(blocks[i].data);
+    blocks.clear();
+    reset();
+    size = 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * arena.h - monotonic memory arena for temporary objects
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+// monotonic memory arena - memory is taken from big blocks and it's released
+// in bulk by rewinding to the mark (blocks are kept for the next use)
+class Arena
+{
+public:
+    // default size of block
+    static const size_t BLOCK_SIZE = 64 * 1024;
+    // alignment of allocated memory
+    static const size_t ALIGNMENT = 16;
+
+    // position in arena
+    struct Mark
+    {
+        unsigned block;
+        size_t used;
+    };
+
+    Arena(size_t blockSize = BLOCK_SIZE);
+    ~Arena();
+
+    // returns memory of size bytes
+    void *allocate(size_t size);
+    // returns memory of size bytes from the heap (it's only counted by arena
+    // and it has to be freed by operator delete)
+    void *allocateHeap(size_t size);
+
+    // returns the current position
+    inline Mark mark() const
+    {
+        Mark m;
+        m.block = current;
+        m.used = used;
+        return m;
+    }
+    // releases all memory allocated after mark m
+    void rewind(const Mark &m);
+    // releases all memory (blocks are kept)
+    void reset();
+    // frees all blocks
+    void release();
+
+    // number of blocks allocated from the system
+    inline unsigned long getAllocsCount() const { return allocs; }
+    // number of heap allocations counted by arena
+    inline unsigned long getHeapAllocsCount() const { return heapAllocs; }
+    // number of allocation requests
+    inline unsigned long getRequestsCount() const { return requests; }
+    // size of all blocks
+    inline size_t getSize() const { return size; }
+
+private:
+    struct Block
+    {
+        char *data;
+        size_t size;
+    };
+
+    // not copyable
+    Arena(const Arena &);
+    Arena &operator=(const Arena &);
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    unsigned current;
+    size_t used;
+
+    unsigned long allocs;
+    unsigned long heapAllocs;
+    unsigned long requests;
+    size_t size;
+};
+
+// arena scope - arena is rewound when the scope is left
+class ArenaScope
+{
+public:
+    ArenaScope(Arena &a) : arena(a), m(a.mark()) {}
+    ~ArenaScope() { arena.rewind(m); }
+
+private:
+    Arena &arena;
+    Arena::Mark m;
+};
+
+// STL allocator taking memory from arena (operator new is used without arena
+// or with heap set, heap allocations are counted by arena), deallocation
+// is noop for arena memory
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <typename U> struct rebind { typedef ArenaAllocator<U> other; };
+
+    ArenaAllocator(Arena *a = 0, bool h = false) throw() : arena(a), heap(h) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &a) throw() : arena(a.getArena()), heap(a.isHeap()) {}
+
+    inline pointer address(reference x) const { return &x; }
+    inline const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void * = 0)
+    {
+        if (arena && heap)
+            return static_cast<pointer>(arena->allocateHeap(n * sizeof(T)));
+        else if (arena)
+            return static_cast<pointer>(arena->allocate(n * sizeof(T)));
+        else
+            return static_cast<pointer>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(pointer p, size_type)
+    {
+        if (!arena || heap)
+            ::operator delete(p);
+    }
+
+    inline size_type max_size() const throw() { return size_t(-1) / sizeof(T); }
+
+    inline void construct(pointer p, const T &value) { new (static_cast<void *>(p)) T(value); }
+    inline void destroy(pointer p) { p->~T(); }
+
+    inline Arena *getArena() const { return arena; }
+    inline bool isHeap() const { return heap; }
+
+private:
+    Arena *arena;
+    bool heap;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T> &a1, const ArenaAllocator<U> &a2)
+{
+    return a1.getArena() == a2.getArena() && a1.isHeap() == a2.isHeap();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T> &a1, const ArenaAllocator<U> &a2)
+{
+    return !(a1 == a2);
+}
+
+#endif // ARENA_H
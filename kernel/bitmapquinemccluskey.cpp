@@ -0,0 +1,436 @@
+/*
+ * bitmapquinemccluskey.cpp - prime implicants generation on bit-parallel truth table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "bitmapquinemccluskey.h"
+#include "formula.h"
+#include "term.h"
+#include "termscontainer.h"
+#include "threadpool.h"
+
+#include <vector>
+#include <stdint.h>
+
+// SIMD kernel is compiled for x86 with runtime CPU dispatch
+#if !defined(BMIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+        && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define BITMAPQM_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// positions of word which have bit v of their index zero (v < 6)
+static const uint64_t LOW_PATTERNS[6] = {
+    0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+    0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL
+};
+
+static inline unsigned popCount(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    unsigned c = 0;
+    for (; w; c++)
+        w &= w - 1;
+    return c;
+#endif
+}
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+// returns number of words of bitmap with k variables
+static inline unsigned wordsCount(unsigned k)
+{
+    return (k > 6)? 1u << (k - 6): 1;
+}
+
+// moves bits at positions with zero bit v (v < 6) of word to the low half
+static inline uint64_t compactLow(uint64_t t, unsigned v)
+{
+    for (unsigned j = v; j < 5; j++)
+        t = (t | (t >> (1u << j))) & LOW_PATTERNS[j + 1];
+    return t;
+}
+
+// accumulates in ANDed with in shifted by variable v to acc (position x gets
+// in[x] & in[x ^ 2^v]) - implicants of bitmap in which can be extended by v
+static void extendableScalar(const uint64_t *in, uint64_t *acc, unsigned words, unsigned v)
+{
+    if (v < 6) {
+        unsigned s = 1u << v;
+        for (unsigned w = 0; w < words; w++) {
+            uint64_t t = in[w] & (in[w] >> s) & LOW_PATTERNS[v];
+            acc[w] |= t | (t << s);
+        }
+    }
+    else {
+        unsigned d = 1u << (v - 6);
+        for (unsigned b = 0; b < words; b += 2 * d) {
+            for (unsigned w = b; w < b + d; w++) {
+                uint64_t c = in[w] & in[w + d];
+                acc[w] |= c;
+                acc[w + d] |= c;
+            }
+        }
+    }
+}
+
+// out is bitmap of k - 1 variables with implicants of bitmap in (k variables)
+// extended by variable v, returns whether out is nonzero
+static bool removeScalar(const uint64_t *in, uint64_t *out, unsigned k, unsigned v)
+{
+    uint64_t any = 0;
+    if (v < 6) {
+        unsigned s = 1u << v;
+        if (k <= 6) {
+            out[0] = compactLow(in[0] & (in[0] >> s) & LOW_PATTERNS[v], v);
+            return out[0] != 0;
+        }
+        for (unsigned w = 0; w < wordsCount(k - 1); w++) {
+            uint64_t lo = in[2 * w], hi = in[2 * w + 1];
+            out[w] = compactLow(lo & (lo >> s) & LOW_PATTERNS[v], v)
+                    | (compactLow(hi & (hi >> s) & LOW_PATTERNS[v], v) << 32);
+            any |= out[w];
+        }
+    }
+    else {
+        unsigned d = 1u << (v - 6);
+        for (unsigned b = 0; b < wordsCount(k); b += 2 * d) {
+            for (unsigned w = b; w < b + d; w++) {
+                out[b / 2 + w - b] = in[w] & in[w + d];
+                any |= out[b / 2 + w - b];
+            }
+        }
+    }
+    return any != 0;
+}
+
+#ifdef BITMAPQM_X86
+// AVX2 kernels - four words in one register (partner words have to be
+// at least one register away)
+__attribute__((target("avx2")))
+static void extendableAvx2(const uint64_t *in, uint64_t *acc, unsigned words, unsigned v)
+{
+    if (words < 4 || (v >= 6 && v < 8)) {
+        extendableScalar(in, acc, words, v);
+        return;
+    }
+
+    if (v < 6) {
+        __m128i s = _mm_cvtsi32_si128(1 << v);
+        __m256i pattern = _mm256_set1_epi64x(LOW_PATTERNS[v]);
+        for (unsigned w = 0; w < words; w += 4) {
+            __m256i x = _mm256_loadu_si256((const __m256i *) (in + w));
+            __m256i t = _mm256_and_si256(_mm256_and_si256(x, _mm256_srl_epi64(x, s)), pattern);
+            __m256i a = _mm256_loadu_si256((const __m256i *) (acc + w));
+            a = _mm256_or_si256(a, _mm256_or_si256(t, _mm256_sll_epi64(t, s)));
+            _mm256_storeu_si256((__m256i *) (acc + w), a);
+        }
+    }
+    else {
+        unsigned d = 1u << (v - 6);
+        for (unsigned b = 0; b < words; b += 2 * d) {
+            for (unsigned w = b; w < b + d; w += 4) {
+                __m256i c = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (in + w)),
+                        _mm256_loadu_si256((const __m256i *) (in + w + d)));
+                __m256i a1 = _mm256_loadu_si256((const __m256i *) (acc + w));
+                __m256i a2 = _mm256_loadu_si256((const __m256i *) (acc + w + d));
+                _mm256_storeu_si256((__m256i *) (acc + w), _mm256_or_si256(a1, c));
+                _mm256_storeu_si256((__m256i *) (acc + w + d), _mm256_or_si256(a2, c));
+            }
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static bool removeAvx2(const uint64_t *in, uint64_t *out, unsigned k, unsigned v)
+{
+    if (v < 8)
+        return removeScalar(in, out, k, v);
+
+    __m256i any = _mm256_setzero_si256();
+    unsigned d = 1u << (v - 6);
+    for (unsigned b = 0; b < wordsCount(k); b += 2 * d) {
+        for (unsigned w = b; w < b + d; w += 4) {
+            __m256i c = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (in + w)),
+                    _mm256_loadu_si256((const __m256i *) (in + w + d)));
+            _mm256_storeu_si256((__m256i *) (out + b / 2 + w - b), c);
+            any = _mm256_or_si256(any, c);
+        }
+    }
+    return !_mm256_testz_si256(any, any);
+}
+#endif
+
+typedef void (*ExtendableKernel)(const uint64_t *in, uint64_t *acc, unsigned words, unsigned v);
+typedef bool (*RemoveKernel)(const uint64_t *in, uint64_t *out, unsigned k, unsigned v);
+
+// selects the widest kernels supported by CPU
+static bool hasAvx2()
+{
+#ifdef BITMAPQM_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+#ifdef BITMAPQM_X86
+static const ExtendableKernel extendableKernel = hasAvx2()? extendableAvx2: extendableScalar;
+static const RemoveKernel removeKernel = hasAvx2()? removeAvx2: removeScalar;
+#else
+static const ExtendableKernel extendableKernel = extendableScalar;
+static const RemoveKernel removeKernel = removeScalar;
+#endif
+
+// returns bits of y deposited to the positions of ones of freeVars (the lowest
+// bit of y goes to the lowest one), only ones of freeVars are iterated
+static inline uint64_t depositScalar(uint64_t y, uint64_t freeVars)
+{
+    uint64_t x = 0;
+    for (uint64_t bit = 1; freeVars; bit <<= 1) {
+        if (y & bit)
+            x |= freeVars & (~freeVars + 1);
+        freeVars &= freeVars - 1;
+    }
+    return x;
+}
+
+#ifdef BITMAPQM_X86
+// BMI2 deposit - one instruction
+__attribute__((target("bmi2")))
+static uint64_t depositBmi2(uint64_t y, uint64_t freeVars)
+{
+    return _pdep_u64(y, freeVars);
+}
+#endif
+
+// whether CPU has BMI2 instructions
+static bool hasBmi2()
+{
+#ifdef BITMAPQM_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2");
+#else
+    return false;
+#endif
+}
+
+static const bool bmi2 = hasBmi2();
+
+// returns liters of free variables (the ones which aren't in missings) set
+// to bits of y
+static inline uint64_t deposit(uint64_t y, uint64_t freeVars)
+{
+#ifdef BITMAPQM_X86
+    if (bmi2)
+        return depositBmi2(y, freeVars);
+#endif
+    return depositScalar(y, freeVars);
+}
+
+
+// task generating primes with missings which contain subset idx of top variables
+// and any subset of the other variables (depth-first search over missings),
+// bitmap of missings M is indexed only by liters of variables which aren't in M
+class BitmapQuineMcCluskey::MaskTask : public ThreadTask
+{
+public:
+    MaskTask(const vector<uint64_t> &t, unsigned v, vector<vector<Term> > &p) :
+            table(t), vc(v), primes(p) {}
+
+    void run(unsigned idx)
+    {
+        unsigned top = (vc > TASK_VARS)? vc - TASK_VARS: 0;
+        unsigned mask = idx << top;
+
+        // top variables are removed from the highest one
+        // (positions of the lower variables are kept)
+        Search s;
+        s.levels.assign(vc + 1, vector<uint64_t>());
+        s.levels[0] = table;
+        unsigned k = vc;
+        for (unsigned v = vc; v > top; v--) {
+            if ((mask >> (v - 1)) & 1) {
+                vector<uint64_t> &in = s.levels[vc - k];
+                vector<uint64_t> &out = s.levels[vc - k + 1];
+                out.resize(wordsCount(k - 1));
+                if (!removeKernel(&in[0], &out[0], k, v - 1))
+                    return;
+                k--;
+            }
+        }
+        s.acc.resize(wordsCount(k));
+        s.out = &primes[idx];
+        search(s, k, mask, top);
+    }
+
+private:
+    // state of one search
+    struct Search
+    {
+        // bitmaps of implicants for every number of missings
+        vector<vector<uint64_t> > levels;
+        // bitmap of implicants which can be extended
+        vector<uint64_t> acc;
+        // found primes
+        vector<Term> *out;
+    };
+
+    // emits primes with missings mask (k variables aren't in mask) and
+    // searches masks with added variables below bound
+    void search(Search &s, unsigned k, unsigned mask, unsigned bound)
+    {
+        unsigned words = wordsCount(k);
+        const uint64_t *implicants = &s.levels[vc - k][0];
+        uint64_t *acc = &s.acc[0];
+
+        // implicants which can be extended by any variable aren't prime
+        for (unsigned w = 0; w < words; w++)
+            acc[w] = 0;
+        for (unsigned v = 0; v < k; v++)
+            extendableKernel(implicants, acc, words, v);
+
+        uint64_t freeVars = ~uint64_t(mask) & ((uint64_t(1) << vc) - 1);
+        for (unsigned w = 0; w < words; w++) {
+            for (uint64_t bits = implicants[w] & ~acc[w]; bits; bits &= bits - 1) {
+                uint64_t x = deposit(uint64_t(w) * 64 + firstOne(bits), freeVars);
+                s.out->push_back(Term(Term::bits_t(x), Term::bits_t(uint64_t(mask)), vc));
+            }
+        }
+
+        // variables below bound have the same positions as in the table
+        if (bound == 0)
+            return;
+        vector<uint64_t> &next = s.levels[vc - k + 1];
+        next.resize(wordsCount(k - 1));
+        for (unsigned v = 0; v < bound; v++) {
+            if (removeKernel(implicants, &next[0], k, v))
+                search(s, k - 1, mask | (1u << v), v);
+        }
+    }
+
+    const vector<uint64_t> &table;
+    unsigned vc;
+    vector<vector<Term> > &primes;
+};
+
+
+Formula *BitmapQuineMcCluskey::minimize(Formula *f, bool dbg)
+{
+    if (f->getVarsCount() > MAX_VARS)
+        return QuineMcCluskey::minimize(f, dbg);
+
+    return minimizeCubes(f);
+}
+
+// truth table of on-set and dc-set is searched by tasks in parallel,
+// primes are concatenated in the order of tasks
+void BitmapQuineMcCluskey::findPrimeImplicants()
+{
+    if (!(of && mf))
+        return;
+
+    unsigned vc = of->getVarsCount();
+    if (vc > MAX_VARS) {
+        QuineMcCluskey::findPrimeImplicants();
+        return;
+    }
+
+    vector<uint64_t> table;
+    fillBitmap(table, false);
+
+    unsigned tasksCount = 1u << ((vc > TASK_VARS)? TASK_VARS: vc);
+    vector<vector<Term> > primes(tasksCount);
+    MaskTask task(table, vc, primes);
+    ThreadPool::instance()->run(task, tasksCount);
+
+    vector<Term> v;
+    for (unsigned i = 0; i < tasksCount; i++)
+        v.insert(v.end(), primes[i].begin(), primes[i].end());
+    mf->terms->swapContainer(v);
+}
+
+void BitmapQuineMcCluskey::fillBitmap(vector<uint64_t> &bitmap, bool onlyExplicits) const
+{
+    unsigned vc = of->getVarsCount();
+    bitmap.assign(wordsCount(vc), 0);
+
+    vector<Term> *cubes = getTermsVector(of->terms, onlyExplicits);
+    uint64_t full = (uint64_t(1) << vc) - 1;
+    for (unsigned i = 0; i < cubes->size(); i++) {
+        uint64_t m = cubes->at(i).getMissing().low() & full;
+        uint64_t l = cubes->at(i).getLiters().low() & ~m & full;
+        // bits of the cube in one word are made from subsets of missings
+        // of the lowest six variables, the word is set for all subsets of
+        // the other missings (cube with many missings sets whole words)
+        uint64_t lowMissing = m & 63, word = 0, sub = 0;
+        do {
+            word |= uint64_t(1) << ((l & 63) | sub);
+            sub = (sub - lowMissing) & lowMissing;
+        } while (sub);
+        uint64_t highMissing = m >> 6, high = l >> 6;
+        sub = 0;
+        do {
+            bitmap[high | sub] |= word;
+            sub = (sub - highMissing) & highMissing;
+        } while (sub);
+    }
+    delete cubes;
+}
+
+vector<Term> *BitmapQuineMcCluskey::getCoverTerms() const
+{
+    unsigned vc = of->getVarsCount();
+    if (vc > MAX_VARS)
+        return QuineMcCluskey::getCoverTerms();
+
+    vector<uint64_t> on;
+    fillBitmap(on, true);
+    unsigned long count = 0;
+    for (unsigned w = 0; w < on.size(); w++)
+        count += popCount(on[w]);
+    if (count > MAX_COVER_MINTERMS)
+        return getTermsVector(of->terms, true);
+
+    vector<Term> *minterms = new vector<Term>;
+    minterms->reserve(count);
+    for (unsigned w = 0; w < on.size(); w++) {
+        for (uint64_t bits = on[w]; bits; bits &= bits - 1)
+            minterms->push_back(Term(Term::bits_t(uint64_t(w) * 64 + firstOne(bits)),
+                    Term::bits_t(), vc));
+    }
+    return minterms;
+}
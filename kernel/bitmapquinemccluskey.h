@@ -0,0 +1,65 @@
+/*
+ * bitmapquinemccluskey.h - prime implicants generation on bit-parallel truth table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef BITMAPQUINEMCCLUSKEY_H
+#define BITMAPQUINEMCCLUSKEY_H
+
+#include "quinemccluskey.h"
+#include "term.h"
+
+#include <vector>
+#include <stdint.h>
+
+// prime implicants are generated by word operations on truth table (bitmap
+// of on-set and dc-set) - implicants with missings M are the bitmap of
+// implicants with missings M - {v} ANDed with its copy shifted by v, the
+// implicant is prime if it isn't in the bitmap of any bigger missings,
+// covering of QM is used (functions with more than MAX_VARS variables are
+// minimized by QM)
+class BitmapQuineMcCluskey : public QuineMcCluskey
+{
+public:
+    // maximal number of variables (truth table has 2^MAX_VARS bits)
+    static const unsigned MAX_VARS = 24;
+
+    // complete minimization (without debug data)
+    Formula *minimize(Formula *f, bool dbg = false);
+
+    // creates prime implicants
+    void findPrimeImplicants();
+
+protected:
+    // returns on-set minterms or cubes which have to be covered
+    std::vector<Term> *getCoverTerms() const;
+
+private:
+    // missings are split to tasks by subsets of TASK_VARS top variables
+    static const unsigned TASK_VARS = 6;
+
+    // task generating primes with missings from one subset of top variables
+    class MaskTask;
+    friend class MaskTask;
+
+    // sets bits of minterms of all cubes (or only of explicits cubes)
+    void fillBitmap(std::vector<uint64_t> &bitmap, bool onlyExplicits) const;
+};
+
+#endif // BITMAPQUINEMCCLUSKEY_H
@@ -0,0 +1,347 @@
+/*
+ * bitmatrix.cpp - bit-matrix and bit-sliced column statistics
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bitmatrix.h"
+
+#include <vector>
+#include <stdint.h>
+
+// SIMD kernels are compiled for x86 with runtime CPU dispatch
+#if !defined(BMIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+        && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define BITMATRIX_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// number of counter lanes - word i of rows data is counted in lane i % LANES
+static const unsigned LANES = 8;
+
+static inline unsigned popCount(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    unsigned c = 0;
+    for (; w; c++)
+        w &= w - 1;
+    return c;
+#endif
+}
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+// adds n words of data to vertical counters lanes[p * LANES + lane]
+static void countScalar(const uint64_t *data, unsigned n, uint64_t *lanes)
+{
+    for (unsigned i = 0; i < n; i++) {
+        uint64_t *lane = lanes + i % LANES;
+        uint64_t carry = data[i];
+        for (unsigned p = 0; carry; p++) {
+            uint64_t t = lane[p * LANES] & carry;
+            lane[p * LANES] ^= carry;
+            carry = t;
+        }
+    }
+}
+
+#ifdef BITMATRIX_X86
+// AVX2 kernel - half of lanes in one register
+__attribute__((target("avx2")))
+static void countAvx2(const uint64_t *data, unsigned n, uint64_t *lanes)
+{
+    unsigned blocks = n / LANES;
+    for (unsigned b = 0; b < blocks; b++) {
+        for (unsigned h = 0; h < LANES; h += 4) {
+            __m256i carry = _mm256_loadu_si256((const __m256i *) (data + b * LANES + h));
+            for (unsigned p = 0; !_mm256_testz_si256(carry, carry); p++) {
+                __m256i *plane = (__m256i *) (lanes + p * LANES + h);
+                __m256i v = _mm256_loadu_si256(plane);
+                _mm256_storeu_si256(plane, _mm256_xor_si256(v, carry));
+                carry = _mm256_and_si256(v, carry);
+            }
+        }
+    }
+    countScalar(data + blocks * LANES, n - blocks * LANES, lanes);
+}
+
+// AVX-512 kernel - all lanes in one register
+__attribute__((target("avx512f")))
+static void countAvx512(const uint64_t *data, unsigned n, uint64_t *lanes)
+{
+    unsigned blocks = n / LANES;
+    for (unsigned b = 0; b < blocks; b++) {
+        __m512i carry = _mm512_loadu_si512((const void *) (data + b * LANES));
+        for (unsigned p = 0; _mm512_test_epi64_mask(carry, carry); p++) {
+            uint64_t *plane = lanes + p * LANES;
+            __m512i v = _mm512_loadu_si512((const void *) plane);
+            _mm512_storeu_si512((void *) plane, _mm512_xor_si512(v, carry));
+            carry = _mm512_and_si512(v, carry);
+        }
+    }
+    countScalar(data + blocks * LANES, n - blocks * LANES, lanes);
+}
+#endif
+
+typedef void (*CountKernel)(const uint64_t *data, unsigned n, uint64_t *lanes);
+
+// returns kernel of counter c or 0 if CPU doesn't support it
+static CountKernel counterKernel(ColumnStats::Counter c)
+{
+#ifdef BITMATRIX_X86
+    __builtin_cpu_init();
+    if (c == ColumnStats::AVX512_COUNTER)
+        return __builtin_cpu_supports("avx512f")? countAvx512: 0;
+    if (c == ColumnStats::AVX2_COUNTER)
+        return __builtin_cpu_supports("avx2")? countAvx2: 0;
+#else
+    if (c != ColumnStats::SCALAR_COUNTER)
+        return 0;
+#endif
+    return countScalar;
+}
+
+// selects the widest kernel supported by CPU
+static ColumnStats::Counter selectCounter()
+{
+    if (counterKernel(ColumnStats::AVX512_COUNTER))
+        return ColumnStats::AVX512_COUNTER;
+    if (counterKernel(ColumnStats::AVX2_COUNTER))
+        return ColumnStats::AVX2_COUNTER;
+    return ColumnStats::SCALAR_COUNTER;
+}
+
+static ColumnStats::Counter counter = selectCounter();
+static CountKernel countKernel = counterKernel(counter);
+
+
+// COLUMN STATS
+
+// returns kernel of counting
+ColumnStats::Counter ColumnStats::getCounter()
+{
+    return counter;
+}
+
+// sets kernel of counting
+bool ColumnStats::setCounter(Counter c)
+{
+    CountKernel k = counterKernel(c);
+    if (!k)
+        return false;
+    counter = c;
+    countKernel = k;
+    return true;
+}
+
+// computes statistics of rows in data
+void ColumnStats::compute(const uint64_t *data, unsigned rowsCount, unsigned w,
+        const uint64_t *mask, bool counting)
+{
+    words = w;
+    ors.assign(words, 0);
+    single.assign(words, 0);
+    if (mask)
+        excluded.assign(mask, mask + words);
+    else
+        excluded.assign(words, 0);
+
+    // ones in columns and rows with single one
+    for (unsigned r = 0; r < rowsCount; r++) {
+        const uint64_t *row = data + r * words;
+        unsigned c = 0;
+        for (unsigned i = 0; i < words; i++) {
+            ors[i] |= row[i];
+            c += popCount(row[i] & ~excluded[i]);
+        }
+        if (c == 1) {
+            for (unsigned i = 0; i < words; i++)
+                single[i] |= row[i] & ~excluded[i];
+        }
+    }
+
+    planesCount = 0;
+    planes.clear();
+    if (!counting || rowsCount == 0)
+        return;
+
+    uint64_t lanes[MAX_PLANES * LANES];
+    for (unsigned i = 0; i < MAX_PLANES * LANES; i++)
+        lanes[i] = 0;
+    countKernel(data, rowsCount * words, lanes);
+
+    // used planes (merging of lanes can add LANES / words bits at most)
+    unsigned used = 0;
+    for (unsigned p = 0; p < MAX_PLANES; p++) {
+        for (unsigned l = 0; l < LANES; l++) {
+            if (lanes[p * LANES + l])
+                used = p + 1;
+        }
+    }
+    planesCount = used + 3;
+    if (planesCount > MAX_PLANES)
+        planesCount = MAX_PLANES;
+
+    // merges lanes counting the same word by bit-sliced adder
+    planes.assign(planesCount * words, 0);
+    for (unsigned l = 0; l < LANES; l++) {
+        unsigned i = l % words;
+        uint64_t carry = 0;
+        for (unsigned p = 0; p < planesCount; p++) {
+            uint64_t a = planes[p * words + i];
+            uint64_t b = lanes[p * LANES + l];
+            planes[p * words + i] = a ^ b ^ carry;
+            carry = (a & b) | (carry & (a ^ b));
+        }
+    }
+}
+
+// returns count of ones in column col
+unsigned ColumnStats::ones(unsigned col) const
+{
+    unsigned count = 0;
+    unsigned i = col / 64;
+    unsigned bit = col % 64;
+    for (unsigned p = 0; p < planesCount; p++)
+        count |= unsigned((planes[p * words + i] >> bit) & 1) << p;
+    return count;
+}
+
+// returns the first column with the most ones (bit-sliced comparison)
+int ColumnStats::maxColumn() const
+{
+    uint64_t cand[MAX_WORDS], t[MAX_WORDS];
+    for (unsigned i = 0; i < words; i++)
+        cand[i] = ~excluded[i];
+
+    bool found = false;
+    for (unsigned p = planesCount; p > 0; p--) {
+        bool any = false;
+        for (unsigned i = 0; i < words; i++) {
+            t[i] = cand[i] & planes[(p - 1) * words + i];
+            any = any || t[i];
+        }
+        if (any) {
+            for (unsigned i = 0; i < words; i++)
+                cand[i] = t[i];
+            found = true;
+        }
+    }
+
+    if (!found)
+        return -1;
+    for (unsigned i = 0; i < words; i++) {
+        if (cand[i])
+            return i * 64 + firstOne(cand[i]);
+    }
+    return -1;
+}
+
+
+// BIT MATRIX
+
+// returns number of words of the row for cols columns
+unsigned BitMatrix::wordsCount(unsigned cols)
+{
+    unsigned n = (cols + 63) / 64;
+    unsigned w = 1;
+    while (w < n)
+        w *= 2;
+    return w;
+}
+
+// sets number of columns and removes all rows and column mask
+void BitMatrix::reset(unsigned c)
+{
+    cols = c;
+    words = wordsCount(cols);
+    rows = 0;
+    data.clear();
+
+    // padding columns are eliminated
+    mask.assign(words, 0);
+    for (unsigned i = 0; i < words; i++) {
+        unsigned low = i * 64;
+        if (cols <= low)
+            mask[i] = ~uint64_t(0);
+        else if (cols < low + 64)
+            mask[i] = ~((uint64_t(1) << (cols - low)) - 1);
+    }
+}
+
+// appends zero row and returns its words
+uint64_t *BitMatrix::addRow()
+{
+    data.resize((rows + 1) * words, 0);
+    return &data[rows++ * words];
+}
+
+// eliminates columns
+void BitMatrix::maskColumns(const uint64_t *columns)
+{
+    for (unsigned i = 0; i < words; i++)
+        mask[i] |= columns[i];
+}
+
+// removes rows which have one in some of columns
+void BitMatrix::removeIntersecting(const uint64_t *columns)
+{
+    removeRows(columns, true);
+}
+
+// removes rows which have no one in all columns
+void BitMatrix::removeDisjoint(const uint64_t *columns)
+{
+    removeRows(columns, false);
+}
+
+// removes rows which (don't) intersect columns - compaction of rows
+void BitMatrix::removeRows(const uint64_t *columns, bool intersecting)
+{
+    unsigned j = 0;
+    for (unsigned r = 0; r < rows; r++) {
+        uint64_t *row = &data[r * words];
+        bool intersects = false;
+        for (unsigned i = 0; i < words && !intersects; i++)
+            intersects = (row[i] & columns[i]) != 0;
+        if (intersects == intersecting)
+            continue;
+        if (r != j) {
+            for (unsigned i = 0; i < words; i++)
+                data[j * words + i] = row[i];
+        }
+        j++;
+    }
+    rows = j;
+    data.resize(rows * words);
+}
@@ -0,0 +1,147 @@
+/*
+ * bitmatrix.h - bit-matrix and bit-sliced column statistics
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <vector>
+#include <stdint.h>
+
+// statistics of columns of bit-matrix rows - ones in columns are counted
+// by vertical (bit-sliced) counters, plane p keeps the bit p of counts
+class ColumnStats
+{
+public:
+    // maximal number of counter planes (rows count is less than 2^MAX_PLANES)
+    static const unsigned MAX_PLANES = 32;
+    // maximal number of words of the row
+    static const unsigned MAX_WORDS = 8;
+
+    // kernels of counting ones in columns
+    enum Counter { SCALAR_COUNTER, AVX2_COUNTER, AVX512_COUNTER };
+
+    ColumnStats() : words(0), planesCount(0) {}
+
+    // returns kernel of counting (the widest one supported by CPU by default)
+    static Counter getCounter();
+    // sets kernel of counting for all statistics, returns false if CPU
+    // doesn't support it
+    static bool setCounter(Counter c);
+
+    // computes statistics of rowsCount rows (each has words 64 bits words)
+    // saved in data, columns in mask are excluded, counting can be turned off
+    void compute(const uint64_t *data, unsigned rowsCount, unsigned words,
+            const uint64_t *mask, bool counting = true);
+
+    // returns count of ones in column col
+    unsigned ones(unsigned col) const;
+    // returns the first column with the most ones or -1 if all columns are zero
+    int maxColumn() const;
+    // columns with some one
+    inline const uint64_t *nonzero() const { return &ors[0]; }
+    // columns with one in rows which have single one
+    inline const uint64_t *singles() const { return &single[0]; }
+
+private:
+    unsigned words;
+    unsigned planesCount;
+
+    std::vector<uint64_t> planes; // planes[p * words + w]
+    std::vector<uint64_t> ors;
+    std::vector<uint64_t> single;
+    std::vector<uint64_t> excluded;
+};
+
+// matrix of bits saved by rows in one contiguous array, the row has 1, 2, 4 or 8
+// 64 bits words (so SIMD lanes always process the same word of rows)
+class BitMatrix
+{
+public:
+    // maximal number of words of the row
+    static const unsigned MAX_WORDS = ColumnStats::MAX_WORDS;
+
+    // returns number of words of the row for cols columns
+    static unsigned wordsCount(unsigned cols);
+
+    BitMatrix(unsigned cols = 0) { reset(cols); }
+
+    // sets number of columns and removes all rows and column mask
+    void reset(unsigned cols);
+
+    inline unsigned rowsCount() const { return rows; }
+    inline unsigned colsCount() const { return cols; }
+    inline unsigned wordsCount() const { return words; }
+    inline bool isEmpty() const { return rows == 0; }
+
+    // appends zero row and returns its words
+    uint64_t *addRow();
+    // appends row with bits b (any class with words64 and getWord64)
+    template <typename B> void addRow(const B &b)
+    {
+        uint64_t *r = addRow();
+        for (unsigned i = 0; i < words && i < b.words64(); i++)
+            r[i] = b.getWord64(i);
+    }
+    inline uint64_t *row(unsigned i) { return &data[i * words]; }
+    inline const uint64_t *row(unsigned i) const { return &data[i * words]; }
+
+    // columns which are eliminated
+    inline const uint64_t *colMask() const { return &mask[0]; }
+    // eliminates columns
+    void maskColumns(const uint64_t *columns);
+    // removes rows which have one in some of columns
+    void removeIntersecting(const uint64_t *columns);
+    // removes rows which have no one in all columns
+    void removeDisjoint(const uint64_t *columns);
+
+    // computes statistics of not eliminated columns
+    inline void stats(ColumnStats &st, bool counting = true) const
+    {
+        st.compute(rows? &data[0]: 0, rows, words, &mask[0], counting);
+    }
+
+    // converts bits b to words w
+    template <typename B> static void toWords(const B &b, uint64_t *w, unsigned n)
+    {
+        for (unsigned i = 0; i < n; i++)
+            w[i] = (i < b.words64())? b.getWord64(i): 0;
+    }
+    // converts words w to bits b
+    template <typename B> static B fromWords(const uint64_t *w, unsigned n)
+    {
+        B b;
+        for (unsigned i = 0; i < n && i < b.words64(); i++)
+            b.setWord64(i, w[i]);
+        return b;
+    }
+
+private:
+    // removes rows which (don't) intersect columns
+    void removeRows(const uint64_t *columns, bool intersecting);
+
+    unsigned cols;
+    unsigned words;
+    unsigned rows;
+
+    std::vector<uint64_t> data;
+    std::vector<uint64_t> mask;
+};
+
+#endif // BITMATRIX_H
@@ -0,0 +1,182 @@
+/*
+ * cofactorview.cpp - cofactor of Espresso cover without copying of cubes
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cofactorview.h"
+#include "bitmatrix.h"
+
+#include <vector>
+#include <stdint.h>
+using namespace std;
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+template <typename S>
+BasicCofactorView<S>::BasicCofactorView(unsigned varsCount, Arena *arena)
+    : active(ArenaAllocator<uint64_t>(arena)), own(varsCount, arena)
+{
+    vc = varsCount;
+    full = term_type::getFullLiters(vc);
+    rows = &own;
+    size = 0;
+}
+
+// returns the next active row after i
+template <typename S>
+int BasicCofactorView<S>::next(int i) const
+{
+    unsigned pos = i + 1;
+    unsigned w = pos / 64;
+    if (w >= active.size())
+        return -1;
+
+    uint64_t word = active[w] & (~uint64_t(0) << (pos % 64));
+    while (!word) {
+        if (++w == active.size())
+            return -1;
+        word = active[w];
+    }
+    return w * 64 + firstOne(word);
+}
+
+// starts new view of cover c with fixed variables f
+template <typename S>
+void BasicCofactorView<S>::start(const cover_type *c, const bits_t &f)
+{
+    rows = c;
+    fixed = f;
+    active.assign((c->count() + 63) / 64, 0);
+    size = 0;
+}
+
+// copies active rows if view is sparse
+template <typename S>
+void BasicCofactorView<S>::finish()
+{
+    if (rows == &own || rows->count() < SPARSE_MIN || size * SPARSE_RATIO >= rows->count())
+        return;
+
+    own.clear();
+    foreach_row(*this, i)
+        own.add(getLiters(i), getMissing(i), rows->getFlags(i));
+
+    rows = &own;
+    active.assign((size + 63) / 64, 0);
+    for (unsigned i = 0; i < size; i++)
+        active[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+// cofactor of rows of cover c with respect to cube (cl, cm)
+template <typename S>
+void BasicCofactorView<S>::cofactor(const cover_type &c, const bits_t &cl, const bits_t &cm, int flags)
+{
+    start(&c, ~cm & full);
+    foreach_cube(c, i) {
+        if ((!flags || c.hasFlags(i, flags))
+                && ((c.getLiters(i) ^ cl) & ~(cm | c.getMissing(i))).none())
+            activate(i);
+    }
+    finish();
+}
+
+// Shannon expansion for variable at position pos, cofactors are saved to v0 and v1
+template <typename S>
+void BasicCofactorView<S>::shannon(unsigned pos, BasicCofactorView &v0, BasicCofactorView &v1) const
+{
+    bits_t f = fixed | bits_t::bit(pos);
+    v0.start(rows, f);
+    v1.start(rows, f);
+    foreach_row(*this, i) {
+        if (getMissing(i).test(pos)) {
+            v0.activate(i);
+            v1.activate(i);
+        }
+        else if (getLiters(i).test(pos))
+            v1.activate(i);
+        else
+            v0.activate(i);
+    }
+    v0.finish();
+    v1.finish();
+}
+
+// rows of view v which have (don't have) bound variable in columns
+template <typename S>
+void BasicCofactorView<S>::select(const BasicCofactorView &v, const bits_t &columns, bool bound)
+{
+    start(v.rows, v.fixed);
+    foreach_row(v, i) {
+        if ((~v.getMissing(i) & columns).any() == bound)
+            activate(i);
+    }
+    finish();
+}
+
+// whether view is unate, prod is product of all rows
+template <typename S>
+bool BasicCofactorView<S>::isUnate(term_type *prod) const
+{
+    bits_t l;
+    bits_t m = full;
+    foreach_row(*this, i) {
+        bits_t mi = getMissing(i);
+        bits_t li = getLiters(i) & ~mi;
+        if (((l ^ li) & ~(m | mi)).any())
+            return false;
+        l |= li;
+        m &= mi;
+    }
+    if (prod)
+        *prod = term_type(l, m, vc);
+    return true;
+}
+
+// select the most binate var
+template <typename S>
+unsigned BasicCofactorView<S>::binateSelect(typename cover_type::BinateScratch &bs) const
+{
+    // ones and zeros of bound variables
+    bs.ones.reset(vc);
+    bs.zeros.reset(vc);
+    foreach_row(*this, i) {
+        bits_t bound = ~getMissing(i) & full;
+        bs.ones.addRow(getLiters(i) & bound);
+        bs.zeros.addRow(~getLiters(i) & bound);
+    }
+    return cover_type::selectBinate(bs, vc);
+}
+
+// instances for all storages
+template class BasicCofactorView<TermStorage16>;
+template class BasicCofactorView<TermStorage32>;
+template class BasicCofactorView<TermStorage64>;
+template class BasicCofactorView<TermStorage128>;
+template class BasicCofactorView<TermStorage256>;
@@ -0,0 +1,103 @@
+/*
+ * cofactorview.h - cofactor of Espresso cover without copying of cubes
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COFACTORVIEW_H
+#define COFACTORVIEW_H
+
+#include "term.h"
+#include "espressocover.h"
+#include "arena.h"
+
+#include <vector>
+#include <stdint.h>
+
+// cofactor of Espresso cover - active rows of the parent cover with variables
+// of cofactoring cubes set to missing, rows are copied only if view is sparse
+template <typename S>
+class BasicCofactorView
+{
+public:
+    typedef BasicTerm<S> term_type;
+    typedef typename S::bits_t bits_t;
+    typedef BasicEspressoCover<S> cover_type;
+
+    // rows are copied if less than 1 / SPARSE_RATIO rows of parent are active
+    static const unsigned SPARSE_RATIO = 4;
+    // minimal number of parent rows for copying
+    static const unsigned SPARSE_MIN = 64;
+
+    // bitmap and copied rows are allocated from arena if it's set
+    BasicCofactorView(unsigned varsCount, Arena *arena = 0);
+
+    inline unsigned count() const { return size; }
+    inline bool isEmpty() const { return size == 0; }
+
+    // iterating of active rows (returns -1 after the last row)
+    int first() const { return next(-1); }
+    int next(int i) const;
+
+    // row of the view
+    inline bits_t getLiters(unsigned i) const { return rows->getLiters(i) & ~fixed; }
+    inline bits_t getMissing(unsigned i) const { return (rows->getMissing(i) | fixed) & full; }
+
+    // cofactor of rows of cover c (which have some of flags if they are set)
+    // with respect to cube with liters cl and missings cm
+    void cofactor(const cover_type &c, const bits_t &cl, const bits_t &cm, int flags = 0);
+    // Shannon expansion for variable at position pos
+    void shannon(unsigned pos, BasicCofactorView &v0, BasicCofactorView &v1) const;
+    // rows of view v which have (or don't have if bound is false) a bound variable in columns
+    void select(const BasicCofactorView &v, const bits_t &columns, bool bound);
+
+    // whether view is unate
+    bool isUnate(term_type *prod = 0) const;
+    // select the most binate var (matrices of scratch are reused)
+    unsigned binateSelect(typename cover_type::BinateScratch &scratch) const;
+
+private:
+    // not copyable (rows can point to own cover)
+    BasicCofactorView(const BasicCofactorView &);
+    BasicCofactorView &operator=(const BasicCofactorView &);
+
+    // starts new view of cover c
+    void start(const cover_type *c, const bits_t &f);
+    inline void activate(unsigned i)
+    {
+        active[i / 64] |= uint64_t(1) << (i % 64);
+        size++;
+    }
+    // copies active rows if view is sparse
+    void finish();
+
+    unsigned vc;
+    bits_t full;
+
+    const cover_type *rows; // parent cover
+    bits_t fixed;           // variables of cofactoring cubes
+    std::vector<uint64_t, ArenaAllocator<uint64_t> > active;
+    unsigned size;
+
+    cover_type own; // copied rows
+};
+
+// view iterating (in code templated by storage S)
+#define foreach_row(_v, _i) \
+for (int _i = (_v).first(); _i != -1; _i = (_v).next(_i))
+
+#endif // COFACTORVIEW_H
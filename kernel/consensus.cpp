@@ -0,0 +1,203 @@
+/*
+ * consensus.cpp - prime implicants generation by iterated consensus
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "consensus.h"
+#include "espresso.h"
+#include "formula.h"
+#include "term.h"
+#include "termscontainer.h"
+
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+Formula *Consensus::minimize(Formula *f, bool)
+{
+    setDebug(false);
+
+    delete of;
+    of = new Formula(*f);
+    mf = new Formula(*of);
+
+    tooManyCubes = false;
+    fallback = NO_FALLBACK;
+    if (of->getSize() > 0) {
+        findPrimeImplicants();
+        // dense functions are passed to QM (or Espresso if there are too many minterms)
+        if (tooManyCubes) {
+            delete mf;
+            mf = 0;
+            if (f->getVarsCount() <= MAX_QM_VARS) {
+                QuineMcCluskey qm;
+                qm.setExactCover(isExactCover());
+                qm.setNodesLimit(getNodesLimit());
+                mf = qm.minimize(f, false);
+                fallback = QM_FALLBACK;
+            }
+            else {
+                fallback = ESPRESSO_FALLBACK;
+                Espresso espresso;
+                mf = espresso.minimize(f, false);
+            }
+            return mf;
+        }
+        findFinalImplicants();
+    }
+
+    mf->setMinimized(true);
+    f->setMinimized(true);
+
+    return mf;
+}
+
+// cubes with the more missings go first (they absorb the others)
+static bool moreMissings(const Term &t1, const Term &t2)
+{
+    return t1.getMissing().count() > t2.getMissing().count();
+}
+
+// minterms are ordered by their liters (index isn't defined for wide terms)
+static bool lessLiters(const Term &t1, const Term &t2)
+{
+    return t1.getLiters() < t2.getLiters();
+}
+
+// whether cube a contains cube b (full are liters of all variables)
+static inline bool containsCube(const Term &a, const Term &b, const Term::bits_t &full)
+{
+    Term::bits_t bound = ~a.getMissing() & full;
+    return (bound & b.getMissing()).none() && ((a.getLiters() ^ b.getLiters()) & bound).none();
+}
+
+// consensus of all pairs of cubes with distance one is added until no new
+// cube is found, cubes contained in other cubes are removed on the fly
+void Consensus::findPrimeImplicants()
+{
+    if (!(of && mf))
+        return;
+
+    unsigned vc = of->getVarsCount();
+    Term::bits_t full = Term::getFullLiters(vc);
+
+    vector<Term> *start = getTermsVector(of->terms);
+    sort(start->begin(), start->end(), moreMissings);
+
+    Cubes cubes;
+    cubes.terms.reserve(start->size());
+    for (unsigned i = 0; i < start->size(); i++)
+        addCube(cubes, (*start)[i], full);
+    delete start;
+
+    // every cube is paired with all alive cubes which were added before it,
+    // the new cubes are appended so they are paired later (alive is only
+    // appended while a cube is paired, so the first count cubes are stable)
+    for (unsigned i = 1; i < cubes.terms.size(); i++) {
+        if (cubes.terms.size() > MAX_CUBES) {
+            tooManyCubes = true;
+            return;
+        }
+        if (!cubes.isAlive[i])
+            continue;
+        unsigned count = cubes.alive.size();
+        for (unsigned k = 0; k < count && cubes.isAlive[i]; k++) {
+            unsigned j = cubes.alive[k];
+            if (j >= i || !cubes.isAlive[j])
+                continue;
+
+            const Term &ti = cubes.terms[i], &tj = cubes.terms[j];
+            Term::bits_t conflict = (ti.getLiters() ^ tj.getLiters())
+                    & ~ti.getMissing() & ~tj.getMissing() & full;
+            if (conflict.count() != 1)
+                continue;
+
+            Term::bits_t m = (ti.getMissing() & tj.getMissing()) | conflict;
+            Term::bits_t l = (ti.getLiters() | tj.getLiters()) & ~m & full;
+            int flags = (ti.isDC() && tj.isDC())? Term::DC: Term::ONE;
+            Term c(l, m, vc, flags);
+            // consensus is mostly contained in one of its parents
+            if (!containsCube(ti, c, full) && !containsCube(tj, c, full))
+                addCube(cubes, c, full);
+        }
+        compact(cubes);
+    }
+
+    compact(cubes);
+    vector<Term> v;
+    for (unsigned k = 0; k < cubes.alive.size(); k++)
+        v.push_back(cubes.terms[cubes.alive[k]]);
+    mf->terms->swapContainer(v);
+}
+
+bool Consensus::addCube(Cubes &cubes, const Term &c, const Term::bits_t &full)
+{
+    vector<unsigned> &alive = cubes.alive;
+    for (unsigned k = 0; k < alive.size(); k++) {
+        if (cubes.isAlive[alive[k]] && containsCube(cubes.terms[alive[k]], c, full))
+            return false;
+    }
+    // contained cubes are only marked (alive can be paired at the moment)
+    for (unsigned k = 0; k < alive.size(); k++) {
+        if (cubes.isAlive[alive[k]] && containsCube(c, cubes.terms[alive[k]], full)) {
+            cubes.isAlive[alive[k]] = false;
+            cubes.removed++;
+        }
+    }
+    alive.push_back(cubes.terms.size());
+    cubes.isAlive.push_back(true);
+    cubes.terms.push_back(c);
+    return true;
+}
+
+void Consensus::compact(Cubes &cubes)
+{
+    if (!cubes.removed)
+        return;
+
+    vector<unsigned> &alive = cubes.alive;
+    unsigned last = 0;
+    for (unsigned k = 0; k < alive.size(); k++) {
+        if (cubes.isAlive[alive[k]])
+            alive[last++] = alive[k];
+    }
+    alive.resize(last);
+    cubes.removed = 0;
+}
+
+vector<Term> *Consensus::getCoverTerms() const
+{
+    vector<Term> *cubes = getTermsVector(of->terms, true);
+
+    unsigned long count = 0;
+    for (unsigned i = 0; i < cubes->size() && count <= MAX_COVER_MINTERMS; i++) {
+        unsigned missings = cubes->at(i).getMissing().count();
+        count += (missings < 32)? 1UL << missings: MAX_COVER_MINTERMS + 1UL;
+    }
+    if (count > MAX_COVER_MINTERMS)
+        return cubes;
+
+    vector<Term> *minterms = new vector<Term>;
+    for (unsigned i = 0; i < cubes->size(); i++)
+        Term::expandTerm(*minterms, cubes->at(i));
+    delete cubes;
+    sort(minterms->begin(), minterms->end(), lessLiters);
+    minterms->erase(unique(minterms->begin(), minterms->end()), minterms->end());
+    return minterms;
+}
@@ -0,0 +1,85 @@
+/*
+ * consensus.h - prime implicants generation by iterated consensus
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONSENSUS_H
+#define CONSENSUS_H
+
+#include "quinemccluskey.h"
+#include "term.h"
+
+#include <vector>
+
+// prime implicants are generated by iterated consensus directly from cubes
+// of on-set and dc-set (minterms are not expanded), covering of QM is used;
+// dense functions are minimized by QM (or Espresso for more than MAX_QM_VARS
+// variables) when more than MAX_CUBES cubes are generated, the used algorithm
+// is returned by getFallback
+class Consensus : public QuineMcCluskey
+{
+public:
+    // algorithm which minimized the last formula instead of consensus
+    enum Fallback { NO_FALLBACK, QM_FALLBACK, ESPRESSO_FALLBACK };
+
+    // maximal number of generated cubes (every cube is paired with all alive ones)
+    static const unsigned MAX_CUBES = 1 << 10;
+    // maximal number of variables for QM (all minterms are expanded)
+    static const unsigned MAX_QM_VARS = 16;
+
+    Consensus() : tooManyCubes(false), fallback(NO_FALLBACK) {}
+
+    // complete minimization (without debug data)
+    Formula *minimize(Formula *f, bool dbg = false);
+
+    // creates prime implicants
+    void findPrimeImplicants();
+
+    // returns algorithm used for the last formula (Espresso result isn't minimal)
+    inline Fallback getFallback() const { return fallback; }
+
+protected:
+    // returns on-set minterms or cubes which have to be covered
+    std::vector<Term> *getCoverTerms() const;
+
+private:
+    // whether the generation was stopped for MAX_CUBES
+    bool tooManyCubes;
+    // algorithm used for the last formula
+    Fallback fallback;
+
+    // generated cubes (alive are the cubes which aren't contained in other ones,
+    // removed cubes stay in alive until it's compacted)
+    struct Cubes
+    {
+        std::vector<Term> terms;
+        std::vector<unsigned> alive;
+        std::vector<char> isAlive;
+        unsigned removed;
+
+        Cubes() : removed(0) {}
+    };
+
+    // adds cube c if it isn't contained in any alive cube, contained cubes are removed
+    static bool addCube(Cubes &cubes, const Term &c, const Term::bits_t &full);
+    // removes the removed cubes from alive
+    static void compact(Cubes &cubes);
+};
+
+#endif // CONSENSUS_H
@@ -0,0 +1,125 @@
+/*
+ * coverblocks.cpp - independent blocks of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "coverblocks.h"
+#include "covertable.h"
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+using namespace std;
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+static const unsigned NONE = ~0U;
+
+CoverBlocks::CoverBlocks(const CoverTable &t) : table(t)
+{
+    unsigned rowsCount = table.rowsCount();
+    unsigned colsCount = table.colsCount();
+
+    parents.resize(rowsCount);
+    for (unsigned r = 0; r < rowsCount; r++)
+        parents[r] = r;
+
+    // rows covering the same column are joined (the lower root is kept)
+    for (unsigned c = 0; c < colsCount; c++) {
+        if (!table.isActive(c))
+            continue;
+
+        const uint64_t *column = table.column(c);
+        unsigned root = NONE;
+        for (unsigned w = 0; w < table.colWordsCount(); w++) {
+            for (uint64_t b = column[w]; b; b &= b - 1) {
+                unsigned r = find(w * 64 + firstOne(b));
+                if (root == NONE)
+                    root = r;
+                else if (r != root) {
+                    if (r < root)
+                        swap(r, root);
+                    parents[r] = root;
+                }
+            }
+        }
+    }
+
+    // blocks are numbered in the order of their first row
+    vector<unsigned> blockIdx(rowsCount, NONE);
+    for (unsigned r = 0; r < rowsCount; r++) {
+        if (!table.rowOnes(r))
+            continue;
+        unsigned root = find(r);
+        if (blockIdx[root] == NONE) {
+            blockIdx[root] = blockRows.size();
+            blockRows.push_back(vector<unsigned>());
+            blockCols.push_back(vector<unsigned>());
+        }
+        blockRows[blockIdx[root]].push_back(r);
+    }
+
+    colPos.assign(colsCount, NONE);
+    for (unsigned c = 0; c < colsCount; c++) {
+        int r = table.isActive(c)? table.firstRow(c): -1;
+        if (r == -1)
+            continue;
+        vector<unsigned> &cols = blockCols[blockIdx[find(r)]];
+        colPos[c] = cols.size();
+        cols.push_back(c);
+    }
+}
+
+// returns root of row (the path is halved)
+unsigned CoverBlocks::find(unsigned row)
+{
+    while (parents[row] != row) {
+        parents[row] = parents[parents[row]];
+        row = parents[row];
+    }
+    return row;
+}
+
+// makes covering table of the block
+void CoverBlocks::makeTable(unsigned block, CoverTable &t) const
+{
+    const vector<unsigned> &rs = blockRows[block];
+    t.reset(rs.size(), blockCols[block].size());
+
+    const uint64_t *active = table.activeColumns();
+    for (unsigned i = 0; i < rs.size(); i++) {
+        const uint64_t *row = table.row(rs[i]);
+        for (unsigned w = 0; w < table.rowWordsCount(); w++) {
+            for (uint64_t b = row[w] & active[w]; b; b &= b - 1)
+                t.set(i, colPos[w * 64 + firstOne(b)]);
+        }
+    }
+}
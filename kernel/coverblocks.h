@@ -0,0 +1,61 @@
+/*
+ * coverblocks.h - independent blocks of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COVERBLOCKS_H
+#define COVERBLOCKS_H
+
+#include "covertable.h"
+
+#include <vector>
+
+// independent blocks of the covering table - rows and columns of one block
+// share no cell with other blocks, blocks are found by union-find of rows
+// covering the same column (only not removed columns are used)
+class CoverBlocks
+{
+public:
+    CoverBlocks(const CoverTable &t);
+
+    // returns number of blocks
+    inline unsigned count() const { return blockRows.size(); }
+    // rows and columns of the block (in ascending order)
+    inline const std::vector<unsigned> &rows(unsigned block) const { return blockRows[block]; }
+    inline const std::vector<unsigned> &columns(unsigned block) const { return blockCols[block]; }
+
+    // makes covering table of the block - row i (column j) of t is
+    // the row rows(block)[i] (column columns(block)[j]) of the table
+    void makeTable(unsigned block, CoverTable &t) const;
+
+private:
+    // returns root of row
+    unsigned find(unsigned row);
+
+    const CoverTable &table;
+
+    // union-find parents of rows
+    std::vector<unsigned> parents;
+    // position of column in its block
+    std::vector<unsigned> colPos;
+
+    std::vector<std::vector<unsigned> > blockRows;
+    std::vector<std::vector<unsigned> > blockCols;
+};
+
+#endif // COVERBLOCKS_H
@@ -0,0 +1,119 @@
+/*
+ * covertable.cpp - bit table of covering of terms by implicants
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "covertable.h"
+
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+// sets size of the table and clears all cells
+void CoverTable::reset(unsigned rowsCount, unsigned colsCount)
+{
+    rows = rowsCount;
+    cols = colsCount;
+    rowWords = (cols + 63) / 64;
+    colWords = (rows + 63) / 64;
+
+    rowData.assign(rows * rowWords, 0);
+    colData.assign(cols * colWords, 0);
+    rowCounts.assign(rows, 0);
+    colCounts.assign(cols, 0);
+
+    // all columns are active (padding bits aren't)
+    active.assign(rowWords, ~uint64_t(0));
+    if (cols % 64)
+        active[rowWords - 1] = (uint64_t(1) << (cols % 64)) - 1;
+}
+
+// sets the cell - row covers col
+void CoverTable::set(unsigned row, unsigned col)
+{
+    uint64_t &w = rowData[row * rowWords + col / 64];
+    uint64_t bit = uint64_t(1) << (col % 64);
+    if (w & bit)
+        return;
+
+    w |= bit;
+    colData[col * colWords + row / 64] |= uint64_t(1) << (row % 64);
+    if (isActive(col)) {
+        rowCounts[row]++;
+        colCounts[col]++;
+    }}
+
+// returns the first row covering col
+int CoverTable::firstRow(unsigned col) const
+{
+    const uint64_t *c = column(col);
+    for (unsigned i = 0; i < colWords; i++) {
+        if (c[i])
+            return i * 64 + firstOne(c[i]);
+    }
+    return -1;
+}
+
+// removes all columns covered by row - counts of rows covering removed
+// columns are decreased (rows are found in packed columns)
+void CoverTable::cover(unsigned row)
+{
+    const uint64_t *r = &rowData[row * rowWords];
+    for (unsigned i = 0; i < rowWords; i++) {
+        uint64_t covered = r[i] & active[i];
+        active[i] &= ~covered;
+
+        for (; covered; covered &= covered - 1) {
+            unsigned col = i * 64 + firstOne(covered);
+            const uint64_t *c = column(col);
+            for (unsigned j = 0; j < colWords; j++) {
+                for (uint64_t w = c[j]; w; w &= w - 1)
+                    rowCounts[j * 64 + firstOne(w)]--;
+            }
+            colCounts[col] = 0;
+        }
+    }
+}
+
+// selects essential rows (counts of columns only drop to zero, so no column
+// becomes essential later)
+void CoverTable::coverEssentials(vector<unsigned> &selected)
+{
+    for (unsigned col = 0; col < cols; col++) {
+        if (colCounts[col] == 1) {
+            unsigned row = firstRow(col);
+            cover(row);
+            selected.push_back(row);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * covertable.h - bit table of covering of terms by implicants
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COVERTABLE_H
+#define COVERTABLE_H
+
+#include <vector>
+#include <stdint.h>
+
+// covering table - rows are implicants, columns are terms, the table is saved
+// as packed rows (row-major) and packed columns (column-major), columns which
+// are covered are removed from the table
+class CoverTable
+{
+public:
+    CoverTable(unsigned rowsCount = 0, unsigned colsCount = 0) { reset(rowsCount, colsCount); }
+
+    // sets size of the table and clears all cells
+    void reset(unsigned rowsCount, unsigned colsCount);
+
+    inline unsigned rowsCount() const { return rows; }
+    inline unsigned colsCount() const { return cols; }
+    // number of words of packed row (column)
+    inline unsigned rowWordsCount() const { return rowWords; }
+    inline unsigned colWordsCount() const { return colWords; }
+
+    // sets the cell - row covers col
+    void set(unsigned row, unsigned col);
+    // whether row covers not removed col
+    inline bool test(unsigned row, unsigned col) const
+    {
+        return (rowData[row * rowWords + col / 64] & active[col / 64]) >> (col % 64) & 1;
+    }
+    // whether col isn't removed
+    inline bool isActive(unsigned col) const { return (active[col / 64] >> (col % 64)) & 1; }
+
+    // returns number of not removed columns covered by row
+    inline unsigned rowOnes(unsigned row) const { return rowCounts[row]; }
+    // returns number of rows covering col (zero for removed column)
+    inline unsigned colOnes(unsigned col) const { return colCounts[col]; }
+
+    // returns the first row covering col or -1 if there is no one
+    int firstRow(unsigned col) const;
+
+    // removes all columns covered by row
+    void cover(unsigned row);
+    // selects rows which are the only row of some column (essential rows),
+    // selected rows are appended
+    void coverEssentials(std::vector<unsigned> &selected);
+
+    // words of packed row and column
+    inline const uint64_t *row(unsigned i) const { return &rowData[i * rowWords]; }
+    inline const uint64_t *column(unsigned j) const { return &colData[j * colWords]; }
+    // mask of not removed columns
+    inline const uint64_t *activeColumns() const { return &active[0]; }
+
+private:
+    unsigned rows;
+    unsigned cols;
+    unsigned rowWords;
+    unsigned colWords;
+
+    std::vector<uint64_t> rowData; // rowData[row * rowWords + col / 64]
+    std::vector<uint64_t> colData; // colData[col * colWords + row / 64]
+    std::vector<uint64_t> active;
+    std::vector<unsigned> rowCounts;
+    std::vector<unsigned> colCounts;
+};
+
+#endif // COVERTABLE_H
@@ -53,7 +53,7 @@ bool Cube::isValid()
     return error == OK;
 }
 
-const Term &Cube::at(int pos)
+Term Cube::at(int pos)
 {
     if (minFormula)
         return minFormula->getTermAt(pos);
@@ -96,7 +96,7 @@ unsigned Cube::getCoversCount()
     return (minFormula? minFormula->getSize(): 0);
 }
 
-vector<char> Cube::getVars()
+vector<string> Cube::getVars()
 {
     return formula->getVars();
 }
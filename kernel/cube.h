@@ -21,11 +21,13 @@
 #ifndef CUBE_H
 #define CUBE_H
 
+#include "term.h"
+
 #include <vector>
+#include <string>
 #include <bitset>
 
 class Kernel;
-class Term;
 class Formula;
 class OutputValue;
 
@@ -38,7 +40,7 @@ public:
     Cube();
 
     void update();
-    const Term &at(int pos);
+    Term at(int pos);
     OutputValue value(int id);
 
     bool isTautology();
@@ -49,7 +51,7 @@ public:
     unsigned getTermsCount();
     unsigned getCoversCount();
 
-    std::vector<char> getVars();
+    std::vector<std::string> getVars();
 
     bool isValid();
     Error getError() { return error; }
@@ -23,6 +23,9 @@
 #include "literalvalue.h"
 #include "espressocover.h"
 
+#include <list>
+#include <vector>
+#include <cmath>
 using namespace std;
 
 Espresso::~Espresso()
@@ -35,127 +38,252 @@ Formula *Espresso::minimize(Formula *formula, bool dbg)
     debug = dbg;
 
     delete of;
-    of = new Formula(*formula, true);
-    vc = formula->getVarsCount();
-    fullRow = Term::getFullLiters(vc);
+    of = new Formula(*formula);
 
-    EspressoCover f, d, r;
-    Term *pcube;
+    // cubes are used as they are saved (not expanded to minterms)
+    list<Term> f, d, r;
+    bool onSet = of->getCubeCovers(f, d, r);
 
-    // main loop
-    of->getCovers(f.cover, d.cover, r.cover);
+    if (debug)
+        data.init(of);
 
-    foreach_cube(f, pcube) {
-        pcube->setPrime(false);
+    // cubes are saved in the narrowest storage
+    switch (getTermWidth(formula->getVarsCount())) {
+    case TW_16:
+        minimize<TermStorage16>(f, d, r, onSet);
+        break;
+    case TW_32:
+        minimize<TermStorage32>(f, d, r, onSet);
+        break;
+    case TW_64:
+        minimize<TermStorage64>(f, d, r, onSet);
+        break;
+    case TW_128:
+        minimize<TermStorage128>(f, d, r, onSet);
+        break;
+    default:
+        minimize<TermStorage256>(f, d, r, onSet);
     }
 
-    EspressoCover::Cost c1, c2, c3;
-    c1 = c2 = c3 = f.cost();
+    mf = new Formula(*formula, f);
+    mf->setMinimized(true);
+    formula->setMinimized(true);
 
-    if (debug)
-        data.init(of);
+    return mf;
+}
+
+// minimizes saved cover with cubes in the storage S (result is saved to f)
+template <typename S>
+void Espresso::minimize(list<Term> &f, list<Term> &d, list<Term> &r, bool onSet)
+{
+    unsigned vc = of->getVarsCount();
+    EspressoEngine<S> engine(vc, debug? &data: 0);
+    // covers live during the whole minimization, so they are on the heap
+    // and only counted by the arena
+    Arena *arena = &engine.getArena();
+    BasicEspressoCover<S> cf(vc, arena, true), cd(vc, arena, true), cr(vc, arena, true);
+    cf.fromList(f);
+    cd.fromList(d);
+    cr.fromList(r);
+
+    // only one of on-set and off-set is saved in the formula and
+    // the saved one is minimized (off-set cubes are maxterms of POS)
+    if (onSet) {
+        engine.complement(cf, cd, cr);
+        engine.minimize(cf, cd, cr);
+        cf.toList(f);
+    }
+    else {
+        engine.complement(cr, cd, cf);
+        engine.minimize(cr, cd, cf);
+        cr.toList(f);
+    }
+    allocs = arena->getAllocsCount() + arena->getHeapAllocsCount();
+}
+
+
+// ESPRESSO ENGINE
+
+template <typename S>
+EspressoEngine<S>::EspressoEngine(unsigned varsCount, EspressoData *debugData)
+{
+    vc = varsCount;
+    fullRow = term_type::getFullLiters(vc);
+    data = debugData;
+    complDepth = 0;
+}
+
+// main loop
+template <typename S>
+void EspressoEngine<S>::minimize(cover_type &f, cover_type &d, cover_type &r)
+{
+    foreach_cube(f, i) {
+        f.setFlag(i, term_type::PRIME, false);
+    }
+
+    typename cover_type::Cost c1, c2, c3;
+    c1 = c2 = c3 = f.cost();
 
     while (true) {
         expand(f, r);
-        if (debug)
-            data.add(f, Formula::EXPANDED);
+        addStep(f, Formula::EXPANDED);
         if (c1 == f.cost())
             break;
         c1 = f.cost();
 
         irredundant(f, d);
-        if (debug)
-            data.add(f, Formula::IRREDUNDANT);
+        addStep(f, Formula::IRREDUNDANT);
         if (c2 == f.cost())
             break;
         c2 = f.cost();
 
         reduce(f, d);
-        if (debug)
-            data.add(f, Formula::REDUCED);
+        addStep(f, Formula::REDUCED);
         if (c3 == f.cost())
             break;
         c3 = f.cost();
 
     }
-
-    mf = new Formula(*formula, f.cover);
-    mf->setMinimized(true);
-    formula->setMinimized(true);
-
-    return mf;
 }
 
+// computes complement r of the union of covers f and d
+template <typename S>
+void EspressoEngine<S>::complement(cover_type &f, cover_type &d, cover_type &r)
+{
+    // temporary covers of recursion are released together
+    ArenaScope scope(arena);
+    cover_type fd(vc, &arena);
+    fd.append(f);
+    fd.append(d);
+    complement(fd, r);
+}
 
-// OPERATIONS - cofactor, tautology, intersection
+// whether cover c is a tautology
+template <typename S>
+bool EspressoEngine<S>::isTautology(const cover_type &c)
+{
+    ArenaScope scope(arena);
+    view_type v(vc, &arena);
+    v.cofactor(c, bits_t(), fullRow);
+    return tautology(v);
+}
 
-// returns cofactor (to out) of cover c with respect to cube p
-void Espresso::cofactor(const Term &p, EspressoCover &c, EspressoCover &out, int flags)
+// adds debugging step
+template <typename S>
+void EspressoEngine<S>::addStep(cover_type &f, Formula::State state)
 {
-    out.clear();
-    Term *pcube;
-    foreach_cube(c, pcube) {
-        if (!flags || pcube->hasFlags(flags)) {
-            Term t = pcube->cofactor(p, fullRow);
-            if (t.isValid())
-                out.add(t);
-        }
+    if (data) {
+        list<Term> l;
+        f.toList(l);
+        data->add(l, state);
     }
 }
 
+
+// OPERATIONS - shannon expansion, tautology
+
 // Shannon expansion for variable at position pos of cover c, cofactors are save to out0 and out1
-void Espresso::shannon(unsigned pos, EspressoCover &c, EspressoCover &out0, EspressoCover &out1)
+template <typename S>
+void EspressoEngine<S>::shannon(unsigned pos, cover_type &c, cover_type &out0, cover_type &out1)
 {
     out0.clear();
     out1.clear();
-    Term *pcube;
-    foreach_cube(c, pcube) {
-        Term t0 = pcube->cofactor(pos, false, fullRow);
-        if (t0.isValid())
-            out0.add(t0);
-        Term t1 = pcube->cofactor(pos, true, fullRow);
-        if (t1.isValid())
-            out1.add(t1);
+    bits_t bit = bits_t::bit(pos);
+    foreach_cube(c, i) {
+        const bits_t &l = c.getLiters(i);
+        const bits_t &m = c.getMissing(i);
+        if (m.test(pos)) {
+            out0.add(l & ~bit, m);
+            out1.add(l & ~bit, m);
+        }
+        else if (l.test(pos))
+            out1.add(l & ~bit, m | bit);
+        else
+            out0.add(l, m | bit);
     }
 }
 
-// tautology algorithm for cover c
-bool Espresso::tautology(EspressoCover &c, unsigned pos)
+// tautology algorithm for cofactor view c (unate recursive paradigm)
+template <typename S>
+bool EspressoEngine<S>::tautology(view_type &c)
 {
+    if (c.isEmpty())
+        return false;
+
+    // temporary views of this level are released on return
+    ArenaScope scope(arena);
+
     // tautology if it has row with all 2's
-    Term *pcube;
-    foreach_cube (c, pcube) {
-        if ((pcube->getMissing() & fullRow) == fullRow)
+    foreach_row (c, i) {
+        if (c.getMissing(i) == fullRow)
             return true;
     }
 
-    EspressoCover c0, c1;
-    shannon(pos, c, c0, c1);
-    if (c0.isEmpty() || c1.isEmpty())
+    // columns with ones and zeros and volume of cubes (relative to the universe)
+    bits_t ones, zeros, bound;
+    double volume = 0.0;
+    foreach_row (c, i) {
+        bound = ~c.getMissing(i) & fullRow;
+        ones |= c.getLiters(i) & bound;
+        zeros |= ~c.getLiters(i) & bound;
+        volume += ldexp(1.0, -static_cast<int>(bound.count()));
+    }
+
+    // unate cover without row of all 2's
+    if ((ones & zeros).none())
         return false;
-    else
-        return tautology(c0, pos + 1) && tautology(c1, pos + 1);
+
+    // cubes which depend on unate variable can be removed
+    bits_t unate = ones ^ zeros;
+    if (unate.any()) {
+        view_type reduced(vc, &arena);
+        reduced.select(c, unate, false);
+        return tautology(reduced);
+    }
+
+    // cubes don't have enough minterms (with tolerance for rounding)
+    if (volume < 1.0 - 1e-9)
+        return false;
+
+    // cover is a tautology if one of its variable disjoint components is a tautology
+    view_type comp(vc, &arena), rest(vc, &arena);
+    if (splitComponent(c, comp, rest))
+        return tautology(comp) || tautology(rest);
+
+    view_type c0(vc, &arena), c1(vc, &arena);
+    c.shannon(c.binateSelect(binate), c0, c1);
+    return tautology(c0) && tautology(c1);
 }
 
-// intersectio with cover
-void Espresso::intersection(const Term &p, EspressoCover &in, EspressoCover &out, int flags)
+// splits view c to the component comp with the first row and the rest
+// of rows which have no common bound variable with it, returns false if c is connected
+template <typename S>
+bool EspressoEngine<S>::splitComponent(view_type &c, view_type &comp, view_type &rest)
 {
-    out.clear();
-    Term *pcube;
-    foreach_cube(in, pcube) {
-        if (!flags || pcube->hasFlags(flags)) {
-            Term t = *pcube & p;
-            if (t.isValid())
-                out.add(t);
+    bits_t mask = ~c.getMissing(c.first()) & fullRow;
+    bool changed;
+    do {
+        changed = false;
+        foreach_row (c, i) {
+            bits_t bound = ~c.getMissing(i) & fullRow;
+            if ((bound & mask).any() && (bound & ~mask).any()) {
+                mask |= bound;
+                changed = true;
+            }
         }
-    }
+    } while (changed);
+
+    comp.select(c, mask, true);
+    rest.select(c, mask, false);
+    return !rest.isEmpty();
 }
 
 
 // EXPAND
 
 // expand each nonprime cube of F into a prime implicant
-void Espresso::expand(EspressoCover &f, EspressoCover &r)
+template <typename S>
+void EspressoEngine<S>::expand(cover_type &f, cover_type &r)
 {
      // tautology test
     if (r.isEmpty()) {
@@ -168,40 +296,44 @@ void Espresso::expand(EspressoCover &f, EspressoCover &r)
     f.sort();
     f.setCovered(false);
 
-    Term *pcube;
-    foreach_cube(f, pcube) {
-        if (!pcube->isPrime() && !pcube->isCovered()) {
-            // expand the cube pcube, result is raise
-            expand1(*pcube, r, f);
+    foreach_cube(f, i) {
+        if (!f.hasFlags(i, term_type::PRIME | term_type::COVERED)) {
+            // expand the cube i, result is raise
+            expand1(i, r, f);
         }
     }
 
     bool change = false;
-    foreach_cube(f, pcube) {
-        if (!pcube->isPrime() && pcube->isCovered()) {
-            pcube->setActive(false);
+    foreach_cube(f, i) {
+        if (!f.hasFlags(i, term_type::PRIME) && f.hasFlags(i, term_type::COVERED)) {
+            f.setFlag(i, term_type::ACTIVE, false);
             change = true;
         }
         else
-            pcube->setActive();
+            f.setFlag(i, term_type::ACTIVE);
     }
     if (change)
         f.removeInactived();
 
 }
 
-// expand a single cube against the OFF-set
-void Espresso::expand1(Term &cube, EspressoCover &r, EspressoCover &f)
+// expand a single cube (at index idx of f) against the OFF-set
+template <typename S>
+void EspressoEngine<S>::expand1(unsigned idx, cover_type &r, cover_type &f)
 {
-    EspressoCover bb = r;
-    EspressoCover cc = f;
-    matrices(cube, bb, cc);
-
-    term_t lower = 0;
-    term_t raise = 0;
-    term_t essen, inessen, maxFeasible;
-
-    while ((lower | raise) != fullRow && !bb.isCovered() && !cc.isCovered()) {
+    bits_t cl = f.getLiters(idx);
+    bits_t cm = f.getMissing(idx);
+    // matrices are reused for all cubes
+    BitMatrix &bb = bbScratch;
+    BitMatrix &cc = ccScratch;
+    matrices(cl, cm, r, f, bb, cc);
+
+    bits_t lower;
+    bits_t raise;
+    bits_t essen, inessen, maxFeasible;
+
+    // covered rows are removed from matrices
+    while ((lower | raise) != fullRow && !bb.isEmpty() && !cc.isEmpty()) {
         essen = essential(bb);
         lower |= essen;
         elim1bb(essen, bb);
@@ -214,151 +346,275 @@ void Espresso::expand1(Term &cube, EspressoCover &r, EspressoCover &f)
         inessen = inessential(bb);
         raise |= inessen;
         elim2(inessen, bb, cc);
+
+        // nothing can be lowered or raised (the rest is lowered by minlow)
+        if ((essen | maxFeasible | inessen).none())
+            break;
     }
 
-    if (!bb.isCovered())
+    if (!bb.isEmpty())
         lower |= minlow(bb);
 
     // lowers variables
-    cube.lower(lower);
+    f.set(idx, cl & lower, fullRow & (cm | ~lower));
 
-    // sets covered cubes
-    cc.setCovered(false);
-    elim1cc(lower, cc);
-    f.setCovering(cc);
+    // sets covered cubes (rows of covering matrix without one in lowered columns)
+    if (lower.any()) {
+        foreach_cube(f, i) {
+            if (((~cm & (f.getMissing(i) | (f.getLiters(i) ^ cl))) & lower).none())
+                f.setFlag(i, term_type::COVERED);
+        }
+    }
 
     // cube is prime
-    cube.setPrime();
+    f.setFlag(idx, term_type::PRIME);
 }
 
-// set up the blocking and covering cover
-void Espresso::matrices(Term &cube, EspressoCover &bb, EspressoCover &cc)
+// set up the blocking matrix (from r) and covering matrix (from f)
+// for the cube with liters cl and missings cm
+template <typename S>
+void EspressoEngine<S>::matrices(const bits_t &cl, const bits_t &cm, cover_type &r, cover_type &f,
+        BitMatrix &bb, BitMatrix &cc)
 {
-    Term *pcube;
-
-    foreach_cube(bb, pcube) {
-        pcube->makeBB(cube);
-        pcube->setCovered(false);
-    }
-    foreach_cube(cc, pcube) {
-        pcube->makeCC(cube);
-        pcube->setCovered(false);
-    }
+    bb.reset(vc);
+    foreach_cube(r, i)
+        bb.addRow(~(cm | r.getMissing(i)) & (r.getLiters(i) ^ cl));
+    cc.reset(vc);
+    foreach_cube(f, i)
+        cc.addRow(~cm & (f.getMissing(i) | (f.getLiters(i) ^ cl)));
 }
 
 // essential columns are positions of one in single one row
-term_t Espresso::essential(EspressoCover &bb)
+template <typename S>
+typename S::bits_t EspressoEngine<S>::essential(BitMatrix &bb)
 {
-    Term *row;
-    term_t essen = 0;
-    foreach_cube(bb, row) {
-        if (!row->isCovered() && row->valuesCount(LiteralValue::ONE, bb.colMask) == 1)
-            essen |= row->getFirstOnePos(bb.colMask);
-    }
-    return essen;
+    bb.stats(colStats, false);
+    return BitMatrix::fromWords<bits_t>(colStats.singles(), bb.wordsCount());
 }
 
 // inessential columns are zero columns of bb
-term_t Espresso::inessential(EspressoCover &bb)
+template <typename S>
+typename S::bits_t EspressoEngine<S>::inessential(BitMatrix &bb)
 {
-    Term *row;
-    term_t inessen = fullRow & ~bb.colMask;
-    bool hasCovered = false;
-    foreach_cube(bb, row) {
-        if (!row->isCovered()) {
-            hasCovered = true;
-            inessen &= ~row->getLiters();
-        }
-    }
-    return hasCovered? inessen: 0;
+    if (bb.isEmpty())
+        return bits_t();
+
+    bb.stats(colStats, false);
+    bits_t mask = BitMatrix::fromWords<bits_t>(bb.colMask(), bb.wordsCount());
+    bits_t ones = BitMatrix::fromWords<bits_t>(colStats.nonzero(), bb.wordsCount());
+    return fullRow & ~mask & ~ones;
 }
 
 // maximal fesible covering - column with the most 1's in matrix
-term_t Espresso::mfc(EspressoCover &mat)
+template <typename S>
+typename S::bits_t EspressoEngine<S>::mfc(BitMatrix &mat)
 {
-    vector<int> counts(vc, 0);
-    term_t liters, pos;
-    Term *row;
-    foreach_cube(mat, row) {
-        if (!row->isCovered()) {
-            liters = row->getLiters() & ~mat.colMask;
-            pos = 1;
-            for (unsigned i = 0; i < vc; i++, pos <<= 1) {
-                if (liters & pos)
-                    counts[i]++;
-            }
-        }
-    }
-
-    int maxCol = -1;
-    int max = 0;
-    for (unsigned i = 0; i < counts.size(); i++) {
-        if (counts[i] > max) {
-            max = counts[i];
-            maxCol = i;
-        }
-    }
+    mat.stats(colStats);
+    int maxCol = colStats.maxColumn();
 
     if (maxCol == -1) // no column with some 1's
-        return 0;
+        return bits_t();
     else
-        return 1 << maxCol;
+        return bits_t::bit(maxCol);
 }
 
 // minimal column covering of blocking matrix
-term_t Espresso::minlow(EspressoCover &bb)
+template <typename S>
+typename S::bits_t EspressoEngine<S>::minlow(BitMatrix &bb)
 {
-    term_t lower = 0, best;
+    bits_t lower, best;
     do {
         best = mfc(bb);
         lower |= best;
         elim1bb(best, bb);
-    } while (best);
+    } while (best.any());
     return lower;
 }
 
 // eliminates rows and columns from blocking matrix
-void Espresso::elim1bb(term_t columns, EspressoCover &bb)
+template <typename S>
+void EspressoEngine<S>::elim1bb(const bits_t &columns, BitMatrix &bb)
 {
-    if (columns == 0) // nothing for removing
+    if (columns.none()) // nothing for removing
         return;
 
     // blocking matrix
-    bb.colMask |= columns;
-    Term *row;
-    foreach_cube(bb, row) {
-        if (!row->isCovered() && (columns & row->getLiters()))
-            row->setCovered();
-    }
+    uint64_t cols[BitMatrix::MAX_WORDS];
+    BitMatrix::toWords(columns, cols, bb.wordsCount());
+    bb.maskColumns(cols);
+    bb.removeIntersecting(cols);
 }
 
 // eliminates rows and columns from covering matrix
-void Espresso::elim1cc(term_t columns, EspressoCover &cc)
+template <typename S>
+void EspressoEngine<S>::elim1cc(const bits_t &columns, BitMatrix &cc)
 {
-    if (columns == 0) // nothing for removing
+    if (columns.none()) // nothing for removing
         return;
 
     // covering matrix
-    cc.colMask |= columns;
-    Term *row;
-    foreach_cube(cc, row) {
-        if (!row->isCovered() && (columns & ~row->getLiters()) == columns)
-            row->setCovered();
-    }
+    uint64_t cols[BitMatrix::MAX_WORDS];
+    BitMatrix::toWords(columns, cols, cc.wordsCount());
+    cc.maskColumns(cols);
+    cc.removeDisjoint(cols);
 }
 
 // eliminates columns from bb and cc
-void Espresso::elim2(term_t columns, EspressoCover &bb, EspressoCover &cc)
+template <typename S>
+void EspressoEngine<S>::elim2(const bits_t &columns, BitMatrix &bb, BitMatrix &cc)
+{
+    uint64_t cols[BitMatrix::MAX_WORDS];
+    BitMatrix::toWords(columns, cols, bb.wordsCount());
+    bb.maskColumns(cols);
+    cc.maskColumns(cols);
+}
+
+
+// COMPLEMENT
+
+// unate recursive complement of cover f
+template <typename S>
+void EspressoEngine<S>::complement(cover_type &f, cover_type &r)
 {
-    bb.colMask |= columns;
-    cc.colMask |= columns;
+    r.clear();
+
+    // complement of empty cover is universe
+    if (f.isEmpty()) {
+        r.add(bits_t(), fullRow);
+        return;
+    }
+
+    // complement of cover with row of all 2's is empty
+    foreach_cube(f, i) {
+        if ((f.getMissing(i) & fullRow) == fullRow)
+            return;
+    }
+
+    // single cube - De Morgan's law
+    if (f.count() == 1) {
+        complementCube(f.getLiters(0), f.getMissing(0), r);
+        return;
+    }
+
+    // complements of cofactors can't be in the arena (they are merged after
+    // the cofactors are released), they are reused by all calls of the depth
+    if (complements.size() < 2 * (complDepth + 1)) {
+        complements.push_back(cover_type(vc, &arena, true));
+        complements.back().reserve(COMPLEMENT_CUBES);
+        complements.push_back(cover_type(vc, &arena, true));
+        complements.back().reserve(COMPLEMENT_CUBES);
+    }
+    cover_type &r0 = complements[2 * complDepth];
+    cover_type &r1 = complements[2 * complDepth + 1];
+    complDepth++;
+
+    unsigned j = f.binateSelect(binate);
+    bool isUnate = f.isUnate();
+    bool isOne = false;
+    {
+        // cofactors are released before merging of complements
+        ArenaScope scope(arena);
+        cover_type f0(vc, &arena), f1(vc, &arena);
+        shannon(j, f, f0, f1);
+        if (isUnate) {
+            // one cofactor contains the other one, so the complement
+            // of the larger cofactor is a part of the whole complement
+            isOne = f1.count() > f0.count();
+            complement(isOne? f0: f1, isOne? r0: r1);
+            complement(isOne? f1: f0, isOne? r1: r0);
+        }
+        else {
+            complement(f0, r0);
+            complement(f1, r1);
+        }
+    }
+    complDepth--;
+
+    if (isUnate) {
+        // the complement of the larger cofactor is contained in the other one
+        cover_type &rl = isOne? r1: r0;
+        cover_type &rs = isOne? r0: r1;
+        r.append(rl);
+        unsigned larger = r.count();
+        bits_t bit = bits_t::bit(j);
+        foreach_cube(rs, i) {
+            bool covered = false;
+            for (unsigned k = 0; k < larger && !covered; k++)
+                covered = r.contains(k, rs, i);
+            if (!covered)
+                r.add(rs.getLiters(i) | (isOne? bits_t(): bit), rs.getMissing(i) & ~bit);
+        }
+    }
+    else
+        mergeWithContainment(j, r0, r1, r);
+}
+
+// complement of one cube (each bound variable is complemented to new cube)
+template <typename S>
+void EspressoEngine<S>::complementCube(const bits_t &cl, const bits_t &cm, cover_type &r)
+{
+    bits_t bound = ~cm & fullRow;
+    for (int pos = bound.first(); pos != -1; pos = bound.first()) {
+        bits_t bit = bits_t::bit(pos);
+        bound &= ~bit;
+        r.add(~cl & bit, fullRow & ~bit);
+    }
+}
+
+// merges complements r0 and r1 of cofactors by variable at pos,
+// cubes which are contained in the cube of the other complement are not bound by pos
+template <typename S>
+void EspressoEngine<S>::mergeWithContainment(unsigned pos, cover_type &r0, cover_type &r1, cover_type &r)
+{
+    r0.setCovered(false);
+    r1.setCovered(false);
+
+    foreach_cube(r0, i0) {
+        foreach_cube(r1, i1) {
+            if (r1.contains(i1, r0, i0)) {
+                r0.setFlag(i0, term_type::COVERED);
+                r.add(r0.getLiters(i0), r0.getMissing(i0), r0.getFlags(i0));
+                break;
+            }
+        }
+    }
+    unsigned lifted = r.count();
+    foreach_cube(r1, i1) {
+        // contained in lifted cube
+        for (unsigned i = 0; i < lifted && !r1.hasFlags(i1, term_type::COVERED); i++) {
+            if (r.contains(i, r1, i1))
+                r1.setFlag(i1, term_type::COVERED);
+        }
+        if (r1.hasFlags(i1, term_type::COVERED))
+            continue;
+
+        foreach_cube(r0, i0) {
+            if (r0.contains(i0, r1, i1)) {
+                r1.setFlag(i1, term_type::COVERED);
+                r.add(r1.getLiters(i1), r1.getMissing(i1), r1.getFlags(i1));
+                break;
+            }
+        }
+    }
+
+    bits_t bit = bits_t::bit(pos);
+    foreach_cube(r0, i0) {
+        if (!r0.hasFlags(i0, term_type::COVERED))
+            r.add(r0.getLiters(i0) & ~bit, r0.getMissing(i0) & ~bit);
+    }
+    foreach_cube(r1, i1) {
+        if (!r1.hasFlags(i1, term_type::COVERED))
+            r.add(r1.getLiters(i1) | bit, r1.getMissing(i1) & ~bit);
+    }
+    r.setCovered(false);
 }
 
 
 // IRREDUNDANT
 
 // returns a minimal subset of F
-void Espresso::irredundant(EspressoCover &f, EspressoCover &d)
+template <typename S>
+void EspressoEngine<S>::irredundant(cover_type &f, cover_type &d)
 {
     f.appendDC(d);
     f.setActived(true);
@@ -372,51 +628,54 @@ void Espresso::irredundant(EspressoCover &f, EspressoCover &d)
 }
 
 // finds essential and redundant cubes
-void Espresso::redundant(EspressoCover &fd)
+template <typename S>
+void EspressoEngine<S>::redundant(cover_type &fd)
 {
-    EspressoCover cof;
-    Term *pcube;
-    foreach_cube(fd, pcube) {
-        if (!pcube->isDC()) {
-            pcube->setActive(false);
-            cofactor(*pcube, fd, cof, Term::ACTIVE);
+    foreach_cube(fd, i) {
+        if (!fd.hasFlags(i, term_type::DC)) {
+            ArenaScope scope(arena);
+            view_type cof(vc, &arena);
+            fd.setFlag(i, term_type::ACTIVE, false);
+            cof.cofactor(fd, fd.getLiters(i), fd.getMissing(i), term_type::ACTIVE);
             bool isTaut = tautology(cof);
-            pcube->setRedundant(isTaut);
-            pcube->setRelativelyEssential(!isTaut);
-            pcube->setActive(true);
+            fd.setFlag(i, term_type::REDUND, isTaut);
+            fd.setFlag(i, term_type::RELESSEN, !isTaut);
+            fd.setFlag(i, term_type::ACTIVE, true);
         }
     }
 }
 
 // finds partialy and totaly redundant cubes
-void Espresso::partialyRedundant(EspressoCover &fd)
+template <typename S>
+void EspressoEngine<S>::partialyRedundant(cover_type &fd)
 {
-    int flags = Term::ACTIVE | Term::DC | Term::RELESSEN;
-    EspressoCover cof;
-    Term *pcube;
-    foreach_cube(fd, pcube) {
-        if (pcube->isRedundant()) {
-            pcube->setActive(false);
-            cofactor(*pcube, fd, cof, flags);
+    int flags = term_type::ACTIVE | term_type::DC | term_type::RELESSEN;
+    foreach_cube(fd, i) {
+        if (fd.hasFlags(i, term_type::REDUND)) {
+            ArenaScope scope(arena);
+            view_type cof(vc, &arena);
+            fd.setFlag(i, term_type::ACTIVE, false);
+            cof.cofactor(fd, fd.getLiters(i), fd.getMissing(i), flags);
             if (tautology(cof))
-                pcube->setRedundant(false);
-            pcube->setActive(true);
+                fd.setFlag(i, term_type::REDUND, false);
+            fd.setFlag(i, term_type::ACTIVE, true);
         }
     }
 }
 
 // finds minimal irredundant cover from partial redundant set
-void Espresso::minimalIrredundant(EspressoCover &fd)
+template <typename S>
+void EspressoEngine<S>::minimalIrredundant(cover_type &fd)
 {
-    EspressoCover cof;
-    Term *pcube;
-    foreach_cube(fd, pcube) {
-        if (!pcube->hasFlags(Term::DC | Term::RELESSEN | Term::REDUND))  {
-            cofactor(*pcube, fd, cof,  Term::DC | Term::RELESSEN);
+    foreach_cube(fd, i) {
+        if (!fd.hasFlags(i, term_type::DC | term_type::RELESSEN | term_type::REDUND))  {
+            ArenaScope scope(arena);
+            view_type cof(vc, &arena);
+            cof.cofactor(fd, fd.getLiters(i), fd.getMissing(i), term_type::DC | term_type::RELESSEN);
             if (tautology(cof))
-                pcube->setRedundant(true);
+                fd.setFlag(i, term_type::REDUND, true);
             else
-                pcube->setRelativelyEssential(true);
+                fd.setFlag(i, term_type::RELESSEN, true);
         }
     }
 
@@ -425,31 +684,35 @@ void Espresso::minimalIrredundant(EspressoCover &fd)
 
 // REDUCE
 
-void Espresso::reduce(EspressoCover &f, EspressoCover &d)
+template <typename S>
+void EspressoEngine<S>::reduce(cover_type &f, cover_type &d)
 {
-    f.sort(EspressoCover::SORT_REDUCE);
+    f.sort(cover_type::SORT_REDUCE);
     f.appendDC(d);
     f.setCovered(false);
     f.setActived(true);
 
-    EspressoCover c, cof;
-    Term *pcube, simple;
-    foreach_cube(f, pcube) {
-        if (!pcube->isDC() && !pcube->isCovered() && !pcube->isRedundant()) {
-            pcube->setActive(false);
-            intersection(*pcube, f, c, Term::ACTIVE);
-            if (!c.isEmpty()) { // empty intersection
-                cofactor(*pcube, c, cof);
-                simple = *pcube & sccc(cof);
+    term_type cube, simple;
+    // reduced cubes are appended to f (they are covered so they are skipped)
+    foreach_cube(f, i) {
+        if (!f.hasFlags(i, term_type::DC | term_type::COVERED | term_type::REDUND)) {
+            ArenaScope scope(arena);
+            view_type cof(vc, &arena);
+            f.setFlag(i, term_type::ACTIVE, false);
+            cube = f.at(i);
+            // cofactor of the intersection with the cube
+            cof.cofactor(f, cube.getLiters(), cube.getMissing(), term_type::ACTIVE);
+            if (!cof.isEmpty()) { // empty intersection
+                simple = cube & sccc(cof);
                 if (simple.isValid()) { // for sure
                     simple.setCovered(true);
                     simple.setActive(true);
                     f.add(simple);
-                    pcube->setRedundant(true);
+                    f.setFlag(i, term_type::REDUND, true);
                 }
             }
-            if (!pcube->isRedundant())
-                pcube->setActive(true);
+            if (!f.hasFlags(i, term_type::REDUND))
+                f.setFlag(i, term_type::ACTIVE, true);
         }
     }
 
@@ -457,26 +720,29 @@ void Espresso::reduce(EspressoCover &f, EspressoCover &d)
     f.removeDC();
 }
 
-Term Espresso::sccc(EspressoCover &c)
+template <typename S>
+typename EspressoEngine<S>::term_type EspressoEngine<S>::sccc(view_type &c)
 {
-    Term unateTerm, *pcube;
+    // temporary views of this level are released on return
+    ArenaScope scope(arena);
+    term_type unateTerm;
     if (c.isUnate(&unateTerm)) { // unateTerm is product term of c
         // whether has term with all 2's, return empty term
-        foreach_cube(c, pcube) {
-            if (pcube->getMissing() == fullRow) {
+        foreach_row(c, i) {
+            if (c.getMissing(i) == fullRow) {
                 unateTerm.setInvalid(true);
                 return unateTerm; // return invalid term
             }
         }
 
-        term_t pos = 1;
-        for (unsigned i = 0; i < unateTerm.getSize(); i++, pos <<= 1) {
-            if (unateTerm.at(i).isMissing())
+        for (unsigned i = 0; i < unateTerm.getSize(); i++) {
+            if (unateTerm[i].isMissing())
                 continue;
 
+            bits_t pos = bits_t::bit(i);
             bool hasCompl = false;
-            foreach_cube(c, pcube) {
-                if ((pcube->getMissing() | pos) == fullRow) {
+            foreach_row(c, k) {
+                if ((c.getMissing(k) | pos) == fullRow) {
                     hasCompl = true;
                     break;
                 }
@@ -484,7 +750,7 @@ Term Espresso::sccc(EspressoCover &c)
             }
             if (!hasCompl) // has line with all 2's after adding one pos
                 unateTerm.setValueAt(i, LiteralValue::MISSING);
-            else if (unateTerm.at(i).isOne())
+            else if (unateTerm[i].isOne())
                 unateTerm.setValueAt(i, LiteralValue::ZERO);
             else
                 unateTerm.setValueAt(i, LiteralValue::ONE);
@@ -493,12 +759,12 @@ Term Espresso::sccc(EspressoCover &c)
         return unateTerm;
     }
     else {
-        EspressoCover c0, c1;
-        unsigned j = c.binateSelect();
-        shannon(j, c, c0, c1);
+        view_type c0(vc, &arena), c1(vc, &arena);
+        unsigned j = c.binateSelect(binate);
+        c.shannon(j, c0, c1);
 
-        Term t0 = sccc(c0);
-        Term t1 = sccc(c1);
+        term_type t0 = sccc(c0);
+        term_type t1 = sccc(c1);
         if (t0.isInvalid() && t1.isInvalid()) // if both terms are invalid
             return t0; // return invalid term
         else
@@ -506,3 +772,9 @@ Term Espresso::sccc(EspressoCover &c)
     }
 }
 
+// instances for all storages
+template class EspressoEngine<TermStorage16>;
+template class EspressoEngine<TermStorage32>;
+template class EspressoEngine<TermStorage64>;
+template class EspressoEngine<TermStorage128>;
+template class EspressoEngine<TermStorage256>;
@@ -25,51 +25,115 @@
 #include "term.h"
 #include "espressocover.h"
 #include "espressodata.h"
+#include "bitmatrix.h"
+#include "arena.h"
+#include "cofactorview.h"
+
+#include <list>
+#include <deque>
 
 class Espresso : public MinimizingAlgorithm
 {
 public:
-    Espresso() {}
+    Espresso() : allocs(0) {}
     virtual ~Espresso();
 
     Formula *minimize(Formula *f, bool dbg = false);
 
     EspressoData *getData() { return &data; }
+    // number of memory allocations of covers by the last minimization
+    // (arena blocks and heap memory of covers which live across arena scopes)
+    inline unsigned long getAllocsCount() const { return allocs; }
 
 private:
-    // OPERATIONS - cofactor, tautology, intersection
-    void cofactor(const Term &p, EspressoCover &in, EspressoCover &out, int flags = 0);
-    void shannon(unsigned pos, EspressoCover &in, EspressoCover &o0, EspressoCover &o1);
-    bool tautology(EspressoCover &c, unsigned pos = 0);
-    void intersection(const Term &p, EspressoCover &in, EspressoCover &out, int flags = 0);
+    // minimizes saved cover with cubes in the storage S (result is saved to f),
+    // on-set f is minimized against computed off-set r if onSet is true,
+    // otherwise off-set r is minimized against computed on-set f
+    template <typename S>
+    void minimize(std::list<Term> &f, std::list<Term> &d, std::list<Term> &r, bool onSet);
+
+    EspressoData data;
+    unsigned long allocs;
+};
+
+// Espresso procedures for cubes in the storage S
+template <typename S>
+class EspressoEngine
+{
+public:
+    typedef BasicTerm<S> term_type;
+    typedef typename S::bits_t bits_t;
+    typedef BasicEspressoCover<S> cover_type;
+    typedef BasicCofactorView<S> view_type;
+
+    EspressoEngine(unsigned varsCount, EspressoData *debugData = 0);
+
+    // main loop - minimizes f with respect to dc-set d and off-set r
+    void minimize(cover_type &f, cover_type &d, cover_type &r);
+    // computes complement r of the union of covers f and d
+    void complement(cover_type &f, cover_type &d, cover_type &r);
+    // whether cover c is a tautology
+    bool isTautology(const cover_type &c);
+
+    // arena for temporary covers
+    inline Arena &getArena() { return arena; }
+    inline const Arena &getArena() const { return arena; }
+
+private:
+    // OPERATIONS - shannon expansion, tautology
+    void shannon(unsigned pos, cover_type &in, cover_type &o0, cover_type &o1);
+    bool tautology(view_type &c);
+    bool splitComponent(view_type &c, view_type &comp, view_type &rest);
 
     // EXPAND
-    void expand(EspressoCover &f, EspressoCover &r);
-    void expand1(Term &cube, EspressoCover &r, EspressoCover &f);
-    void matrices(Term &cube, EspressoCover &bb, EspressoCover &cc);
-    term_t essential(EspressoCover &bb);
-    term_t inessential(EspressoCover &bb);
-    term_t mfc(EspressoCover &mat);
-    term_t minlow(EspressoCover &bb);
-    void elim1bb(term_t columns, EspressoCover &bb);
-    void elim1cc(term_t columns, EspressoCover &cc);
-    void elim2(term_t columns, EspressoCover &bb, EspressoCover &cc);
+    void expand(cover_type &f, cover_type &r);
+    void expand1(unsigned idx, cover_type &r, cover_type &f);
+    void matrices(const bits_t &cl, const bits_t &cm, cover_type &r, cover_type &f,
+            BitMatrix &bb, BitMatrix &cc);
+    bits_t essential(BitMatrix &bb);
+    bits_t inessential(BitMatrix &bb);
+    bits_t mfc(BitMatrix &mat);
+    bits_t minlow(BitMatrix &bb);
+    void elim1bb(const bits_t &columns, BitMatrix &bb);
+    void elim1cc(const bits_t &columns, BitMatrix &cc);
+    void elim2(const bits_t &columns, BitMatrix &bb, BitMatrix &cc);
+
+    // COMPLEMENT
+    void complement(cover_type &f, cover_type &r);
+    void complementCube(const bits_t &cl, const bits_t &cm, cover_type &r);
+    void mergeWithContainment(unsigned pos, cover_type &r0, cover_type &r1, cover_type &r);
 
     // IRREDUNDANT
-    void irredundant(EspressoCover &f, EspressoCover &d);
-    void redundant(EspressoCover &fd);
-    void partialyRedundant(EspressoCover &fd);
-    void minimalIrredundant(EspressoCover &fd);
+    void irredundant(cover_type &f, cover_type &d);
+    void redundant(cover_type &fd);
+    void partialyRedundant(cover_type &fd);
+    void minimalIrredundant(cover_type &fd);
 
     // REDUCE
-    void reduce(EspressoCover &f, EspressoCover &d);
-    Term sccc(EspressoCover &c);
+    void reduce(cover_type &f, cover_type &d);
+    term_type sccc(view_type &c);
+
+    // adds debugging step
+    void addStep(cover_type &f, Formula::State state);
 
     // variables count
     unsigned vc;
-    term_t fullRow;
+    bits_t fullRow;
+    // statistics of columns of blocking and covering matrices
+    ColumnStats colStats;
+    // scratch memory reused by all cubes
+    BitMatrix bbScratch;
+    BitMatrix ccScratch;
+    typename cover_type::BinateScratch binate;
+    Arena arena;
+    // initial capacity of complements of cofactors
+    static const unsigned COMPLEMENT_CUBES = 64;
+    // complements of cofactors by the recursion depth of complement (deque
+    // doesn't move them when it grows) and the actual depth
+    std::deque<cover_type> complements;
+    unsigned complDepth;
 
-    EspressoData data;
+    EspressoData *data;
 };
 
 
@@ -19,203 +19,319 @@
  */
 
 #include "espressocover.h"
+#include "bitmatrix.h"
 
 #include <list>
+#include <vector>
+#include <algorithm>
 using namespace std;
 
-bool EspressoCover::Cost::operator!=(const EspressoCover::Cost &cost) const
+template <typename S>
+BasicEspressoCover<S>::BasicEspressoCover(unsigned varsCount, Arena *arena, bool heap)
+    : liters(ArenaAllocator<bits_t>(arena, heap)), missing(ArenaAllocator<bits_t>(arena, heap)),
+      flagBits(ArenaAllocator<uint64_t>(arena, heap))
 {
-    return size != cost.size || missings != cost.missings;
+    vc = varsCount;
+    full = term_type::getFullLiters(vc);
 }
 
-bool EspressoCover::Cost::operator==(const EspressoCover::Cost &cost) const
+template <typename S>
+typename BasicEspressoCover<S>::Cost BasicEspressoCover<S>::cost() const
 {
-    return size == cost.size && missings == cost.missings;
+    unsigned missings = 0;
+    for (unsigned i = 0; i < count(); i++)
+        missings += (missing[i] & full).count();
+    return Cost(count(), missings);
 }
 
-bool EspressoCover::Cost::operator<(const EspressoCover::Cost &cost) const
+template <typename S>
+void BasicEspressoCover<S>::add(const term_type &t)
 {
-    if (size == cost.size)
-        return missings > cost.missings;
-    else
-        return size < cost.size;
+    liters.push_back(t.getLiters());
+    missing.push_back(t.getMissing());
+    addFlags(t.getFlags());
 }
 
-bool EspressoCover::Cost::operator>(const EspressoCover::Cost &cost) const
+template <typename S>
+void BasicEspressoCover<S>::add(const bits_t &lit, const bits_t &miss, int flg)
 {
-    if (size == cost.size)
-        return missings < cost.missings;
-    else
-        return size > cost.size;
+    liters.push_back(lit);
+    missing.push_back(miss);
+    addFlags(flg);
 }
 
-
-EspressoCover::Cost EspressoCover::cost()
+template <typename S>
+void BasicEspressoCover<S>::append(const BasicEspressoCover &c)
 {
-    unsigned missings = 0;
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++) {
-        Term &t = *it;
-        missings += t.valuesCount(LiteralValue::MISSING);
+    // words of flags are appended if the cover ends at the word boundary
+    bool aligned = (count() % 64 == 0);
+    unsigned first = count();
+    liters.insert(liters.end(), c.liters.begin(), c.liters.end());
+    missing.insert(missing.end(), c.missing.begin(), c.missing.end());
+    if (aligned)
+        flagBits.insert(flagBits.end(), c.flagBits.begin(), c.flagBits.end());
+    else {
+        flagBits.resize(((count() + 63) / 64) * FLAGS_COUNT, 0);
+        for (unsigned i = 0; i < c.count(); i++)
+            setFlag(first + i, c.getFlags(i));
     }
-    return Cost(cover.size(), missings);
 }
 
-unsigned EspressoCover::count() const
+template <typename S>
+void BasicEspressoCover<S>::clear()
 {
-    return cover.size();
+    liters.clear();
+    missing.clear();
+    flagBits.clear();
 }
 
-bool EspressoCover::isEmpty() const
+template <typename S>
+void BasicEspressoCover<S>::reserve(unsigned n)
 {
-    return cover.empty();
+    liters.reserve(n);
+    missing.reserve(n);
+    flagBits.reserve(((n + 63) / 64) * FLAGS_COUNT);
 }
 
-unsigned EspressoCover::varsCount() const
+template <typename S>
+void BasicEspressoCover<S>::truncate(unsigned n)
 {
-    if (cover.empty())
-        return 0;
-    else
-        return cover.front().getSize();
+    liters.resize(n);
+    missing.resize(n);
+    flagBits.resize(((n + 63) / 64) * FLAGS_COUNT);
+    if (n % 64) {
+        uint64_t mask = cubesMask(n / 64);
+        for (unsigned f = 0; f < FLAGS_COUNT; f++)
+            flagWord(n, f) &= mask;
+    }
 }
 
-void EspressoCover::add(const Term &t)
+template <typename S>
+void BasicEspressoCover<S>::setAll(unsigned f, bool value)
 {
-    cover.push_back(t);
+    for (unsigned w = 0; w * 64 < count(); w++)
+        flagBits[w * FLAGS_COUNT + f] = value? cubesMask(w): 0;
 }
 
-void EspressoCover::clear()
+template <typename S>
+void BasicEspressoCover<S>::sort(SortOrder order)
 {
-    cover.clear();
+    if (isEmpty())
+        return;
+
+    // temporaries are taken from arena (heap is used only without arena),
+    // cubes are rewritten in place, so arena can be rewound afterwards
+    Arena *arena = liters.get_allocator().getArena();
+    Arena::Mark mark;
+    if (arena)
+        mark = arena->mark();
+
+    // sorting keys
+    vector<int, ArenaAllocator<int> > keys(count(), 0, ArenaAllocator<int>(arena));
+    if (order == SORT_REDUCE) {
+        unsigned largest = 0;
+        int maxCount = -1;
+        for (unsigned i = 0; i < count(); i++) {
+            int c = (missing[i] & full).count();
+            if (c > maxCount) {
+                largest = i;
+                maxCount = c;
+            }
+        }
+        // the largest cube is the first and others by distance from it
+        term_type seed = at(largest);
+        for (unsigned i = 0; i < count(); i++) {
+            term_type t = at(i);
+            keys[i] = (t == seed)? -1: t.distance(seed);
+        }
+    }
+    else {
+        // decreasing order - larger cube first
+        for (unsigned i = 0; i < count(); i++)
+            keys[i] = -static_cast<int>((missing[i] & full).count());
+    }
+
+    vector<unsigned, ArenaAllocator<unsigned> > perm(count(), 0, ArenaAllocator<unsigned>(arena));
+    for (unsigned i = 0; i < perm.size(); i++)
+        perm[i] = i;
+    std::sort(perm.begin(), perm.end(), KeyOrder(keys));
+    permute(perm);
+
+    if (arena)
+        arena->rewind(mark);
 }
 
-void EspressoCover::sort(SortOrder order)
+template <typename S>
+void BasicEspressoCover<S>::permute(const vector<unsigned, ArenaAllocator<unsigned> > &perm)
 {
-    if (order == SORT_REDUCE) {
-        if (cover.empty())
-            return;
+    // copies of cubes are taken from the memory of perm
+    ArenaAllocator<bits_t> alloc(perm.get_allocator());
+    vector<bits_t, ArenaAllocator<bits_t> > l(liters.begin(), liters.end(), alloc);
+    vector<bits_t, ArenaAllocator<bits_t> > m(missing.begin(), missing.end(), alloc);
+    vector<uint64_t, ArenaAllocator<uint64_t> > f(flagBits.begin(), flagBits.end(),
+            ArenaAllocator<uint64_t>(alloc));
+    std::fill(flagBits.begin(), flagBits.end(), 0);
+    for (unsigned i = 0; i < perm.size(); i++) {
+        unsigned p = perm[i];
+        liters[i] = l[p];
+        missing[i] = m[p];
+        for (unsigned k = 0; k < FLAGS_COUNT; k++) {
+            uint64_t bit = (f[(p / 64) * FLAGS_COUNT + k] >> (p % 64)) & 1;
+            flagBits[(i / 64) * FLAGS_COUNT + k] |= bit << (i % 64);
+        }
+    }
+}
 
-        Term *largest = 0;
-        int maxCount = -1;
-        for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++) {
-            int count = (*it).valuesCount(LiteralValue::MISSING);
-            if (count > maxCount) {
-                largest = &(*it);
-                maxCount = count;
+template <typename S>
+void BasicEspressoCover<S>::removeFlagged(int flg, bool value)
+{
+    // compaction - kept cubes are moved to the front
+    unsigned j = 0;
+    for (unsigned i = 0; i < count(); i++) {
+        if (hasFlags(i, flg) == value)
+            continue;
+        if (i != j) {
+            liters[j] = liters[i];
+            missing[j] = missing[i];
+            uint64_t bit = uint64_t(1) << (j % 64);
+            for (unsigned f = 0; f < FLAGS_COUNT; f++) {
+                if ((flagWord(i, f) >> (i % 64)) & 1)
+                    flagWord(j, f) |= bit;
+                else
+                    flagWord(j, f) &= ~bit;
             }
         }
-        cover.sort(ReduceOrder(largest));
+        j++;
     }
-    else
-        cover.sort(DecreasingOrder());
+    truncate(j);
 }
 
-void EspressoCover::removeInactived()
+template <typename S>
+void BasicEspressoCover<S>::removeInactived()
 {
-    cover.remove_if(InactiveEql());
+    removeFlagged(term_type::ACTIVE, false);
 }
 
-void EspressoCover::setActived(bool value)
+template <typename S>
+void BasicEspressoCover<S>::setActived(bool value)
 {
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++)
-        (*it).setActive(value);
+    setAll(lowestFlag(term_type::ACTIVE), value);
 }
 
-bool EspressoCover::isCovered()
+template <typename S>
+bool BasicEspressoCover<S>::isCovered() const
 {
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++) {
-        if (!(*it).isCovered())
+    unsigned f = lowestFlag(term_type::COVERED);
+    for (unsigned w = 0; w * 64 < count(); w++) {
+        if (flagBits[w * FLAGS_COUNT + f] != cubesMask(w))
             return false;
     }
     return true;
 }
 
-void EspressoCover::setCovered(bool value)
+template <typename S>
+void BasicEspressoCover<S>::setCovered(bool value)
 {
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++)
-        (*it).setCovered(value);
+    setAll(lowestFlag(term_type::COVERED), value);
 }
 
-void EspressoCover::setCovering(EspressoCover &c)
+template <typename S>
+void BasicEspressoCover<S>::setCovering(const BasicEspressoCover &c)
 {
-    list<Term>::iterator itT = cover.begin();
-    list<Term>::iterator itC = c.cover.begin();
-    for (; itT != cover.end() && itC != c.cover.end(); itT++, itC++) {
-        if ((*itC).isCovered())
-            (*itT).setCovered(true);
+    unsigned f = lowestFlag(term_type::COVERED);
+    for (unsigned w = 0; w * 64 < count() && w * 64 < c.count(); w++) {
+        uint64_t mask = (count() < c.count())? cubesMask(w): c.cubesMask(w);
+        flagBits[w * FLAGS_COUNT + f] |= c.flagBits[w * FLAGS_COUNT + f] & mask;
     }
 }
 
-void EspressoCover::setTautology()
+template <typename S>
+void BasicEspressoCover<S>::setTautology()
 {
-    unsigned size = varsCount();
-    cover.clear();
-    cover.push_back(Term(Term::MISSING_ALL, size));
+    clear();
+    add(bits_t(), full, 0);
 }
 
-void EspressoCover::appendDC(EspressoCover &d)
+template <typename S>
+void BasicEspressoCover<S>::appendDC(const BasicEspressoCover &d)
 {
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++)
-        (*it).setDC(false);
+    setAll(lowestFlag(term_type::DC), false);
 
-    for (list<Term>::iterator it = d.cover.begin(); it != d.cover.end(); it++) {
-        (*it).setDC(true);
-        cover.push_back(*it);
-    }
+    unsigned first = count();
+    append(d);
+    for (unsigned i = first; i < count(); i++)
+        setFlag(i, term_type::DC);
 }
 
-void EspressoCover::removeDC()
+template <typename S>
+void BasicEspressoCover<S>::removeDC()
 {
-    cover.remove_if(DCEql());
+    removeFlagged(term_type::DC);
 }
 
-void EspressoCover::removeRedundant()
+template <typename S>
+void BasicEspressoCover<S>::removeRedundant()
 {
-    cover.remove_if(RedundantEql());
+    removeFlagged(term_type::REDUND);
 }
 
-bool EspressoCover::isUnate(Term *prod)
+template <typename S>
+bool BasicEspressoCover<S>::isUnate(term_type *prod) const
 {
-    Term p = cover.front();
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++) {
-        p = p & *it;
-        if (p.isInvalid())
+    // product of all cubes
+    bits_t l;
+    bits_t m = full;
+    for (unsigned i = 0; i < count(); i++) {
+        bits_t li = liters[i] & ~missing[i];
+        if (((l ^ li) & ~(m | missing[i])).any())
             return false;
+        l |= li;
+        m &= missing[i];
     }
     if (prod)
-        *prod = p;
+        *prod = term_type(l, m, vc);
     return true;
 }
 
-unsigned EspressoCover::binateSelect()
+template <typename S>
+unsigned BasicEspressoCover<S>::binateSelect(BinateScratch &bs) const
 {
-    unsigned size = varsCount();
-    vector<int> ones(size, 0);
-    vector<int> zeros(size, 0);
+    // ones and zeros of bound variables
+    bs.ones.reset(vc);
+    bs.zeros.reset(vc);
+    for (unsigned c = 0; c < count(); c++) {
+        bits_t bound = ~missing[c] & full;
+        bs.ones.addRow(liters[c] & bound);
+        bs.zeros.addRow(~liters[c] & bound);
+    }
 
+    return selectBinate(bs, vc);
+}
+
+// selects the most binate var from matrices of ones and zeros in scratch
+template <typename S>
+unsigned BasicEspressoCover<S>::selectBinate(BinateScratch &bs, unsigned varsCount)
+{
     // counts zeros and ones for all columns
-    for (list<Term>::iterator it = cover.begin(); it != cover.end(); it++) {
-        Term &t = *it;
-        for (unsigned i = 0; i < size; i++) {
-            LiteralValue lv = t.at(i);
-            if (lv.isOne())
-                ones[i]++;
-            else if (lv.isZero())
-                zeros[i]++;
-        }
-    }
+    ColumnStats &ones = bs.onesStats;
+    ColumnStats &zeros = bs.zerosStats;
+    bs.ones.stats(ones);
+    bs.zeros.stats(zeros);
 
     // finds maximal column
     unsigned pos = 0;
     int maxValueMin, maxValueMax, valueMin, valueMax;
     maxValueMin = maxValueMax = 0;
-    for (unsigned i = 0; i < size; i++) {
-        if (ones[i] < zeros[i]) {
-            valueMin = ones[i];
-            valueMax = zeros[i];
+    for (unsigned i = 0; i < varsCount; i++) {
+        int o = ones.ones(i);
+        int z = zeros.ones(i);
+        if (o < z) {
+            valueMin = o;
+            valueMax = z;
         }
         else {
-            valueMin = zeros[i];
-            valueMax = ones[i];
+            valueMin = z;
+            valueMax = o;
         }
 
         if (valueMin > maxValueMin || (valueMin == maxValueMin && valueMax > maxValueMax)) {
@@ -226,3 +342,27 @@ unsigned EspressoCover::binateSelect()
     }
     return pos;
 }
+
+template <typename S>
+void BasicEspressoCover<S>::fromList(const list<Term> &l)
+{
+    clear();
+    reserve(l.size());
+    for (list<Term>::const_iterator it = l.begin(); it != l.end(); it++)
+        add(term_type(*it));
+}
+
+template <typename S>
+void BasicEspressoCover<S>::toList(list<Term> &l) const
+{
+    l.clear();
+    for (unsigned i = 0; i < count(); i++)
+        l.push_back(Term(at(i)));
+}
+
+// instances for all storages
+template class BasicEspressoCover<TermStorage16>;
+template class BasicEspressoCover<TermStorage32>;
+template class BasicEspressoCover<TermStorage64>;
+template class BasicEspressoCover<TermStorage128>;
+template class BasicEspressoCover<TermStorage256>;
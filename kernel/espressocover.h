@@ -23,18 +23,45 @@
 
 #include "term.h"
 #include "literalvalue.h"
-
-class EspressoCover
+#include "arena.h"
+#include "bitmatrix.h"
+
+#include <list>
+#include <vector>
+#include <stdint.h>
+
+// cover (set of cubes) for Espresso, cubes are saved in the storage S,
+// liters and missings of cubes are saved in separate contiguous arrays,
+// every flag is saved as a bit vector (one word for 64 cubes), so a flag
+// of all cubes is set or tested by words
+template <typename S>
+class BasicEspressoCover
 {
 public:
+    typedef BasicTerm<S> term_type;
+    typedef typename S::bits_t bits_t;
+    typedef typename S::flags_type flags_type;
+
     class Cost
     {
     public:
         Cost(unsigned s = 0, unsigned m = 0) : size(s), missings(m) {}
-        bool operator==(const Cost &cost) const;
-        bool operator!=(const Cost &cost) const;
-        bool operator<(const Cost &cost) const;
-        bool operator>(const Cost &cost) const;
+        bool operator==(const Cost &cost) const
+        {
+            return size == cost.size && missings == cost.missings;
+        }
+        bool operator!=(const Cost &cost) const
+        {
+            return size != cost.size || missings != cost.missings;
+        }
+        bool operator<(const Cost &cost) const
+        {
+            return (size == cost.size)? missings > cost.missings: size < cost.size;
+        }
+        bool operator>(const Cost &cost) const
+        {
+            return (size == cost.size)? missings < cost.missings: size > cost.size;
+        }
     private:
         unsigned size;
         unsigned missings;
@@ -42,25 +69,83 @@ public:
 
     enum SortOrder { SORT_DECREASING, SORT_REDUCE };
 
-    EspressoCover() : colMask(0) {}
+    // scratch matrices for selecting of binate variable
+    struct BinateScratch
+    {
+        BitMatrix ones;
+        BitMatrix zeros;
+        ColumnStats onesStats;
+        ColumnStats zerosStats;
+    };
 
-    Cost cost();
-    unsigned count() const;
-    bool isEmpty() const;
-    unsigned varsCount() const;
+    // cubes are allocated from arena if it's set (from the heap counted
+    // by arena if heap is set)
+    BasicEspressoCover(unsigned varsCount = 0, Arena *arena = 0, bool heap = false);
+
+    Cost cost() const;
+    inline unsigned count() const { return liters.size(); }
+    inline bool isEmpty() const { return liters.empty(); }
+    inline unsigned varsCount() const { return vc; }
+
+    // cube access by index
+    inline const bits_t &getLiters(unsigned i) const { return liters[i]; }
+    inline const bits_t &getMissing(unsigned i) const { return missing[i]; }
+    inline int getFlags(unsigned i) const
+    {
+        int flg = 0;
+        for (unsigned f = 0; f < FLAGS_COUNT; f++)
+            flg |= static_cast<int>((flagWord(i, f) >> (i % 64)) & 1) << f;
+        return flg;
+    }
+    inline bool hasFlags(unsigned i, int flg) const
+    {
+        for (; flg; flg &= flg - 1) {
+            if ((flagWord(i, lowestFlag(flg)) >> (i % 64)) & 1)
+                return true;
+        }
+        return false;
+    }
+    inline void setFlag(unsigned i, int flg, bool is = true)
+    {
+        uint64_t bit = uint64_t(1) << (i % 64);
+        for (; flg; flg &= flg - 1) {
+            uint64_t &w = flagWord(i, lowestFlag(flg));
+            w = is? (w | bit): (w & ~bit);
+        }
+    }
+    inline void set(unsigned i, const bits_t &lit, const bits_t &miss)
+    {
+        liters[i] = lit;
+        missing[i] = miss;
+    }
+    // returns cube at index i as a term
+    inline term_type at(unsigned i) const
+    {
+        return term_type(liters[i], missing[i], vc, getFlags(i));
+    }
+    // whether cube i contains cube j of cover c
+    inline bool contains(unsigned i, const BasicEspressoCover &c, unsigned j) const
+    {
+        bits_t bound = ~missing[i] & full;
+        return (bound & c.missing[j]).none() && ((liters[i] ^ c.liters[j]) & bound).none();
+    }
 
-    void add(const Term &t);
+    void add(const term_type &t);
+    void add(const bits_t &lit, const bits_t &miss, int flg = term_type::ONE);
+    void append(const BasicEspressoCover &c);
     void clear();
+    // reserves memory for n cubes
+    void reserve(unsigned n);
     void sort(SortOrder order = SORT_DECREASING);
 
-    bool isCovered();
+    bool isCovered() const;
     void setCovered(bool value);
-    void setCovering(EspressoCover &c);
+    void setCovering(const BasicEspressoCover &c);
 
     void setActived(bool value);
     void removeInactived();
 
-    void appendDC(EspressoCover &d);
+    void appendDC(const BasicEspressoCover &d);
     void removeDC();
 
     void removeRedundant();
@@ -68,68 +153,97 @@ public:
     void setTautology();
 
     // whether cover is unate
-    bool isUnate(Term *prod = 0);
-    // select the most binate var
-    unsigned binateSelect();
+    bool isUnate(term_type *prod = 0) const;
+    // select the most binate var (matrices of scratch are reused)
+    unsigned binateSelect(BinateScratch &scratch) const;
+    // selects the most binate var from matrices of ones and zeros in scratch
+    static unsigned selectBinate(BinateScratch &bs, unsigned varsCount);
 
-    std::list<Term> cover;
-    term_t colMask;
+    // copies terms from the list l (converted to the cover storage)
+    void fromList(const std::list<Term> &l);
+    // copies terms to the list l (converted to the term storage)
+    void toList(std::list<Term> &l) const;
 
 private:
-    struct DecreasingOrder
+    // number of flags of terms (bits of term_type flags)
+    static const unsigned FLAGS_COUNT = 9;
+
+    // returns index of the lowest flag of flg
+    static inline unsigned lowestFlag(int flg)
     {
-        bool operator()(const Term &t1, const Term &t2) const
-        {
-            return t1.valuesCount(LiteralValue::MISSING) > t2.valuesCount(LiteralValue::MISSING);
+#ifdef __GNUC__
+        return __builtin_ctz(flg);
+#else
+        unsigned f = 0;
+        while (!(flg & 1)) {
+            flg >>= 1;
+            f++;
         }
-    };
-
-    struct ReduceOrder
+        return f;
+#endif
+    }
+    // word of flag f with the bit of cube i
+    inline uint64_t &flagWord(unsigned i, unsigned f)
+    {
+        return flagBits[(i / 64) * FLAGS_COUNT + f];
+    }
+    inline uint64_t flagWord(unsigned i, unsigned f) const
+    {
+        return flagBits[(i / 64) * FLAGS_COUNT + f];
+    }
+    // mask of cubes in the word w (bits of missing cubes are zero)
+    inline uint64_t cubesMask(unsigned w) const
     {
-        ReduceOrder(Term *largest) : seed(largest) {}
+        unsigned rest = count() - w * 64;
+        return (rest >= 64)? ~uint64_t(0): (uint64_t(1) << rest) - 1;
+    }
+    // sets flag f of all cubes to value
+    void setAll(unsigned f, bool value);
+    // adds words of flags for the new cube (cube has to be already added)
+    inline void addFlags(int flg)
+    {
+        unsigned i = count() - 1;
+        if (i % 64 == 0)
+            flagBits.resize(flagBits.size() + FLAGS_COUNT, 0);
+        setFlag(i, flg);
+    }
+    // removes cubes from n (their flags are zeroed)
+    void truncate(unsigned n);
+
+    // reorders cubes - i-th cube is the cube perm[i]
+    void permute(const std::vector<unsigned, ArenaAllocator<unsigned> > &perm);
+    // removes cubes which have flg (or don't have flg if value is false)
+    void removeFlagged(int flg, bool value = true);
+
+    // orders indexes by the sorting key (indexes of the same keys are kept
+    // in order, so no buffer of stable sort is needed)
+    struct KeyOrder
+    {
+        KeyOrder(const std::vector<int, ArenaAllocator<int> > &k) : keys(k) {}
 
-        bool operator()(const Term &t1, const Term &t2) const
+        bool operator()(unsigned i1, unsigned i2) const
         {
-            if (t1 == *seed)
-                return true;
-            else if (t2 == *seed)
-                return false;
-            else
-                return t1.distance(*seed) < t2.distance(*seed);
+            return (keys[i1] == keys[i2])? i1 < i2: keys[i1] < keys[i2];
         }
 
     private:
-        Term *seed;
+        const std::vector<int, ArenaAllocator<int> > &keys;
     };
 
-    struct InactiveEql
-    {
-        bool operator()(const Term &t) const
-        {
-            return !t.isActive();
-        }
-    };
-
-    struct DCEql
-    {
-        bool operator()(const Term &t) const
-        {
-            return t.isDC();
-        }
-    };
+    unsigned vc;
+    bits_t full;
 
-    struct RedundantEql
-    {
-        bool operator()(const Term &t) const
-        {
-            return t.isRedundant();
-        }
-    };
+    std::vector<bits_t, ArenaAllocator<bits_t> > liters;
+    std::vector<bits_t, ArenaAllocator<bits_t> > missing;
+    // flagBits[(i / 64) * FLAGS_COUNT + f] has bit i % 64 of flag f of cube i
+    std::vector<uint64_t, ArenaAllocator<uint64_t> > flagBits;
 };
 
-// cover iterating
-#define foreach_cube(_c, _pcube) \
-_pcube = &(*_c.cover.begin()); \
-for (std::list<Term>::iterator it = _c.cover.begin(); it != _c.cover.end(); _pcube = &(*++it))
+// cover with the term storage
+typedef BasicEspressoCover<Term::storage_type> EspressoCover;
+
+// cover iterating by cube index
+#define foreach_cube(_c, _i) \
+for (unsigned _i = 0; _i < (_c).count(); _i++)
 
 #endif // ESPRESSOCOVER_H
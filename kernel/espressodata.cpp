@@ -42,10 +42,10 @@ void EspressoData::init(Formula *of)
     clear();
 }
 
-void EspressoData::add(EspressoCover &f, Formula::State state)
+void EspressoData::add(const list<Term> &f, Formula::State state)
 {
     if (origFormula) {
-        Formula *formula = new Formula(*origFormula, f.cover);
+        Formula *formula = new Formula(*origFormula, f);
         formula->setState(state);
         steps.push_back(formula);
     }
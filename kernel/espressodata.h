@@ -22,7 +22,7 @@
 #define ESPRESSODATA_H
 
 #include "formula.h"
-#include "espressocover.h"
+#include "term.h"
 
 #include <list>
 
@@ -33,7 +33,7 @@ public:
     ~EspressoData();
 
     void init(Formula *of);
-    void add(EspressoCover &f, Formula::State state);
+    void add(const std::list<Term> &f, Formula::State state);
     void clear();
 
     Formula::State start();
@@ -97,6 +97,8 @@ protected:
     virtual void evtFormulasSet(unsigned) {}
     // minimizing algorithm is changed
     virtual void evtAlgorithmChanged(Kernel::Algorithm) {}
+    // covering of Quine-McCluskey is changed (exact or greedy)
+    virtual void evtCoverChanged(bool) {}
     // error invoked
     virtual void evtError(std::exception &) {}
     // bmin exit
@@ -0,0 +1,307 @@
+/*
+ * exactcover.cpp - exact minimum covering of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "exactcover.h"
+#include "covertable.h"
+
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+using namespace std;
+
+static inline unsigned popCount(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    unsigned c = 0;
+    for (; w; c++)
+        w &= w - 1;
+    return c;
+#endif
+}
+
+static inline unsigned firstOne(uint64_t w)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
+}
+
+// iterates over positions _i of ones in n words of _bits
+#define foreach_one(_bits, _n, _i) \
+    for (unsigned _w = 0; _w < (_n); _w++) \
+        for (uint64_t _b = (_bits)[_w], _i; _b && ((_i = _w * 64 + firstOne(_b)), true); _b &= _b - 1)
+
+// whether a & mask is subset of b
+static inline bool isSubset(const uint64_t *a, const uint64_t *b, const uint64_t *mask, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if (a[i] & mask[i] & ~b[i])
+            return false;
+    }
+    return true;
+}
+
+// whether a & mask equals b & mask
+static inline bool isEqual(const uint64_t *a, const uint64_t *b, const uint64_t *mask, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++) {
+        if ((a[i] ^ b[i]) & mask[i])
+            return false;
+    }
+    return true;
+}
+
+static inline bool isSet(const vector<uint64_t> &bits, unsigned pos)
+{
+    return (bits[pos / 64] >> (pos % 64)) & 1;
+}
+
+static inline void clearBit(vector<uint64_t> &bits, unsigned pos)
+{
+    bits[pos / 64] &= ~(uint64_t(1) << (pos % 64));
+}
+
+ExactCover::ExactCover(const CoverTable &t, unsigned long l) : table(t), limit(l)
+{
+    rowWords = table.rowWordsCount();
+    colWords = table.colWordsCount();
+    nodes = 0;
+    aborted = false;
+}
+
+// finds minimum cover of not removed columns
+bool ExactCover::solve(vector<unsigned> &selected)
+{
+    Node root;
+    root.rows.assign(colWords, ~uint64_t(0));
+    if (table.rowsCount() % 64)
+        root.rows[colWords - 1] = (uint64_t(1) << (table.rowsCount() % 64)) - 1;
+    root.cols.assign(table.activeColumns(), table.activeColumns() + rowWords);
+
+    best = selected;
+    nodes = 0;
+    aborted = false;
+    if (reduce(root))
+        search(root);
+
+    if (best.size() < selected.size()) {
+        selected = best;
+        sort(selected.begin(), selected.end());
+    }
+    return !aborted;
+}
+
+// branch and bound search - one of rows of the column with the fewest rows
+// has to be selected, the rows which were tried are removed for next branches
+void ExactCover::search(Node &node)
+{
+    if (aborted)
+        return;
+    if (++nodes > limit) {
+        aborted = true;
+        return;
+    }
+
+    // the column with the fewest rows
+    int col = -1;
+    unsigned min = 0;
+    foreach_one(node.cols, rowWords, c) {
+        unsigned count = colCount(node, c);
+        if (col == -1 || count < min) {
+            col = c;
+            min = count;
+        }
+    }
+    if (col == -1) {
+        if (node.selected.size() < best.size())
+            best = node.selected;
+        return;
+    }
+    if (lowerBound(node) >= best.size())
+        return;
+
+    // rows covering col (the row covering the most columns first)
+    vector<pair<unsigned, unsigned> > rows;
+    const uint64_t *column = table.column(col);
+    for (unsigned w = 0; w < colWords; w++) {
+        for (uint64_t b = column[w] & node.rows[w]; b; b &= b - 1) {
+            unsigned r = w * 64 + firstOne(b);
+            unsigned count = 0;
+            for (unsigned i = 0; i < rowWords; i++)
+                count += popCount(table.row(r)[i] & node.cols[i]);
+            rows.push_back(make_pair(~count, r));
+        }
+    }
+    sort(rows.begin(), rows.end());
+
+    for (unsigned i = 0; i < rows.size() && !aborted; i++) {
+        Node child = node;
+        select(child, rows[i].second);
+        if (child.selected.size() < best.size() && reduce(child))
+            search(child);
+        clearBit(node.rows, rows[i].second);
+    }
+}
+
+// reduces the node - essential rows are selected, dominated columns
+// and rows are removed, returns false if some column can't be covered
+bool ExactCover::reduce(Node &node) const
+{
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        // essential rows
+        foreach_one(node.cols, rowWords, c) {
+            if (!isSet(node.cols, c))
+                continue;
+            unsigned count = colCount(node, c);
+            if (count == 0)
+                return false;
+            if (count == 1) {
+                const uint64_t *column = table.column(c);
+                for (unsigned w = 0; w < colWords; w++) {
+                    if (column[w] & node.rows[w]) {
+                        select(node, w * 64 + firstOne(column[w] & node.rows[w]));
+                        break;
+                    }
+                }
+                changed = true;
+            }
+        }
+
+        // column b is removed if each row covering column a covers b too
+        // (candidates are columns of the first row of a)
+        foreach_one(node.cols, rowWords, a) {
+            if (!isSet(node.cols, a))
+                continue;
+            const uint64_t *colA = table.column(a);
+            unsigned w = 0;
+            while (!(colA[w] & node.rows[w]))
+                w++;
+            unsigned r = w * 64 + firstOne(colA[w] & node.rows[w]);
+
+            const uint64_t *row = table.row(r);
+            for (unsigned i = 0; i < rowWords; i++) {
+                for (uint64_t bb = row[i] & node.cols[i]; bb; bb &= bb - 1) {
+                    unsigned b = i * 64 + firstOne(bb);
+                    if (b == a)
+                        continue;
+                    const uint64_t *colB = table.column(b);
+                    if (isSubset(colA, colB, &node.rows[0], colWords)
+                            && (a < b || !isEqual(colA, colB, &node.rows[0], colWords))) {
+                        clearBit(node.cols, b);
+                        changed = true;
+                    }
+                }
+            }
+        }
+
+        // row r is removed if some other row covers all its columns
+        // (candidates are rows of the first column of r)
+        foreach_one(node.rows, colWords, r) {
+            const uint64_t *rowR = table.row(r);
+            unsigned w = 0;
+            while (w < rowWords && !(rowR[w] & node.cols[w]))
+                w++;
+            if (w == rowWords) {
+                clearBit(node.rows, r);
+                changed = true;
+                continue;
+            }
+            unsigned c = w * 64 + firstOne(rowR[w] & node.cols[w]);
+
+            const uint64_t *column = table.column(c);
+            for (unsigned i = 0; i < colWords; i++) {
+                uint64_t ss = column[i] & node.rows[i];
+                for (; ss; ss &= ss - 1) {
+                    unsigned s = i * 64 + firstOne(ss);
+                    if (s == r)
+                        continue;
+                    const uint64_t *rowS = table.row(s);
+                    if (isSubset(rowR, rowS, &node.cols[0], rowWords)
+                            && (s < r || !isEqual(rowR, rowS, &node.cols[0], rowWords)))
+                        break;
+                }
+                if (ss) {
+                    clearBit(node.rows, r);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// selects row (its columns are removed)
+void ExactCover::select(Node &node, unsigned row) const
+{
+    const uint64_t *r = table.row(row);
+    for (unsigned i = 0; i < rowWords; i++)
+        node.cols[i] &= ~r[i];
+    clearBit(node.rows, row);
+    node.selected.push_back(row);
+}
+
+// returns number of not removed rows covering col
+unsigned ExactCover::colCount(const Node &node, unsigned col) const
+{
+    const uint64_t *column = table.column(col);
+    unsigned count = 0;
+    for (unsigned i = 0; i < colWords; i++)
+        count += popCount(column[i] & node.rows[i]);
+    return count;
+}
+
+// returns lower bound - selected rows and the number of independent
+// columns (no row covers two of them), columns with fewer rows are tried first
+unsigned ExactCover::lowerBound(const Node &node) const
+{
+    vector<pair<unsigned, unsigned> > cols;
+    foreach_one(node.cols, rowWords, c)
+        cols.push_back(make_pair(colCount(node, c), unsigned(c)));
+    sort(cols.begin(), cols.end());
+
+    vector<uint64_t> used(colWords, 0);
+    unsigned independent = 0;
+    for (unsigned k = 0; k < cols.size(); k++) {
+        const uint64_t *column = table.column(cols[k].second);
+        bool disjoint = true;
+        for (unsigned i = 0; i < colWords && disjoint; i++)
+            disjoint = !(column[i] & node.rows[i] & used[i]);
+        if (disjoint) {
+            independent++;
+            for (unsigned i = 0; i < colWords; i++)
+                used[i] |= column[i] & node.rows[i];
+        }
+    }
+    return node.selected.size() + independent;
+}
@@ -0,0 +1,79 @@
+/*
+ * exactcover.h - exact minimum covering of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EXACTCOVER_H
+#define EXACTCOVER_H
+
+#include "covertable.h"
+
+#include <vector>
+#include <stdint.h>
+
+// exact minimum covering (all rows have the same cost) - the table is reduced
+// by essential rows and by row and column dominance to the cyclic core, which
+// is solved by branch and bound with the lower bound from independent columns
+class ExactCover
+{
+public:
+    // default maximal number of branch and bound nodes
+    static const unsigned long NODES_LIMIT = 100000;
+
+    ExactCover(const CoverTable &t, unsigned long limit = NODES_LIMIT);
+
+    // finds minimum cover of not removed columns - selected has to contain
+    // a cover (upper bound), it's replaced by any smaller cover which is found,
+    // returns false if the nodes limit was exceeded (cover isn't proven minimal)
+    bool solve(std::vector<unsigned> &selected);
+
+    // number of nodes of the last solving
+    inline unsigned long getNodesCount() const { return nodes; }
+
+private:
+    // subproblem - not removed rows and columns and selected rows
+    struct Node
+    {
+        std::vector<uint64_t> rows;
+        std::vector<uint64_t> cols;
+        std::vector<unsigned> selected;
+    };
+
+    // reduces the node, returns false if some column can't be covered
+    bool reduce(Node &node) const;
+    // branch and bound search
+    void search(Node &node);
+
+    // selects row (its columns are removed)
+    void select(Node &node, unsigned row) const;
+    // returns number of not removed rows covering col
+    unsigned colCount(const Node &node, unsigned col) const;
+    // returns lower bound of the number of rows covering node
+    unsigned lowerBound(const Node &node) const;
+
+    const CoverTable &table;
+    unsigned rowWords;
+    unsigned colWords;
+
+    unsigned long limit;
+    unsigned long nodes;
+    bool aborted;
+    std::vector<unsigned> best;
+};
+
+#endif // EXACTCOVER_H
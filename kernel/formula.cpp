@@ -30,9 +30,11 @@
 #include <iterator>
 #include <stdexcept>
 #include <algorithm>
+#include <climits>
 
 #include "formula.h"
 #include "term.h"
+#include "symboltable.h"
 #include "termscontainer.h"
 #include "literalvalue.h"
 #include "outputvalue.h"
@@ -52,24 +54,41 @@ FormulaSpec::~FormulaSpec()
 
 // FORMULA CLASS METHODS
 
+const char * const Formula::DEFAULT_NAME = "f";
+
 // Constructors
 
 // default setting
-void Formula::init(int vs, const vector<char> *v, char fn, Repre r)
+void Formula::init(int vs, const vector<string> *v, const string &fn, Repre r)
         throw(InvalidVarsExc)
 {
     varsCount = vs;
-    maxIdx = (1 << vs) - 1;
+    maxIdx = (static_cast<unsigned>(vs) <= MAX_INDEX_VARS)? (1 << vs) - 1: INT_MAX;
     setVars(v, vs);
-    terms = new TermsContainer(vs);
+    // saved terms are the maxterms of POS formula
+    terms = TermsContainer::create(vs, (r == REP_SOP)? TermsContainer::MINTERMS:
+            TermsContainer::MAXTERMS);
 
-    name = fn;
+    setName(fn);
     repre = r;
     state = COMPLETE;
 }
 
+// setting by formula f (names are already interned)
+void Formula::init(const Formula &f)
+{
+    varsCount = f.varsCount;
+    maxIdx = f.maxIdx;
+    vars = f.vars;
+    terms = TermsContainer::create(varsCount);
+
+    name = f.name;
+    repre = f.repre;
+    state = COMPLETE;
+}
+
 // gets terms from vector t
-Formula::Formula(unsigned vs, char fn, Repre rep, const vector<char> *v)
+Formula::Formula(unsigned vs, const string &fn, Repre rep, const vector<string> *v)
         throw(InvalidVarsExc, InvalidTermExc)
 {
     init(vs, v, fn, rep);
@@ -137,20 +156,22 @@ Formula::Formula(const FormulaSpec *spec, const FormulaDecl *decl)
 
 Formula::Formula(const Formula &formula, const std::list<Term> &coverF)
 {
-    init(formula.varsCount, &formula.vars, formula.name, formula.repre);
+    init(formula);
     vector<Term> v(coverF.begin(), coverF.end());
-    terms->setContainer(v);
+    terms->swapContainer(v);
 }
 
 Formula::Formula(const Formula &formula, bool toMinterms)
 {
-    init(formula.varsCount, &formula.vars, formula.name, formula.repre);
+    init(formula);
     if (toMinterms) {
         vector<Term> v;
-        terms->setContainer(formula.getMinterms(v));
+        terms->swapContainer(formula.getMinterms(v));
+    }
+    else {
+        delete terms;
+        terms = formula.terms->clone();
     }
-    else
-        *terms = *formula.terms;
 
 }
 
@@ -184,7 +205,7 @@ bool Formula::isContradiction() const
 // adds new term to formula
 void Formula::pushTerm(int idx, bool isDC) throw(InvalidIndexExc)
 {
-    if (idx > maxIdx)
+    if (idx < 0 || idx > maxIdx)
         throw InvalidIndexExc(idx);
 
     if (terms->pushTerm(idx, isDC))
@@ -194,7 +215,7 @@ void Formula::pushTerm(int idx, bool isDC) throw(InvalidIndexExc)
 // removes term with idx
 void Formula::removeTerm(int idx) throw(InvalidIndexExc)
 {
-    if (idx > maxIdx)
+    if (idx < 0 || idx > maxIdx)
         throw InvalidIndexExc(idx);
 
     if (terms->removeTerm(idx))
@@ -210,7 +231,7 @@ bool Formula::hasTerm(const Term &t) const
 // sets the term t to the value val
 void Formula::setTermValue(int idx, OutputValue val) throw(InvalidIndexExc)
 {
-    if (idx > maxIdx)
+    if (idx < 0 || idx > maxIdx)
         throw InvalidIndexExc(idx);
 
     if (terms->setTermValue(idx, val))
@@ -225,8 +246,11 @@ void Formula::setTermValue(const Term &t, OutputValue val)
 }
 
 // returns value of the term with index idx
-OutputValue Formula::getTermValue(int idx) const
+OutputValue Formula::getTermValue(int idx) const throw(InvalidIndexExc)
 {
+    if (idx < 0 || idx > maxIdx)
+        throw InvalidIndexExc(idx);
+
     return terms->getTermValue(idx);
 }
 
@@ -284,8 +308,23 @@ void Formula::getCovers(std::list<Term> &f, std::list<Term> &d, std::list<Term>
     terms->getCovers(f, d, r);
 }
 
+// returns saved on-set and dc-set cubes (or dc-set and off-set cubes)
+bool Formula::getCubeCovers(std::list<Term> &f, std::list<Term> &d, std::list<Term> &r) const
+{
+    if (terms->getTermsType() == TermsContainer::MINTERMS) {
+        r.clear();
+        terms->getCubes(f, d);
+        return true;
+    }
+    else {
+        f.clear();
+        terms->getCubes(r, d);
+        return false;
+    }
+}
+
 // returns term at position pos
-const Term &Formula::getTermAt(unsigned pos) const
+Term Formula::getTermAt(unsigned pos) const
 {
     if (pos >= terms->getSize())
         throw InvalidPositionExc(pos);
@@ -302,7 +341,7 @@ unsigned Formula::getSize() const
 // returns the maximal number of terms (by tautology or contradiction)
 unsigned Formula::getMaxSize() const
 {
-    return 1 << getVarsCount();
+    return (getVarsCount() <= MAX_INDEX_VARS)? 1 << getVarsCount(): 0;
 }
 
 // initializes iterating
@@ -323,6 +362,30 @@ Term &Formula::itNext()
     return terms->itNext();
 }
 
+// returns iterator to the first term
+Formula::const_iterator Formula::begin() const
+{
+    return terms->begin();
+}
+
+// returns iterator behind the last term
+Formula::const_iterator Formula::end() const
+{
+    return terms->end();
+}
+
+// returns iterator to the first minterm of the saved terms
+Formula::minterm_iterator Formula::mintermsBegin() const
+{
+    return terms->mintermsBegin();
+}
+
+// returns iterator behind the last minterm of the saved terms
+Formula::minterm_iterator Formula::mintermsEnd() const
+{
+    return terms->mintermsEnd();
+}
+
 
 // equality
 bool Formula::operator==(const Formula &f) const
@@ -356,60 +419,100 @@ bool Formula::setRepre(Repre rep)
 // set default names for n variables
 void Formula::setVars(unsigned n)
 {
+    SymbolTable *st = SymbolTable::instance();
     vars.resize(n);
-    char var = DEFAULT_FIRST_VAR;
-    for (unsigned i = 0; i < n; i++, var++)
-        vars[i] = var;
-}
-
-// sets variables name by array of characters v
-void Formula::setVars(char *v, unsigned vs) throw(InvalidVarsExc)
-{
-    if (vs > Formula::MAX_VARS)
-        throw InvalidVarsExc(Formula::MAX_VARS);
-
-    vector<char> tmp(vs);
-    for (unsigned i = 0; i < vs; i++)
-        tmp[i] = v[i];
-
-    vars = tmp;
+    if (n <= static_cast<unsigned>(DEFAULT_LAST_VAR - DEFAULT_FIRST_VAR + 1)) {
+        char var = DEFAULT_FIRST_VAR;
+        for (unsigned i = 0; i < n; i++, var++)
+            vars[i] = st->intern(string(1, var));
+    }
+    else {
+        for (unsigned i = 0; i < n; i++) {
+            ostringstream oss;
+            oss << DEFAULT_VAR_PREFIX << i;
+            vars[i] = st->intern(oss.str());
+        }
+    }
 }
 
 // sets variables name by vector v
-void Formula::setVars(const vector<char> *v, unsigned vs) throw(InvalidVarsExc)
+void Formula::setVars(const vector<string> *v, unsigned vs) throw(InvalidVarsExc)
 {
     if (v && v->size() != vs)
         throw InvalidVarsExc();
     if (vs > Formula::MAX_VARS)
         throw InvalidVarsExc(Formula::MAX_VARS);
 
-    if (!v)
+    if (!v) {
         setVars(vs);
-    else if (vs == v->size())
-        vars = *v;
-    else {
-        vars.resize(vs);;
-        for (unsigned i = 0; i < vs; i++)
-            vars[i] = v->at(i);
+        return;
+    }
+
+    // invalid and duplicated names
+    vector<string> invalid;
+    set<string> used;
+    for (unsigned i = 0; i < vs; i++) {
+        if (!SymbolTable::isValidName(v->at(i)) || !used.insert(v->at(i)).second)
+            invalid.push_back(v->at(i));
     }
+    if (!invalid.empty())
+        throw InvalidVarsExc(invalid);
+
+    SymbolTable *st = SymbolTable::instance();
+    vars.resize(vs);
+    for (unsigned i = 0; i < vs; i++)
+        vars[i] = st->intern(v->at(i));
 }
 
 // returns variables vector
-vector<char> Formula::getVars() const
+vector<string> Formula::getVars() const
+{
+    SymbolTable *st = SymbolTable::instance();
+    vector<string> names(varsCount);
+    for (unsigned i = 0; i < varsCount; i++)
+        names[i] = st->getName(vars[i]);
+    return names;
+}
+
+// returns name of variable at position pos
+const string &Formula::getVar(unsigned pos) const
 {
-    return vars;
+    if (pos >= varsCount)
+        throw InvalidPositionExc(pos);
+
+    return SymbolTable::instance()->getName(vars[pos]);
 }
 
 // changes variable at position pos
-void Formula::changeVar(unsigned pos, char var)
+void Formula::changeVar(unsigned pos, const string &var) throw(InvalidVarsExc)
+{
+    if (pos >= varsCount)
+        return;
+
+    SymbolTable *st = SymbolTable::instance();
+    int id = st->find(var);
+    if (!SymbolTable::isValidName(var) ||
+            (id != -1 && id != vars[pos] && find(vars.begin(), vars.end(), id) != vars.end()))
+        throw InvalidVarsExc(vector<string>(1, var));
+
+    vars[pos] = st->intern(var);
+}
+
+// name setter
+void Formula::setName(const string &fn)
+{
+    name = SymbolTable::instance()->intern(fn);
+}
+
+// name getter
+const string &Formula::getName() const
 {
-    if (pos <= varsCount)
-        vars[pos] = var;
+    return SymbolTable::instance()->getName(name);
 }
 
 // friend function to place term to ostream
 ostream & operator<<(std::ostream &os, Formula &f)
 {
-    return os << "Formula " << f.name;
+    return os << "Formula " << f.getName();
 }
 
@@ -22,6 +22,8 @@
 #define FORMULA_H
 
 #include "kernelexc.h"
+#include "term.h"
+#include "termscontainer.h"
 
 #include <iostream>
 #include <string>
@@ -33,16 +35,14 @@
 
 class Kernel;
 class OutputValue;
-class TermsContainer;
-class Term;
 
 // formula declaration
 struct FormulaDecl
 {
-    FormulaDecl(std::vector<char> *v = 0, char n = 'f') : vars(v), name(n) {}
+    FormulaDecl(std::vector<std::string> *v = 0, const std::string &n = "f") : vars(v), name(n) {}
     ~FormulaDecl() { delete vars; }
-    std::vector<char> *vars;
-    char name;
+    std::vector<std::string> *vars;
+    std::string name;
 };
 
 // formula specification - using sets
@@ -68,17 +68,23 @@ public:
     enum State { COMPLETE, MINIMIZED, EXPANDED, IRREDUNDANT, REDUCED };
 
     // default function name
-    static const char DEFAULT_NAME = 'f';
+    static const char * const DEFAULT_NAME;
     // default variable name for the first variable
     static const char DEFAULT_FIRST_VAR = 'a';
+    // default variable name for the last variable (one letter names)
+    static const char DEFAULT_LAST_VAR = 'z';
+    // prefix of default variables names if they are not enough letters
+    static const char DEFAULT_VAR_PREFIX = 'x';
     // default formula representation
     static const Repre DEFAULT_REP = REP_SOP;
-    // maximal number of variables
-    static const unsigned MAX_VARS = 10;
+    // maximal number of variables (limited by term width)
+    static const unsigned MAX_VARS = Term::MAX_SIZE;
+    // maximal number of variables for index (minterm number) access
+    static const unsigned MAX_INDEX_VARS = 30;
 
     // Constructors
-    Formula(unsigned vc, char fn = DEFAULT_NAME, Repre rep = DEFAULT_REP,
-            const std::vector<char> *v = 0)
+    Formula(unsigned vc, const std::string &fn = DEFAULT_NAME, Repre rep = DEFAULT_REP,
+            const std::vector<std::string> *v = 0)
             throw(InvalidVarsExc, InvalidTermExc);
     Formula(const FormulaSpec *spec, const FormulaDecl *decl)
             throw(InvalidVarsExc, InvalidIndexExc);
@@ -100,7 +106,7 @@ public:
     // sets the term t to the value val
     void setTermValue(const Term &t, OutputValue val);
     // returns value of the term with index idx
-    OutputValue getTermValue(int idx) const;
+    OutputValue getTermValue(int idx) const throw(InvalidIndexExc);
     // returns terms indices that have output value equal to val
     std::vector<int> getTermsIdx(int val) const;
     // returns terms indices that have output value equal to val (without creating new vector)
@@ -119,11 +125,15 @@ public:
     std::vector<Term> &getMaxterms(std::vector<Term> &maxterms) const;
     // returns on-set, off-set and dc-set covers
     void getCovers(std::list<Term> &f, std::list<Term> &d, std::list<Term> &r);
+    // returns saved on-set and dc-set cubes without expanding them to minterms,
+    // returns false if the off-set is saved instead of on-set (f is empty then)
+    bool getCubeCovers(std::list<Term> &f, std::list<Term> &d, std::list<Term> &r) const;
     // returns term at position pos
-    const Term &getTermAt(unsigned pos) const;
+    Term getTermAt(unsigned pos) const;
     // returns the number of terms
     unsigned getSize() const;
     // returns the maximal number of terms (by tautology or contradiction)
+    // or 0 if the terms cannot be accessed by index
     unsigned getMaxSize() const;
 
 
@@ -131,9 +141,24 @@ public:
     void itInit();
     // finds out if there is another term
     bool itHasNext();
-    // moves to the next term
+    // moves to the next term (changes of the term aren't saved to the formula)
     Term &itNext();
 
+    // read-only iterator over the terms (without copying and changing the formula)
+    typedef TermsContainer::const_iterator const_iterator;
+    // returns iterator to the first term
+    const_iterator begin() const;
+    // returns iterator behind the last term
+    const_iterator end() const;
+
+    // read-only iterator over minterms (maxterms for POS) of the saved terms
+    // (cubes are expanded lazily, dont care minterms have DC flag)
+    typedef TermsContainer::minterm_iterator minterm_iterator;
+    // returns iterator to the first minterm of the saved terms
+    minterm_iterator mintermsBegin() const;
+    // returns iterator behind the last minterm of the saved terms
+    minterm_iterator mintermsEnd() const;
+
     // whether formula is minimized
     bool isMinimized() const { return minimized; }
     // returns state
@@ -148,31 +173,38 @@ public:
 
 
     // name setter
-    inline void setName(char fn) { name = fn; }
+    void setName(const std::string &fn);
     // name getter
-    inline char getName() const { return name; }
+    const std::string &getName() const;
     // repre setter and return true if repre was changed
     bool setRepre(Repre r);
     // repre getter
     inline Repre getRepre() const { return repre; }
 
     // returns variables
-    std::vector<char> getVars() const;
+    std::vector<std::string> getVars() const;
+    // returns name of variable at position pos
+    const std::string &getVar(unsigned pos) const;
+    // returns symbol ids of variables
+    inline const std::vector<int> &getVarsIds() const { return vars; }
     // returns number of varibles
     inline unsigned getVarsCount() const { return varsCount; }
     // changes variable at position pos
-    void changeVar(unsigned pos, char var);
+    void changeVar(unsigned pos, const std::string &var) throw(InvalidVarsExc);
 
     // friend function to place term to ostream (to debugging)
     friend std::ostream &operator<<(std::ostream &os, Formula &t);
 
     friend class QuineMcCluskey;
+    friend class Consensus;
+    friend class BitmapQuineMcCluskey;
     friend class Espresso;
     friend class Kernel;
 
 private:
-    void init(int vs, const std::vector<char> *v, char fn, Repre r = DEFAULT_REP)
-            throw (InvalidVarsExc);
+    void init(int vs, const std::vector<std::string> *v, const std::string &fn,
+              Repre r = DEFAULT_REP) throw (InvalidVarsExc);
+    void init(const Formula &f);
     inline void setMinimized(bool m) { minimized = m; }
 
     // adds new term to formula
@@ -181,21 +213,19 @@ private:
     void removeTerm(int idx) throw(InvalidIndexExc);
     // set default names for n variables
     void setVars(unsigned vc);
-    // sets variables name by array of characters v
-    void setVars(char * v, unsigned vc) throw(InvalidVarsExc);
     // sets variables name by vector v
-    void setVars(const std::vector<char> *v, unsigned vc = 0) throw(InvalidVarsExc);
+    void setVars(const std::vector<std::string> *v, unsigned vc = 0) throw(InvalidVarsExc);
 
     // container for terms
     TermsContainer *terms;
-    // formula name
-    char name;
+    // formula name (symbol id)
+    int name;
     // formula visible form
     Repre repre;
     // minimization state
     State state;
-    // names of variables
-    std::vector<char> vars;
+    // names of variables (symbol ids)
+    std::vector<int> vars;
 
     unsigned varsCount;
     bool minimized;
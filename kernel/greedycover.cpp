@@ -0,0 +1,94 @@
+/*
+ * greedycover.cpp - greedy covering of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "greedycover.h"
+#include "covertable.h"
+
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+GreedyCover::GreedyCover(CoverTable &t) : table(t)
+{
+    for (unsigned r = 0; r < table.rowsCount(); r++) {
+        if (table.rowOnes(r)) {
+            Entry e = { table.rowOnes(r), r };
+            heap.push_back(e);
+        }
+    }
+    make_heap(heap.begin(), heap.end());
+
+    for (unsigned c = 0; c < table.colsCount(); c++) {
+        if (table.colOnes(c) == 1)
+            essentials.push_back(c);
+    }
+    essentialPos = 0;
+}
+
+// selects the next row and covers its columns
+int GreedyCover::next()
+{
+    int col = essentialColumn();
+    int row = (col != -1)? table.firstRow(col): largestRow();
+    if (row != -1)
+        table.cover(row);
+    return row;
+}
+
+// selects rows until all columns are covered
+void GreedyCover::solve(vector<unsigned> &selected)
+{
+    int row;
+    while ((row = next()) != -1)
+        selected.push_back(row);
+}
+
+// returns the first essential column which isn't covered
+int GreedyCover::essentialColumn()
+{
+    for (; essentialPos < essentials.size(); essentialPos++) {
+        if (table.colOnes(essentials[essentialPos]) == 1)
+            return essentials[essentialPos];
+    }
+    return -1;
+}
+
+// returns the first row covering the most columns and removes it from
+// the heap - stale entries are pushed back with the current count
+int GreedyCover::largestRow()
+{
+    while (!heap.empty()) {
+        Entry top = heap.front();
+        pop_heap(heap.begin(), heap.end());
+        heap.pop_back();
+
+        unsigned count = table.rowOnes(top.row);
+        // the row is covered by the caller (its count drops to zero)
+        if (count == top.count)
+            return top.row;
+        if (count) {
+            top.count = count;
+            heap.push_back(top);
+            push_heap(heap.begin(), heap.end());
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,70 @@
+/*
+ * greedycover.h - greedy covering of the covering table
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GREEDYCOVER_H
+#define GREEDYCOVER_H
+
+#include "covertable.h"
+
+#include <vector>
+
+// greedy covering - the only row of some column (essential row) is selected
+// first, otherwise the first row covering the most columns is selected
+class GreedyCover
+{
+public:
+    GreedyCover(CoverTable &t);
+
+    // selects the next row and covers its columns, returns -1 if no row covers
+    // any remaining column
+    int next();
+    // selects rows until all columns are covered (selected rows are appended)
+    void solve(std::vector<unsigned> &selected);
+
+private:
+    // entry of heap of rows - count is the count of ones when it was pushed
+    struct Entry
+    {
+        unsigned count;
+        unsigned row;
+
+        // the row with more ones (or the lower one) is greater
+        inline bool operator<(const Entry &e) const
+        {
+            return count < e.count || (count == e.count && row > e.row);
+        }
+    };
+
+    // returns the first essential column or -1
+    int essentialColumn();
+    // returns the first row covering the most columns or -1
+    int largestRow();
+
+    CoverTable &table;
+
+    // max-heap of rows (entries are revalidated lazily - counts only decrease)
+    std::vector<Entry> heap;
+    // columns covered only by one row in ascending order (counts of columns
+    // only drop to zero, so no column is added later)
+    std::vector<unsigned> essentials;
+    unsigned essentialPos;
+};
+
+#endif // GREEDYCOVER_H
@@ -24,9 +24,12 @@
 #include "formula.h"
 #include "outputvalue.h"
 #include "espresso.h"
+#include "consensus.h"
+#include "bitmapquinemccluskey.h"
 #include "quinemccluskey.h"
 #include "kmap.h"
 #include "cube.h"
+#include "threadpool.h"
 
 #include <algorithm>
 
@@ -39,6 +42,8 @@ for (list<Events *>::iterator _it = events.begin(); _it != events.end(); _it++)
 // preinicialize static instance
 Kernel *Kernel::s_instance = 0;
 
+const char * const Kernel::CURRENT_FCE_NAME = "";
+
 // return instance of Kernel class
 Kernel *Kernel::instance()
 {
@@ -53,6 +58,8 @@ void Kernel::destroy()
 {
     delete s_instance;
     s_instance = 0;
+    // the symbol table isn't deleted, formulas can outlive the kernel
+    ThreadPool::destroy();
 }
 
 // constructor
@@ -61,6 +68,8 @@ Kernel::Kernel()
     formula = minFormula = tempFormula = 0;
     espresso = new Espresso;
     qm = new QuineMcCluskey;
+    consensus = new Consensus;
+    bitmapQm = new BitmapQuineMcCluskey;
     kmap = new KMap;
     cube = new Cube;
     repre = Constants::SOP_DEFAULT? Formula::REP_SOP: Formula::REP_POS;
@@ -82,6 +91,8 @@ Kernel::~Kernel()
     delete kmap;
     delete cube;
     delete qm;
+    delete consensus;
+    delete bitmapQm;
     delete espresso;
 }
 
@@ -109,6 +120,10 @@ void Kernel::setAlgorithm(Algorithm alg)
 
     if (algorithm == QM)
         ma = qm;
+    else if (algorithm == CONSENSUS)
+        ma = consensus;
+    else if (algorithm == BITMAP_QM)
+        ma = bitmapQm;
     else
         ma = espresso;
 
@@ -120,6 +135,30 @@ void Kernel::setAlgorithm(Algorithm alg)
     emitEvent(evtAlgorithmChanged(algorithm));
 }
 
+// sets exact covering for Quine-McCluskey (and the engines which use its covering)
+void Kernel::setExactCover(bool value)
+{
+    if (value == qm->isExactCover())
+        return;
+
+    qm->setExactCover(value);
+    consensus->setExactCover(value);
+    bitmapQm->setExactCover(value);
+    emitEvent(evtCoverChanged(value));
+
+    if (algorithm != ESPRESSO && formula && minFormula && formula->isMinimized()) {
+        formula->setMinimized(false);
+        minFormula->setMinimized(false);
+        emitEvent(evtFormulaChanged(formula));
+    }
+}
+
+// whether Quine-McCluskey uses exact covering
+bool Kernel::isExactCover() const
+{
+    return qm->isExactCover();
+}
+
 // returns formula with minterms or maxterms
 Formula *Kernel::getFormula() const
 {
@@ -171,8 +210,10 @@ void Kernel::setFormulas(const std::vector<Formula *> &fs)
 // selectes one formula from formulas and sets it as actual
 void Kernel::selectFormula(unsigned i)
 {
-    if (i <= formulas.size())
-        setFormula(new Formula(*formulas[i], true));
+    // functions with too many variables are kept as cubes
+    if (i < formulas.size())
+        setFormula(new Formula(*formulas[i],
+                formulas[i]->getVarsCount() <= Formula::MAX_INDEX_VARS));
 }
 
 // deletes formula and emits event
@@ -196,9 +237,23 @@ void Kernel::minimizeFormula(bool debug)
             me.enableEspresso();
 
         // minimize only when it is necessary (no redundant minimization)
-        if (!formula->isMinimized() || (debug && (algorithm == ESPRESSO || !qm->isDebug()))) {
+        if (!formula->isMinimized() || (debug && (algorithm == ESPRESSO || (algorithm == QM && !qm->isDebug())))) {
             me.enableRun();
-            minFormula = ma->minimize(formula, debug);
+            // the previous minimal formula is owned by kernel (temporary one isn't)
+            if (tempFormula) {
+                delete tempFormula;
+                tempFormula = 0;
+            }
+            else
+                delete minFormula;
+            minFormula = 0;
+            try {
+                minFormula = ma->minimize(formula, debug);
+            }
+            catch (KernelExc &exc) { // the algorithm can't minimize the formula
+                error(exc);
+                return;
+            }
             emitEvent(evtFormulaMinimized(minFormula, me));
         }
         else
@@ -313,24 +368,19 @@ void Kernel::setVars(int n)
     emitEvent(evtFormulaChanged(formula));
 }
 
-// sets variables name by array of characters v
-void Kernel::setVars(char *v, int n)
-{
-    if (!formula)
-        return;
-
-    formula->setVars(v, n);
-    emitEvent(evtFormulaChanged(formula));
-}
-
 // sets variables name by vector v
-void Kernel::setVars(const vector<char> *v, int vs)
+void Kernel::setVars(const vector<string> *v, int vs)
 {
     if (!formula)
         return;
 
-    formula->setVars(v, vs);
-    emitEvent(evtFormulaChanged(formula));
+    try {
+        formula->setVars(v, vs);
+        emitEvent(evtFormulaChanged(formula));
+    }
+    catch (InvalidVarsExc &exc) {
+        emitEvent(evtError(exc));
+    }
 }
 
 // sets represatation of logic function
@@ -393,7 +443,7 @@ void Kernel::showCube()
 }
 
 // show logic function
-void Kernel::showFce(char name)
+void Kernel::showFce(const string &name)
 {
     if (formula && (name == CURRENT_FCE_NAME || formula->getName() == name))
         emitEvent(evtShowFce(formula, formula->isMinimized()? minFormula: 0));
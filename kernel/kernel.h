@@ -35,6 +35,8 @@ class Espresso;
 class EspressoData;
 class QuineMcCluskey;
 class QuineMcCluskeyData;
+class Consensus;
+class BitmapQuineMcCluskey;
 class KMap;
 class Cube;
 
@@ -43,14 +45,15 @@ class Kernel
 {
 public:
     // available minimizing algorithms
-    enum Algorithm { QM, ESPRESSO };
+    enum Algorithm { QM, ESPRESSO, CONSENSUS, BITMAP_QM };
 
     // returns instance of the Kernel class - singleton pattern
     static Kernel *instance();
     // deletes kernel instance
     static void destroy();
 
-    static const char CURRENT_FCE_NAME = '\0';
+    // name used for selecting the actual function
+    static const char * const CURRENT_FCE_NAME;
 
     // adds new events' class
     void registerEvents(Events *evt);
@@ -61,6 +64,10 @@ public:
     void setAlgorithm(Algorithm alg);
     // returns minimizing algorithm
     Algorithm getAlgorithm() { return algorithm; }
+    // sets exact covering for Quine-McCluskey
+    void setExactCover(bool value);
+    // whether Quine-McCluskey uses exact covering
+    bool isExactCover() const;
 
     // returns formula with minterms or maxterms
     Formula *getFormula() const;
@@ -89,10 +96,8 @@ public:
     void setTermValue(int idx, OutputValue val);
     // set default names for n variables
     void setVars(int n);
-    // sets variables name by array of characters v
-    void setVars(char * v, int n);
     // sets variables name by vector v
-    void setVars(const std::vector<char> *v, int vs = 0);
+    void setVars(const std::vector<std::string> *v, int vs = 0);
 
     // sets represatation of logic function
     void setRepre(Formula::Repre rep);
@@ -128,7 +133,7 @@ public:
     // show Boolean n-Cube
     void showCube();
     // show logic function
-    void showFce(char name = CURRENT_FCE_NAME);
+    void showFce(const std::string &name = CURRENT_FCE_NAME);
 
 private:
     // private default constructor - singleton
@@ -163,6 +168,10 @@ private:
     Espresso *espresso;
     // Quine-McCluskey algorithm instance
     QuineMcCluskey *qm;
+    // iterated consensus algorithm instance
+    Consensus *consensus;
+    // Quine-McCluskey on bit-parallel truth table instance
+    BitmapQuineMcCluskey *bitmapQm;
     // Karnaugh map instance
     KMap *kmap;
     // Cube instance
@@ -15,7 +15,21 @@ SOURCES += formula.cpp \
     espressocover.cpp \
     quinemccluskeydata.cpp \
     espressodata.cpp \
-    termssortinglist.cpp
+    termssortinglist.cpp \
+    symboltable.cpp \
+    bitmatrix.cpp \
+    arena.cpp \
+    cofactorview.cpp \
+    termshash.cpp \
+    termstree.cpp \
+    threadpool.cpp \
+    termsbatch.cpp \
+    covertable.cpp \
+    greedycover.cpp \
+    exactcover.cpp \
+    coverblocks.cpp \
+    consensus.cpp \
+    bitmapquinemccluskey.cpp
 HEADERS += formula.h \
     term.h \
     kernelexc.h \
@@ -33,4 +47,20 @@ HEADERS += formula.h \
     espressocover.h \
     quinemccluskeydata.h \
     espressodata.h \
-    termssortinglist.h
+    termssortinglist.h \
+    termstorage.h \
+    symboltable.h \
+    bitmatrix.h \
+    arena.h \
+    cofactorview.h \
+    termshash.h \
+    termstree.h \
+    threadpool.h \
+    termsbatch.h \
+    covertable.h \
+    greedycover.h \
+    exactcover.h \
+    coverblocks.h \
+    consensus.h \
+    bitmapquinemccluskey.h
+unix:LIBS += -lpthread
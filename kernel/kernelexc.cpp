@@ -51,9 +51,10 @@ const char *InvalidVarsExc::what() const throw()
                 s += ", ";
             s += invalidNames[i];
         }
-        s += " (You have to use only Ascii Alfa characters)";
+        s += " (names have to be unique and start with Ascii Alfa character)";
     }
-    return s.c_str();
+    msg = s;
+    return msg.c_str();
 }
 
 // statement of InvalidTermPosExc
@@ -45,14 +45,16 @@ public:
     // default constructor (used by bad count of variables)
     InvalidVarsExc(int max = 0) : maxVars(max) {}
     // constructor (used by invalid varibles name)
-    InvalidVarsExc(const std::vector<char> & names) : KernelExc(), invalidNames(names) {}
+    InvalidVarsExc(const std::vector<std::string> & names) : KernelExc(), invalidNames(names) {}
     ~InvalidVarsExc() throw() {}
     virtual Type getType() { return VARS; }
     const char *what() const throw();
 
 private:
-    std::vector<char> invalidNames;
+    std::vector<std::string> invalidNames;
     int maxVars;
+    // statement (it has to live as long as the exception)
+    mutable std::string msg;
 };
 
 // invalid position in term
@@ -57,7 +57,7 @@ int GrayCode::getIdx(int gc)
 
 
 // KMap CELL
-KMapCell::KMapCell(unsigned row,  unsigned col, unsigned idx, Term &t)
+KMapCell::KMapCell(unsigned row,  unsigned col, unsigned idx, const Term &t)
 {
     term = t;
     mapRow = row;
@@ -91,13 +91,9 @@ void KMapCell::setSelection(bool sel)
 KMapCover::KMapCover(unsigned idx, const Term &t, KMap *kmap)
 {
     index = idx;
-    list<Term> terms;
-    Term::expandTerm(terms, t);
-
-
     unsigned row, col;
-    for (list<Term>::iterator it = terms.begin(); it != terms.end(); it++) {
-        kmap->getRowCol((*it).getIdx(), row, col);
+    for (Term::minterm_iterator it = t.mintermsBegin(); it != t.mintermsEnd(); ++it) {
+        kmap->getRowCol(it.idx(), row, col);
         cells.push_back(KMapCell(row, col, index, *it));
     }
 
@@ -146,7 +142,6 @@ void KMap::setFormula(Formula *f)
         varsCount = f->getVarsCount();
         cellsCount = 1 << varsCount;
         // setting side and top vars and grey codes
-        vars = f->getVars();
         makeVarsAndGC();
     }
 }
@@ -157,47 +152,47 @@ void KMap::makeVarsAndGC()
     sideVars.clear();
     switch (varsCount) {
     case 1:
-        topVars.push_back(vars[0]);
+        topVars.push_back(formula->getVar(0));
         topGC.generate(1);
         sideGC.generate(0);
         break;
     case 2:
-        topVars.push_back(vars[0]);
-        sideVars.push_back(vars[1]);
+        topVars.push_back(formula->getVar(0));
+        sideVars.push_back(formula->getVar(1));
         topGC.generate(1);
         sideGC.generate(1);
         break;
     case 3:
-        topVars.push_back(vars[0]);
-        topVars.push_back(vars[1]);
-        sideVars.push_back(vars[2]);
+        topVars.push_back(formula->getVar(0));
+        topVars.push_back(formula->getVar(1));
+        sideVars.push_back(formula->getVar(2));
         topGC.generate(2);
         sideGC.generate(1);
         break;
     case 4:
-        topVars.push_back(vars[0]);
-        topVars.push_back(vars[1]);
-        sideVars.push_back(vars[2]);
-        sideVars.push_back(vars[3]);
+        topVars.push_back(formula->getVar(0));
+        topVars.push_back(formula->getVar(1));
+        sideVars.push_back(formula->getVar(2));
+        sideVars.push_back(formula->getVar(3));
         topGC.generate(2);
         sideGC.generate(2);
         break;
     case 5:
-        topVars.push_back(vars[0]);
-        topVars.push_back(vars[1]);
-        sideVars.push_back(vars[2]);
-        sideVars.push_back(vars[3]);
-        sideVars.push_back(vars[4]);
+        topVars.push_back(formula->getVar(0));
+        topVars.push_back(formula->getVar(1));
+        sideVars.push_back(formula->getVar(2));
+        sideVars.push_back(formula->getVar(3));
+        sideVars.push_back(formula->getVar(4));
         topGC.generate(2);
         sideGC.generate(3);
         break;
     case 6:
-        topVars.push_back(vars[0]);
-        topVars.push_back(vars[1]);
-        topVars.push_back(vars[5]);
-        sideVars.push_back(vars[2]);
-        sideVars.push_back(vars[3]);
-        sideVars.push_back(vars[4]);
+        topVars.push_back(formula->getVar(0));
+        topVars.push_back(formula->getVar(1));
+        topVars.push_back(formula->getVar(5));
+        sideVars.push_back(formula->getVar(2));
+        sideVars.push_back(formula->getVar(3));
+        sideVars.push_back(formula->getVar(4));
         topGC.generate(3);
         sideGC.generate(3);
         break;
@@ -265,8 +260,9 @@ list<KMapCover> *KMap::getMinCovers()
         return 0;
 
     covers.clear();
-    for (unsigned i = 0; i < minFormula->getSize(); i++)
-        covers.push_back(KMapCover(i, minFormula->getTermAt(i), this));
+    unsigned i = 0;
+    for (Formula::const_iterator it = minFormula->begin(); it != minFormula->end(); ++it)
+        covers.push_back(KMapCover(i++, *it, this));
 
     return &covers;
 }
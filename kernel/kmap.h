@@ -25,6 +25,7 @@
 #include "term.h"
 
 #include <vector>
+#include <string>
 #include <list>
 
 class Formula;
@@ -61,7 +62,7 @@ public:
     static const int VISITED  = 0x10;
     static const int SELECTED = 0x20;
 
-    KMapCell(unsigned row,  unsigned col, unsigned idx, Term &t);
+    KMapCell(unsigned row,  unsigned col, unsigned idx, const Term &t);
 
     Term getTerm() const { return term; }
     inline unsigned getRow() const { return mapRow; }
@@ -131,8 +132,8 @@ public:
     void setFormula(Formula *f);
     bool isValid() { return error == OK; }
 
-    std::vector<char> *getTopVars() { return &topVars; }
-    std::vector<char> *getSideVars() { return &sideVars; }
+    std::vector<std::string> *getTopVars() { return &topVars; }
+    std::vector<std::string> *getSideVars() { return &sideVars; }
 
     int getTopGC(int idx) { return topGC.getCode(idx); }
     int getSideGC(int idx) { return sideGC.getCode(idx); }
@@ -162,9 +163,8 @@ private:
     Formula *formula;
     std::list<KMapCover> covers;
 
-    std::vector<char> vars;
-    std::vector<char> topVars;
-    std::vector<char> sideVars;
+    std::vector<std::string> topVars;
+    std::vector<std::string> sideVars;
 
     GrayCode topGC;
     GrayCode sideGC;
@@ -28,9 +28,13 @@ class MinimizingAlgorithm
 public:
     MinimizingAlgorithm() : of(0), mf(0), debug(false) {}
 
+    // returns new minimized formula f, the caller owns it (the algorithm
+    // keeps only a reference to the last one)
     virtual Formula *minimize(Formula *f, bool debug) = 0;
 
+    // the last minimized formula (owned by the caller of minimize)
     virtual inline Formula *getMinimizedFormula() { return mf; }
+    // the copy of the last original formula (owned by the algorithm)
     virtual inline Formula *getOriginalFormula() { return of; }
 
     // debugging
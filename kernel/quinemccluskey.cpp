@@ -24,14 +24,24 @@
 #include "term.h"
 #include "termscontainer.h"
 #include "literalvalue.h"
+#include "threadpool.h"
+#include "covertable.h"
+#include "greedycover.h"
+#include "exactcover.h"
+#include "coverblocks.h"
+#include "termstree.h"
 
 #include <vector>
-#include <list>
 #include <set>
 #include <algorithm>
+#include <utility>
 using namespace std;
 
-QuineMcCluskey::QuineMcCluskey() : MinimizingAlgorithm() {}
+QuineMcCluskey::QuineMcCluskey() : MinimizingAlgorithm()
+{
+    exactCover = false;
+    nodesLimit = ExactCover::NODES_LIMIT;
+}
 
 QuineMcCluskey::~QuineMcCluskey()
 {
@@ -40,6 +50,10 @@ QuineMcCluskey::~QuineMcCluskey()
 
 Formula *QuineMcCluskey::minimize(Formula *f, bool dbg)
 {
+    // minterms of the formula couldn't be saved
+    if (f->getVarsCount() > Formula::MAX_INDEX_VARS)
+        throw InvalidVarsExc(Formula::MAX_INDEX_VARS);
+
     setDebug(dbg);
 
     delete of;
@@ -59,7 +73,54 @@ Formula *QuineMcCluskey::minimize(Formula *f, bool dbg)
     return mf;
 }
 
+Formula *QuineMcCluskey::minimizeCubes(Formula *f)
+{
+    setDebug(false);
+
+    delete of;
+    of = new Formula(*f);
+    mf = new Formula(*of);
+
+    if (of->getSize() > 0) {
+        findPrimeImplicants();
+        findFinalImplicants();
+    }
+
+    mf->setMinimized(true);
+    f->setMinimized(true);
+
+    return mf;
+}
+
+// returns term i of batch b
+static inline Term batchTerm(const TermsBatch &b, unsigned i, unsigned vc)
+{
+    return Term(b.getLiters<Term::bits_t>(i), b.getMissing<Term::bits_t>(i), vc, b.getFlags(i));
+}
 
+// task combining the buckets of one level (one index for each number of explicits)
+class QuineMcCluskey::LevelTask : public ThreadTask
+{
+public:
+    LevelTask(QuineMcCluskey *q, Bucket *l, Bucket *o, unsigned v, bool s) :
+            qm(q), level(l), out(o), vc(v), sop(s) {}
+
+    void run(unsigned explicits)
+    {
+        qm->combineBuckets(level[explicits], level[explicits + 1], out[explicits], vc, sop);
+    }
+
+private:
+    QuineMcCluskey *qm;
+    Bucket *level;
+    Bucket *out;
+    unsigned vc;
+    bool sop;
+};
+
+// terms in the table are grouped to buckets by number of missings and explicits,
+// buckets of one level are combined in parallel and debug data are added
+// in the serial order afterwards
 void QuineMcCluskey::findPrimeImplicants()
 {
     if (!(of && mf))
@@ -67,9 +128,9 @@ void QuineMcCluskey::findPrimeImplicants()
 
     // inicialization
     int missings, explicits, varsCount;
-    Term *pterm, *combined;
-    list<Term *> *left, *right, *out;
-    list<Term *>::iterator lit, rit, it;
+    unsigned i, levelSize;
+    Term *pterm;
+    Bucket *bucket;
 
     bool sop = (of->getRepre() == Formula::REP_SOP);
     varsCount = of->varsCount;
@@ -77,84 +138,193 @@ void QuineMcCluskey::findPrimeImplicants()
     if (debug)
         data.initImpls(varsCount, sop);
 
-    // inicializing matrix with vectors contained pointers to terms
-    list<Term *> **table = new list<Term *> *[varsCount + 1];
-    for (int i = 0; i <= varsCount; i++)
-        table[i] = new list<Term *>[varsCount + 1];
+    // inicializing matrix of buckets
+    Bucket **table = new Bucket *[varsCount + 1];
+    for (missings = 0; missings <= varsCount; missings++) {
+        table[missings] = new Bucket[varsCount + 1];
+        for (explicits = 0; explicits <= varsCount; explicits++)
+            table[missings][explicits].terms.reset(varsCount);
+    }
 
     // sorting terms by numbers of dont cares and explicits
     int foundLiteral = LiteralValue::ZERO;
     if (sop)
         foundLiteral = LiteralValue::ONE;
+    // bucket and position of original terms
+    vector<pair<int, unsigned> > origins;
     of->itInit();
     while (of->itHasNext()) {
         pterm = &of->itNext();
         explicits = pterm->valuesCount(foundLiteral);
-        table[0][explicits].push_back(pterm);
 
         if (debug) {
             pterm->setOne(sop);
             data.addImpl(0, explicits, pterm);
         }
+
+        bucket = &table[0][explicits];
+        origins.push_back(make_pair(explicits, bucket->terms.size()));
+        bucket->index.insert(bucket_bits(pterm->getLiters()), bucket_bits(pterm->getMissing()),
+                bucket->terms.size());
+        bucket->terms.add(pterm->getLiters(), pterm->getMissing(), pterm->getFlags());
     }
+    levelSize = origins.size();
 
     // generating new terms - minimazation
-    for (missings = 0; missings < varsCount; missings++) {
+    ThreadPool *pool = ThreadPool::instance();
+    for (missings = 0; missings < varsCount && levelSize; missings++) {
+        LevelTask task(this, table[missings], table[missings + 1], varsCount, sop);
+        if (levelSize < PARALLEL_MIN) {
+            for (explicits = 0; explicits < varsCount; explicits++)
+                task.run(explicits);
+        }
+        else
+            pool->run(task, varsCount);
+
+        levelSize = 0;
         for (explicits = 0; explicits < varsCount; explicits++) {
-            left = &table[missings][explicits];
-            right = &table[missings][explicits + 1];
-            out = &table[missings + 1][explicits];
-
-            for (lit = left->begin(); lit != left->end(); lit++) {
-                for (rit = right->begin(); rit != right->end(); rit++) {
-                    // combine actual left and right
-                    combined = (*lit)->combine(**rit);
-                    if (combined) {
-                        // if combined isn't in out
-                        if (doesNotHaveTerm(out, combined)) {
-                            out->push_back(combined);
-                            if (debug) {
-                                combined->setOne(sop);
-                                data.addImpl(missings + 1, explicits, combined);
-                                data.addCombination(*lit, *rit, combined);
-                            }
-                        }
-
-                        mf->terms->removeTerm(**lit);
-                        mf->terms->removeTerm(**rit);
-                        mf->terms->pushTerm(*combined);
-                    }
+            bucket = &table[missings + 1][explicits];
+            levelSize += bucket->terms.size();
+            if (debug) {
+                for (i = 0; i < bucket->combinations.size(); i++) {
+                    Combination &c = bucket->combinations[i];
+                    Term left = batchTerm(table[missings][explicits].terms, c.left, varsCount);
+                    Term right = batchTerm(table[missings][explicits + 1].terms, c.right, varsCount);
+                    Term combined = batchTerm(bucket->terms, c.combined, varsCount);
+                    data.addImpl(missings + 1, explicits, &combined);
+                    data.addCombination(&left, &right, &combined);
                 }
+                bucket->combinations.clear();
             }
         }
     }
 
-    // deletes all rows from table
-    for (int i = 0; i <= varsCount; i++) {
-        // deletes all combined terms (dynamicly allocated)
-        if (i > 0) {
-            for (int j = 0; j <= varsCount; j++) {
-                for (it = table[i][j].begin(); it != table[i][j].end(); it++)
-                    delete *it;
+    // prime implicants are terms which weren't combined (the copies
+    // of original terms in mf are used), combined terms are in
+    // the order of creation
+    vector<Term> primes;
+    i = 0;
+    for (Formula::const_iterator it = mf->begin(); it != mf->end(); ++it, i++) {
+        bucket = &table[0][origins[i].first];
+        bucket->leftUsed.resize(bucket->terms.size(), 0);
+        bucket->rightUsed.resize(bucket->terms.size(), 0);
+        if (!bucket->leftUsed[origins[i].second] && !bucket->rightUsed[origins[i].second])
+            primes.push_back(*it);
+    }
+    for (missings = 1; missings <= varsCount; missings++) {
+        for (explicits = 0; explicits <= varsCount; explicits++) {
+            bucket = &table[missings][explicits];
+            bucket->leftUsed.resize(bucket->terms.size(), 0);
+            bucket->rightUsed.resize(bucket->terms.size(), 0);
+            for (i = 0; i < bucket->terms.size(); i++) {
+                if (!bucket->leftUsed[i] && !bucket->rightUsed[i])
+                    primes.push_back(batchTerm(bucket->terms, i, varsCount));
             }
         }
-        // deletes row
-        delete [] table[i];
     }
+    mf->terms->swapContainer(primes);
+
     // deletes table
+    for (missings = 0; missings <= varsCount; missings++)
+        delete [] table[missings];
     delete [] table;
 }
 
-bool QuineMcCluskey::doesNotHaveTerm(list<Term *> *l, Term *t)
+// combines terms from left and right buckets to out bucket - small right
+// bucket is scanned by the batch kernel, partners in the big one are found
+// in its index (left term with one bound variable flipped)
+void QuineMcCluskey::combineBuckets(Bucket &left, Bucket &right, Bucket &out, unsigned vc, bool sop)
 {
-    for (list<Term *>::iterator it = l->begin(); it != l->end(); it++) {
-        if (*(*it) == *t)
-            return false;
-    }
+    unsigned i, k;
+    int partner;
+    vector<unsigned> partners;
+
+    left.leftUsed.resize(left.terms.size(), 0);
+    right.rightUsed.resize(right.terms.size(), 0);
+    if (left.terms.isEmpty() || right.terms.isEmpty())
+        return;
 
-    return true;
+    bool scan = (right.terms.size() <= SCAN_FACTOR * vc);
+    TermsBatch combined(vc);
+
+    for (i = 0; i < left.terms.size(); i++) {
+        partners.clear();
+        if (scan)
+            right.terms.findCombinable(left.terms, i, partners);
+        else {
+            bucket_bits liters = left.terms.getLiters<bucket_bits>(i);
+            bucket_bits missing = left.terms.getMissing<bucket_bits>(i);
+            for (k = 0; k < vc; k++) {
+                if (missing.test(k))
+                    continue;
+                partner = right.index.find(liters ^ bucket_bits::bit(k), missing);
+                if (partner != BasicTermsHash<bucket_storage>::NONE)
+                    partners.push_back(partner);
+            }
+            // the same order as the right bucket
+            sort(partners.begin(), partners.end());
+        }
+        if (partners.empty())
+            continue;
+
+        // flags of combined terms are the same as with Term::combine
+        int flg = (left.terms.getFlags(i) & Term::DC)? Term::ONE: 0;
+        if (debug)
+            flg = sop? (flg | Term::ONE): (flg & ~Term::ONE);
+
+        combined.clear();
+        right.terms.combine(left.terms, i, partners, combined, flg);
+        left.leftUsed[i] = 1;
+        for (k = 0; k < partners.size(); k++) {
+            right.rightUsed[partners[k]] = 1;
+
+            // if combined isn't in out
+            if (out.index.insert(combined.getLiters<bucket_bits>(k),
+                    combined.getMissing<bucket_bits>(k), out.terms.size())) {
+                if (debug) {
+                    Combination c = { i, partners[k], out.terms.size() };
+                    out.combinations.push_back(c);
+                }
+                out.terms.add(combined, k);
+            }
+        }
+    }
 }
 
+// task covering independent blocks of the covering table - greedy covering
+// (implicant by largest covering), the exact covering can only improve it
+class CoverTask : public ThreadTask
+{
+public:
+    CoverTask(const CoverBlocks &b, vector<vector<unsigned> > &s, bool e, unsigned long l) :
+            blocks(b), selected(s), exact(e), limit(l) {}
+
+    void run(unsigned block)
+    {
+        CoverTable table;
+        blocks.makeTable(block, table);
+
+        vector<unsigned> &rows = selected[block];
+        if (exact) {
+            CoverTable greedyTable(table);
+            GreedyCover(greedyTable).solve(rows);
+            ExactCover(table, limit).solve(rows);
+        }
+        else
+            GreedyCover(table).solve(rows);
+
+        // rows of the block table to rows of the table
+        for (unsigned i = 0; i < rows.size(); i++)
+            rows[i] = blocks.rows(block)[rows[i]];
+    }
+
+private:
+    const CoverBlocks &blocks;
+    vector<vector<unsigned> > &selected;
+    bool exact;
+    unsigned long limit;
+};
+
 void QuineMcCluskey::findFinalImplicants()
 {
     if (!(of && mf))
@@ -162,7 +332,7 @@ void QuineMcCluskey::findFinalImplicants()
 
     int impl, term, implsCount, origTermsSize;
 
-    vector<Term> *explicitsTerms = getTermsVector(of->terms, true);
+    vector<Term> *explicitsTerms = getCoverTerms();
     vector<Term> *terms = getTermsVector(mf->terms);
 
     implsCount = mf->terms->getSize();
@@ -176,107 +346,61 @@ void QuineMcCluskey::findFinalImplicants()
     }
 
 
-    // table of covering
-    bool **table = new bool *[implsCount];
-    for (impl = 0; impl < implsCount; impl++) {
-        table[impl] = new bool[origTermsSize];
-        for (term = 0; term < origTermsSize; term++) {
-            table[impl][term] = (*terms)[impl].implies(explicitsTerms->at(term));
-            if (debug && table[impl][term])
-                data.setCover(impl, term);
+    // table of covering - implicants containing the term are found in the tree
+    CoverTable table(implsCount, origTermsSize);
+    TermsTree tree(of->varsCount);
+    for (impl = 0; impl < implsCount; impl++)
+        tree.insert((*terms)[impl], impl);
+    vector<int> containing;
+    for (term = 0; term < origTermsSize; term++) {
+        containing.clear();
+        tree.findContaining(explicitsTerms->at(term), containing);
+        for (unsigned i = 0; i < containing.size(); i++) {
+            table.set(containing[i], term);
+            if (debug)
+                data.setCover(containing[i], term);
         }
     }
 
-    // vector with final terms
-    vector<Term> v;
-    bool done = false;
-    while (!done) {
-        // finds essential prime impicants
-        impl = extractEssentialImplicants(table, implsCount, origTermsSize);
-        if (impl != -1)
-            v.push_back((*terms)[impl]);
-        else {
-            impl = extractLargestImplicants(table, implsCount, origTermsSize);
-            if (impl != -1)
-                v.push_back((*terms)[impl]);
-            else
-                done = true;
-        }
+    // essential prime implicants are selected first, the rest of the table
+    // is split to independent blocks which are covered in parallel (only with
+    // POSIX threads, Windows builds cover the blocks serially)
+    vector<unsigned> selected;
+    table.coverEssentials(selected);
+    CoverBlocks blocks(table);
+    if (debug) {
+        data.setEssentialsCount(selected.size());
+        for (unsigned b = 0; b < blocks.count(); b++)
+            data.addBlock(blocks.rows(b).size(), blocks.columns(b).size());
     }
-    mf->terms->setContainer(v);
 
-    delete explicitsTerms;
-}
+    vector<vector<unsigned> > blocksSelected(blocks.count());
+    CoverTask task(blocks, blocksSelected, exactCover, nodesLimit);
+    ThreadPool::instance()->run(task, blocks.count());
+    for (unsigned b = 0; b < blocks.count(); b++)
+        selected.insert(selected.end(), blocksSelected[b].begin(), blocksSelected[b].end());
 
-vector<Term> *QuineMcCluskey::getTermsVector(TermsContainer *tc, bool onlyExplicits) const
-{
-    vector<Term> *pv = new vector<Term>;
-    tc->itInit();
-    while (tc->itHasNext()) {
-        Term t = tc->itNext();
-        if (!onlyExplicits || !t.isDC())
-            pv->push_back(t);
-    }
-    return pv;
-}
+    // vector with final terms
+    vector<Term> v;
+    for (unsigned i = 0; i < selected.size(); i++)
+        v.push_back((*terms)[selected[i]]);
+    mf->terms->swapContainer(v);
 
-int QuineMcCluskey::extractEssentialImplicants(bool **table, int nImpls, int nTerms) const
-{
-    int lastImpl, term, impl;
-    lastImpl = -1;
-
-    // for each original minterm
-    for (term = 0; term < nTerms; term++) {
-        // for each prime implicant
-        for (impl = 0; impl < nImpls; impl++) {
-            if (table[impl][term]) {
-                if (lastImpl == -1)
-                    lastImpl = impl;
-                else { // more implicants
-                    lastImpl = -1;
-                    break;
-                }
-            }
-        }
-        if (lastImpl != -1) {
-            extractImplicant(table, nImpls, nTerms, lastImpl);
-            return lastImpl;
-        }
-    }
-    return -1;
+    delete explicitsTerms;
+    delete terms;
 }
 
-int QuineMcCluskey::extractLargestImplicants(bool **table, int nImpls, int nTerms) const
+vector<Term> *QuineMcCluskey::getCoverTerms() const
 {
-    int maxTerms, maxTermsImpl, termsCount, impl, term;
-    maxTerms = 0;
-    maxTermsImpl = -1;
-    for (impl = 0; impl < nImpls; impl++) {
-        // for each prime implicant
-        termsCount = 0;
-        // counts number of covered terms
-        for (term = 0; term < nTerms; term++) {
-            if (table[impl][term])
-                termsCount++;
-        }
-        if (maxTerms < termsCount) {
-            maxTerms = termsCount;
-            maxTermsImpl = impl;
-        }
-    }
-
-    if (maxTermsImpl != -1)
-        extractImplicant(table, nImpls, nTerms, maxTermsImpl);
-
-    return maxTermsImpl;
+    return getTermsVector(of->terms, true);
 }
 
-void QuineMcCluskey::extractImplicant(bool **table, int nImpls, int nTerms, int impl) const
+vector<Term> *QuineMcCluskey::getTermsVector(TermsContainer *tc, bool onlyExplicits) const
 {
-    for (int term = 0; term < nTerms; term++) {
-        if (table[impl][term]) {
-            for (int impl2 = 0; impl2 < nImpls; impl2++)
-                table[impl2][term] = false;
-        }
+    vector<Term> *pv = new vector<Term>;
+    for (TermsContainer::const_iterator it = tc->begin(); it != tc->end(); ++it) {
+        if (!onlyExplicits || !it->isDC())
+            pv->push_back(*it);
     }
+    return pv;
 }
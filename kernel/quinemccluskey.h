@@ -23,11 +23,12 @@
 
 #include "minimizingalgorithm.h"
 #include "quinemccluskeydata.h"
+#include "term.h"
+#include "termshash.h"
+#include "termsbatch.h"
 
 #include <vector>
-#include <list>
 
-class Term;
 class TermsContainer;
 
 class QuineMcCluskey : public MinimizingAlgorithm
@@ -40,27 +41,81 @@ public:
     Formula *minimize(Formula *f, bool dbg = false);
 
     // creates prime implicant
-    void findPrimeImplicants();
+    virtual void findPrimeImplicants();
     // makes covering
     void findFinalImplicants();
 
     QuineMcCluskeyData *getData() { return &data; }
 
-private:
-    bool doesNotHaveTerm(std::list<Term *> *v, Term *t);
+    // sets exact (minimum) covering instead of greedy one
+    inline void setExactCover(bool value) { exactCover = value; }
+    inline bool isExactCover() const { return exactCover; }
+    // sets maximal number of nodes of exact covering (greedy cover is kept
+    // if no smaller cover is found within the limit)
+    inline void setNodesLimit(unsigned long limit) { nodesLimit = limit; }
+    inline unsigned long getNodesLimit() const { return nodesLimit; }
 
-    // finds essential prime implicants
-    int extractEssentialImplicants(bool **table, int nImpls, int nTerms) const;
-    // finds implicant by largest covering
-    int extractLargestImplicants(bool **table, int nImpls, int nTerms) const;
-    // sets false value for all terms (remove term cell from table)
-    // which are implicated by implicant impl
-    void extractImplicant(bool **table, int nImpls, int nTerms, int impl) const;
+protected:
+    // maximal number of on-set minterms used as columns of covering table
+    // by the engines working with cubes (cubes of on-set are used for bigger functions)
+    static const unsigned MAX_COVER_MINTERMS = 1 << 16;
 
+    // minimization from cubes of f (minterms aren't expanded, no debug data)
+    Formula *minimizeCubes(Formula *f);
+    // returns terms which have to be covered (explicit minterms)
+    virtual std::vector<Term> *getCoverTerms() const;
     // duplicates vector with terms, but dont care terms are ignored
     std::vector<Term> *getTermsVector(TermsContainer *tc, bool onlyExplicits = false) const;
 
+private:
+    // minimal number of terms in the level for running it in parallel
+    static const unsigned PARALLEL_MIN = 64;
+    // right bucket with at most SCAN_FACTOR * varsCount terms is scanned
+    // by the batch kernel instead of looking up partners in its index
+    static const unsigned SCAN_FACTOR = 16;
+
+    // positions of combined terms in buckets (for debug data)
+    struct Combination
+    {
+        unsigned left;
+        unsigned right;
+        unsigned combined;
+    };
+
+    // storage of terms in the index of buckets (primes are generated only for
+    // functions with at most Formula::MAX_INDEX_VARS variables)
+    typedef TermStorage32 bucket_storage;
+    typedef bucket_storage::bits_t bucket_bits;
+
+    // terms with the same number of missings and explicits (terms aren't
+    // split by the missing mask, only terms with the same mask are combinable,
+    // but the mask is a part of the key of the index and it's compared first
+    // by the batch kernel, the order of insertion is kept for the primes)
+    struct Bucket
+    {
+        // terms in the order of insertion
+        TermsBatch terms;
+        // index of terms (liters and missing mask) to positions
+        BasicTermsHash<bucket_storage> index;
+        // whether the term was combined as left term
+        std::vector<char> leftUsed;
+        // whether the term was combined as right term
+        std::vector<char> rightUsed;
+        // new combinations (only with debug)
+        std::vector<Combination> combinations;
+    };
+
+    // task combining the buckets of one level
+    class LevelTask;
+    friend class LevelTask;
+
+    // combines terms from left and right buckets to out bucket
+    void combineBuckets(Bucket &left, Bucket &right, Bucket &out, unsigned vc, bool sop);
+
     QuineMcCluskeyData data;
+
+    bool exactCover;
+    unsigned long nodesLimit;
 };
 
 #endif // QUINEMCCLUSKEY_H
@@ -28,7 +28,7 @@
 using namespace std;
 
 QuineMcCluskeyData::QuineMcCluskeyData()
-    : varsCount(0), impls(0), implsSize(0) {}
+    : varsCount(0), impls(0), implsSize(0), essentialsCount(0) {}
 
 QuineMcCluskeyData::QuineMcCluskeyData(const QuineMcCluskeyData &qmd)
 {
@@ -62,6 +62,13 @@ void QuineMcCluskeyData::initCover(vector<Term> *row, vector<Term> *col)
     coverHeadRow = *row;
     coverHeadCol = *col;
     coverTable.clear();
+    essentialsCount = 0;
+    blocks.clear();
+}
+
+void QuineMcCluskeyData::addBlock(int rows, int cols)
+{
+    blocks.push_back(Block(rows, cols));
 }
 
 void QuineMcCluskeyData::addImpl(int missings, int explicits, Term *t)
@@ -40,6 +40,14 @@ public:
         Term combined;
     };
 
+    // independent block of covering table
+    struct Block
+    {
+        Block(int r, int c) : rows(r), cols(c) {}
+        int rows;
+        int cols;
+    };
+
     QuineMcCluskeyData();
     QuineMcCluskeyData(const QuineMcCluskeyData &qmd);
     ~QuineMcCluskeyData();
@@ -67,6 +75,12 @@ public:
     std::vector<Term> *getCoverHeadRow() { return &coverHeadRow; }
     std::vector<Term> *getCoverHeadCol() { return &coverHeadCol; }
 
+    // essential implicants are selected before splitting to blocks
+    void setEssentialsCount(int count) { essentialsCount = count; }
+    int getEssentialsCount() { return essentialsCount; }
+    void addBlock(int rows, int cols);
+    std::vector<Block> *getBlocks() { return &blocks; }
+
 private:
     inline int getImplsIdx(int missings, int explicits);
     inline int getCoverIdx(int row, int col);
@@ -83,6 +97,8 @@ private:
     std::vector<Term> coverHeadCol;
     std::set<int> coverTable;
     std::list<Combination> combinations;
+    int essentialsCount;
+    std::vector<Block> blocks;
 };
 
 #endif // QUINEMCCLUSKEYDATA_H
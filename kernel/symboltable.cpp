@@ -0,0 +1,104 @@
+/*
+ * symboltable.cpp - table of interned names of variables and functions
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "symboltable.h"
+
+#include <string>
+#include <deque>
+#include <map>
+#include <cctype>
+
+using namespace std;
+
+// preinicialize static instance
+SymbolTable *SymbolTable::s_instance = 0;
+// lock of the instance creation
+static Mutex instanceMutex;
+
+// return instance of SymbolTable class
+SymbolTable *SymbolTable::instance()
+{
+    MutexLocker locker(instanceMutex);
+    if (s_instance == 0)
+        s_instance = new SymbolTable();
+
+    return s_instance;
+}
+
+// deletes symbol table instance
+void SymbolTable::destroy()
+{
+    MutexLocker locker(instanceMutex);
+    delete s_instance;
+    s_instance = 0;
+}
+
+// name has to start with letter and it can contain letters, digits,
+// underscores and brackets (for PLA names like x[3] or y<1>)
+bool SymbolTable::isValidName(const string &str)
+{
+    // ctype functions are defined only for unsigned char values
+    if (str.empty() || !isalpha(static_cast<unsigned char>(str[0])))
+        return false;
+
+    for (unsigned i = 1; i < str.size(); i++) {
+        unsigned char c = str[i];
+        if (!isalnum(c) && c != '_' && c != '.' && c != '[' && c != ']'
+                && c != '<' && c != '>')
+            return false;
+    }
+    return true;
+}
+
+// returns id of the name (the name is added if it isn't in the table)
+int SymbolTable::intern(const string &name)
+{
+    MutexLocker locker(mutex);
+    map<string, int>::const_iterator it = ids.find(name);
+    if (it != ids.end())
+        return it->second;
+
+    int id = names.size();
+    names.push_back(name);
+    ids[name] = id;
+    return id;
+}
+
+// returns id of the name or -1 if the name isn't in the table
+int SymbolTable::find(const string &name) const
+{
+    MutexLocker locker(mutex);
+    map<string, int>::const_iterator it = ids.find(name);
+    return (it == ids.end())? -1: it->second;
+}
+
+// returns name of the symbol with id
+const string &SymbolTable::getName(int id) const
+{
+    MutexLocker locker(mutex);
+    return names[id];
+}
+
+// returns the number of symbols
+unsigned SymbolTable::getSize() const
+{
+    MutexLocker locker(mutex);
+    return names.size();
+}
@@ -0,0 +1,69 @@
+/*
+ * symboltable.h - table of interned names of variables and functions
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include "threadpool.h"
+
+#include <string>
+#include <deque>
+#include <map>
+
+// symbol table - every name is stored only once and identified by its id,
+// names are never moved, so the returned references stay valid (the table
+// is locked, because it can be used by more threads)
+class SymbolTable
+{
+public:
+    // returns instance of the SymbolTable class - singleton pattern
+    static SymbolTable *instance();
+    // deletes symbol table instance (only at program exit, ids of names
+    // in all formulas become invalid)
+    static void destroy();
+
+    // whether str can be used as a name of variable or function
+    static bool isValidName(const std::string &str);
+
+    // returns id of the name (the name is added if it isn't in the table)
+    int intern(const std::string &name);
+    // returns id of the name or -1 if the name isn't in the table
+    int find(const std::string &name) const;
+    // returns name of the symbol with id
+    const std::string &getName(int id) const;
+    // returns the number of symbols
+    unsigned getSize() const;
+
+private:
+    // private default constructor - singleton
+    SymbolTable() {}
+
+    // static instance
+    static SymbolTable *s_instance;
+
+    // names indexed by id (deque doesn't move names when it grows)
+    std::deque<std::string> names;
+    // ids indexed by names
+    std::map<std::string, int> ids;
+    // lock of names and ids
+    mutable Mutex mutex;
+};
+
+#endif // SYMBOLTABLE_H
@@ -31,17 +31,15 @@
 using namespace std;
 
 
-term_t Term::getFullLiters(unsigned size)
+template <typename S>
+typename BasicTerm<S>::bits_t BasicTerm<S>::getFullLiters(unsigned size)
 {
-    term_t full = 0, pos = 1;
-    for (unsigned i = 0; i < size; i++, pos <<= 1) {
-        full |= pos;
-    }
-    return full;
+    return bits_t::full(size);
 }
 
 // term initialization
-void Term::init(term_t lit, term_t mis, unsigned s, int flg)
+template <typename S>
+void BasicTerm<S>::init(const bits_t &lit, const bits_t &mis, unsigned s, int flg)
 {
     liters = lit;
     missing = mis;
@@ -50,7 +48,8 @@ void Term::init(term_t lit, term_t mis, unsigned s, int flg)
 }
 
 // default constructor - the term of size s with all variables set on missing value
-Term::Term(unsigned s, bool isDC)
+template <typename S>
+BasicTerm<S>::BasicTerm(unsigned s, bool isDC)
 {
     int flag = ONE;
     if (isDC)
@@ -61,40 +60,44 @@ Term::Term(unsigned s, bool isDC)
 
 
 // constructor - makes the variables array of the size s by the index idx (index of the boolean function)
-Term::Term(int idx, unsigned s, bool isDC)
+template <typename S>
+BasicTerm<S>::BasicTerm(int idx, unsigned s, bool isDC)
 {
     if (idx == MISSING_ALL)
-        init(0, (1 << s) - 1, s, 0);
+        init(0, getFullLiters(s), s, 0);
     else {
         int flag = ONE;
         if (isDC)
             flag = DC;
 
-        init(idx, 0, s, flag);
+        init(uint64_t(idx), 0, s, flag);
     }
 }
 
 // constructor - for the internal usage
-Term::Term(term_t lit, term_t miss, unsigned s, int flg)
+template <typename S>
+BasicTerm<S>::BasicTerm(const bits_t &lit, const bits_t &miss, unsigned s, int flg)
 {
     init(lit, miss, s, flg);
 }
 
 // constructor - parsed from the string str
-Term::Term(const std::string &str, unsigned s) throw(InvalidTermExc)
+template <typename S>
+BasicTerm<S>::BasicTerm(const std::string &str, unsigned s) throw(InvalidTermExc)
 {
     if (s && str.size() != s)
         throw InvalidTermExc(str.size(), s);
+    if (str.size() > MAX_SIZE)
+        throw InvalidTermExc(str.size(), MAX_SIZE);
 
     liters = missing = 0;
-    term_t pos = 1;
     try {
-        for (unsigned i = str.size(); i > 0; i--, pos <<= 1) {
+        for (unsigned i = str.size(), pos = 0; i > 0; i--, pos++) {
             LiteralValue val(str[i-1]);
             if (val.isMissing())
-                missing |= pos;
+                missing.set(pos);
             else if (val.isOne())
-                liters |= pos;
+                liters.set(pos);
         }
     }
     catch (InvalidValueExc &exc) {
@@ -105,7 +108,8 @@ Term::Term(const std::string &str, unsigned s) throw(InvalidTermExc)
 }
 
 // sets certain flag
-void Term::setFlag(int flag, bool is)
+template <typename S>
+void BasicTerm<S>::setFlag(int flag, bool is)
 {
     if (is)
         flags |= flag;
@@ -114,33 +118,28 @@ void Term::setFlag(int flag, bool is)
 }
 
 // returns the count of values in term
-int Term::valuesCount(int value, term_t varMask) const
+template <typename S>
+int BasicTerm<S>::valuesCount(int value, const bits_t &varMask) const
 {
-    term_t mask, pos;
-    unsigned i;
+    bits_t mask;
 
     switch (value) {
     case LiteralValue::ONE:
-        mask = liters;
+        mask = liters & ~missing;
         break;
     case LiteralValue::ZERO:
-        mask = ~liters; // bits invertion - finding zeros
+        mask = ~liters & ~missing; // bits invertion - finding zeros
         break;
     default:
         mask = missing;
     }
 
-    int count = 0;
-    varMask = ~varMask;
-    for(i = 0, pos = 1; i < size; i++, pos <<= 1) {
-         if (pos & mask & varMask)
-             count++;
-     }
-
-    return count;
+    return (mask & ~varMask & getFullLiters(size)).count();
 }
 
-inline int valuesCount(const LiteralValue & value, term_t varMask)
+// returns the count of values in term
+template <typename S>
+int BasicTerm<S>::valuesCount(const LiteralValue & value, const bits_t &varMask) const
 {
     return valuesCount(value.getValue(), varMask);
 }
@@ -148,254 +147,215 @@ inline int valuesCount(const LiteralValue & value, term_t varMask)
 // returns the new term combined (only for difference of one varible)
 // with *this and t, for example 0010 & 0000 => 00X0
 // note that it's expected that term size are the same
-Term *Term::combine(const Term & t) const
+template <typename S>
+BasicTerm<S> *BasicTerm<S>::combine(const BasicTerm & t) const
 {
-    term_t diff_mask, pos;
-    unsigned i;
-    bool isOne = false;
-
-    if (missing != t.missing)
-        return 0;
-
-    diff_mask = (t.liters ^ liters) & ~missing; // difference mask
-
-    if (!diff_mask) // no difference
+    if (!isCombinable(t))
         return 0;
 
-    for (i = 0, pos = 1; i < size; i++, pos <<= 1) {
-        if (pos & diff_mask) {
-            if (isOne)
-                return 0;
-            else
-                isOne = true;
-        }
-    }
+    bits_t diffMask = (t.liters ^ liters) & ~missing; // difference mask
 
     // if it's possible to combine the terms, return new Term
-    return new Term(liters, diff_mask | missing, size, isDC());
+    return new BasicTerm(liters & ~diffMask, diffMask | missing, size, isDC());
 }
 
 // returns true if term t can be combined with this term, otherwise returns false
-bool Term::isCombinable(const Term & t) const
+template <typename S>
+bool BasicTerm<S>::isCombinable(const BasicTerm & t) const
 {
-    term_t diff_mask, pos;
-    unsigned i;
-    bool isOne = false;
-
     if (missing != t.missing)
         return false;
 
-    diff_mask = (t.liters ^ liters) & ~missing; // difference mask
-
-    if (!diff_mask) // no difference
-        return false;
-
-    for (i = 0, pos = 1; i < size; i++, pos <<= 1) {
-        if (pos & diff_mask) {
-            if (isOne)
-                return false;
-            else
-                isOne = true;
-        }
-    }
-    return true;
-}
-
-// replace first missing value by zero and one
-Term *Term::expandMissingValue() const
-{
-    if (!missing) // no missing value
-        return 0;
-
-    term_t pos = 1;
-    for (unsigned i = 0; i < size; i++, pos <<= 1) {
-        if (missing & pos) {
-            term_t newMissing = missing & ~pos;
-            Term *t = new Term[2];
-            t[0] = Term(liters | pos, newMissing, size, isDC());  // 1
-            t[1] = Term(liters & ~pos, newMissing, size, isDC()); // 0
-            return t;
-        }
-    }
-    return 0;
+    // exactly one difference
+    return ((t.liters ^ liters) & ~missing & getFullLiters(size)).count() == 1;
 }
 
 // returns true if this term implies term t
-bool Term::implies(Term & t) const
+template <typename S>
+bool BasicTerm<S>::implies(const BasicTerm & t) const
 {
-    return !((t.liters ^ liters) & ~missing);
+    return ((t.liters ^ liters) & ~missing & getFullLiters(size)).none();
 }
 
 // returns size of term, if the all is false returns size reduced of dont cares
-unsigned Term::getSize(bool all) const
+template <typename S>
+unsigned BasicTerm<S>::getSize(bool all) const
 {
     return all? size: size - valuesCount(LiteralValue::MISSING);
 }
 
 // returns index of the boolean function for the term
-int Term::getIdx() const
+template <typename S>
+int BasicTerm<S>::getIdx() const
 {
-    return missing? -1: int(liters);
+    return (missing & getFullLiters(size)).any()? -1: int(liters.low());
 }
 
 // ESPRESSO FEATURES
 // makes row of blocking matrix
-void Term::makeBB(const Term &cube)
+template <typename S>
+void BasicTerm<S>::makeBB(const BasicTerm &cube)
 {
     liters = ~(cube.missing | missing) & (liters ^ cube.liters);
     missing = 0;
 }
 
 // makes row of covering matrix
-void Term::makeCC(const Term &cube)
+template <typename S>
+void BasicTerm<S>::makeCC(const BasicTerm &cube)
 {
     liters = ~cube.missing & (missing | (liters ^ cube.liters));
     missing = 0;
 }
 
 // lower *this term
-void Term::lower(term_t loweringSet)
+template <typename S>
+void BasicTerm<S>::lower(const bits_t &loweringSet)
 {
-    term_t full = getFullLiters(size);
+    bits_t full = getFullLiters(size);
     missing = full & (missing | ~loweringSet);
     liters &= loweringSet;
 }
 
 // returns position of first one in liters
-term_t Term::getFirstOnePos(term_t colMask) const
+template <typename S>
+typename BasicTerm<S>::bits_t BasicTerm<S>::getFirstOnePos(const bits_t &colMask) const
 {
-    term_t pos = 1;
-    term_t maskedLiters = liters & ~colMask;
-    for (unsigned i = 0; i < size; i++, pos <<= 1) {
-        if (maskedLiters & pos)
-            return pos;
-    }
-    return 0;
+    int first = (liters & ~colMask & getFullLiters(size)).first();
+    return (first < 0)? bits_t(): bits_t::bit(first);
 }
 
 // returns cofactor with respect to term t, if it isn't exist disable ONE flag
-Term Term::cofactor(const Term &p, term_t full) const
+template <typename S>
+BasicTerm<S> BasicTerm<S>::cofactor(const BasicTerm &p, bits_t full) const
 {
-    if ((liters ^ p.liters) & ~(p.missing | missing)) {
-        Term tmp(size);
+    if (((liters ^ p.liters) & ~(p.missing | missing)).any()) {
+        BasicTerm tmp(size);
         tmp.setInvalid(true);
         return tmp;
     }
     else {
-        if (!full)
+        if (full.none())
             full = getFullLiters(size);
-        return Term(liters & p.missing, (~p.missing | missing) & full, size);
+        return BasicTerm(liters & p.missing, (~p.missing | missing) & full, size);
     }
 }
 
 // returns cofactor with respect to var at pos with val, if it isn't exist disable ONE flag
-Term Term::cofactor(unsigned pos, bool val, term_t full) const
+template <typename S>
+BasicTerm<S> BasicTerm<S>::cofactor(unsigned pos, bool val, const bits_t &full) const
 {
-    term_t termPos = 1 << pos;
-    return cofactor(Term(val? termPos: 0, full & ~termPos, size), full);
+    bits_t termPos = bits_t::bit(pos);
+    return cofactor(BasicTerm(val? termPos: bits_t(), full & ~termPos, size), full);
 }
 
 // special merge for reduce procedure - this term is non(t) and t is t
-Term Term::reduceMerge(unsigned pos, const Term &t) const
+template <typename S>
+BasicTerm<S> BasicTerm<S>::reduceMerge(unsigned pos, const BasicTerm &t) const
 {
+    bits_t termPos = bits_t::bit(pos);
     if (isInvalid())
-        return Term(t.liters | (1 << pos), t.missing  & ~(1 << pos), size);
+        return BasicTerm(t.liters | termPos, t.missing  & ~termPos, size);
     else if (t.isInvalid())
-        return Term(liters & ~(1 << pos), missing  & ~(1 << pos), size);
+        return BasicTerm(liters & ~termPos, missing  & ~termPos, size);
     else {
-        term_t newMissing = (missing | t.missing) | (t.liters ^ liters) | (1 << pos);
-        return Term(liters & ~newMissing, newMissing, size);
+        bits_t newMissing = (missing | t.missing) | (t.liters ^ liters) | termPos;
+        return BasicTerm(liters & ~newMissing, newMissing, size);
     }
 }
 
+// returns true if *this cube contains cube t
+template <typename S>
+bool BasicTerm<S>::contains(const BasicTerm &t) const
+{
+    bits_t bound = ~missing & getFullLiters(size);
+    return (bound & t.missing).none() && ((liters ^ t.liters) & bound).none();
+}
+
 // eqaulity operator
-bool Term::operator==(const Term & t) const
+template <typename S>
+bool BasicTerm<S>::operator==(const BasicTerm & t) const
 {
-    return t.missing == missing && !((t.liters ^ liters) & ~missing);
+    return t.missing == missing && ((t.liters ^ liters) & ~missing).none();
 }
 
 // noneqaulity operator
-bool Term::operator!=(const Term & t) const
+template <typename S>
+bool BasicTerm<S>::operator!=(const BasicTerm & t) const
 {
     return !operator==(t);
 }
 
 // less operator
-bool Term::operator<(const Term & t) const
-{
-    if (missing) {
-        vector<Term> v1, v2;
-        expandTerm(v1, *this);
-        expandTerm(v2, t);
-        sort(v1.begin(), v1.end());
-        sort(v2.begin(), v2.end());
-        unsigned min = (v1.size() < v2.size())? v1.size(): v2.size();
-        for (unsigned i = 0; i < min; i++) {
-            if (v1[i] != v2[i])
-                return v1[i].getIdx() < v2[i].getIdx();
+template <typename S>
+bool BasicTerm<S>::operator<(const BasicTerm & t) const
+{
+    if (missing.any()) {
+        // minterms are enumerated in increasing order
+        minterm_iterator it1 = mintermsBegin(), it2 = t.mintermsBegin(), end;
+        for (; it1 != end && it2 != end; ++it1, ++it2) {
+            if (it1.idx() != it2.idx())
+                return it1.idx() < it2.idx();
         }
         // the same
-        return v1.size() < v2.size();
+        return it1 == end && it2 != end;
     }
     else
         return getIdx() < t.getIdx();
 }
 
 // greater operator
-bool Term::operator>(const Term & t) const
+template <typename S>
+bool BasicTerm<S>::operator>(const BasicTerm & t) const
 {
     return operator!=(t) && !operator<(t);
 }
 
 // inversion
-Term Term::operator~() const
+template <typename S>
+BasicTerm<S> BasicTerm<S>::operator~() const
 {
-    return Term(~liters & ~missing & getFullLiters(size), missing, size, flags);
+    return BasicTerm(~liters & ~missing & getFullLiters(size), missing, size, flags);
 }
 
 // intersection
-Term Term::operator&(const Term &t) const
+template <typename S>
+BasicTerm<S> BasicTerm<S>::operator&(const BasicTerm &t) const
 {
-    term_t l1 = liters & ~missing;
-    term_t l2 = t.liters & ~t.missing;
+    bits_t l1 = liters & ~missing;
+    bits_t l2 = t.liters & ~t.missing;
 
     int flag = ONE;
-    if ((l1 ^ l2) & ~(missing | t.missing))
+    if (((l1 ^ l2) & ~(missing | t.missing)).any())
         flag = INVALID;
 
-    return Term(l1 | l2, missing & t.missing, size, flag);
+    return BasicTerm(l1 | l2, missing & t.missing, size, flag);
 }
 
 // delta distance - number of mismatches
-int Term::distance(const Term &t) const
-{
-    term_t missingMask = ~(missing | t.missing);
-    term_t l1 = liters & missingMask;
-    term_t l2 = t.liters & missingMask;
-    term_t pos = 1;
-    int count = 0;
-    for (unsigned i = 0; i < size; i++, pos <<= 1) {
-        if ((l1 & pos) ^ (l2 & pos))
-            count++;
-    }
-    return count;
+template <typename S>
+int BasicTerm<S>::distance(const BasicTerm &t) const
+{
+    bits_t missingMask = ~(missing | t.missing) & getFullLiters(size);
+    return ((liters ^ t.liters) & missingMask).count();
 }
 
 
 // index operator
-LiteralValue Term::operator[](int position) const
+template <typename S>
+LiteralValue BasicTerm<S>::operator[](int position) const
 {
-    term_t pos = 1 << position;
-    if (missing & pos)
+    if (missing.test(position))
         return LiteralValue(LiteralValue::MISSING);
-    else if (liters & pos)
+    else if (liters.test(position))
         return LiteralValue(LiteralValue::ONE);
     else
         return LiteralValue(LiteralValue::ZERO);
 }
 
 // get literal value at position
-LiteralValue Term::at(unsigned position) const throw(InvalidPositionExc)
+template <typename S>
+LiteralValue BasicTerm<S>::at(unsigned position) const throw(InvalidPositionExc)
 {
     if (position >= size)
         throw InvalidPositionExc(position);
@@ -404,56 +364,43 @@ LiteralValue Term::at(unsigned position) const throw(InvalidPositionExc)
 }
 
 // get int value at position
-int Term::getValueAt(unsigned position) const
+template <typename S>
+int BasicTerm<S>::getValueAt(unsigned position) const
 {
-    term_t pos = 1 << position;
-    if (missing & pos)
+    if (missing.test(position))
         return 2;
-    else if (liters & pos)
+    else if (liters.test(position))
         return 1;
     else
         return 0;
 }
 
-/*// set literal value at position
-inline void Term::setValueAt(unsigned position, int value)
-{
-    setValueAt(position, LiteralValue(value));
-}*/
-
 // set literal value at position
-void Term::setValueAt(unsigned position, const LiteralValue &value)
+template <typename S>
+void BasicTerm<S>::setValueAt(unsigned position, const LiteralValue &value)
 {
-    term_t pos = 1 << position;
     if (value.isMissing()) {
-        missing |= pos;
-        liters &= ~pos;
+        missing.set(position);
+        liters.set(position, false);
     }
     else {
-        missing &= ~pos;
-        if (value.isOne())
-            liters |= pos;
-        else
-            liters &= ~pos;
+        missing.set(position, false);
+        liters.set(position, value.isOne());
     }
 }
 
 // term to string
-string Term::toString(StringForm sf, bool showPrime) const
+template <typename S>
+string BasicTerm<S>::toString(StringForm sf, bool showPrime) const
 {
     if (sf == SF_SET) {
         char type = isOne()? 'm': 'M';
         ostringstream oss;
-        if (missing) {
+        if (missing.any()) {
             oss << type << "(";
-            vector<Term> v;
-            Term::expandTerm(v, *this);
-            sort(v.begin(), v.end());
-            for (unsigned i = 0; i < v.size(); i++) {
-                if (i != 0)
-                    oss << ",";
-                oss << v[i].getIdx();
-            }
+            const char *sep = "";
+            for (minterm_iterator it = mintermsBegin(); it != mintermsEnd(); ++it, sep = ",")
+                oss << sep << it.idx();
             oss << ")";
         }
         else
@@ -471,59 +418,46 @@ string Term::toString(StringForm sf, bool showPrime) const
     }
 }
 
-// friend function to place term to ostream
-ostream & operator<<(ostream & os, const Term & term)
+// function to place term to ostream
+template <typename S>
+ostream & operator<<(ostream & os, const BasicTerm<S> & term)
 {
     return os << term.toString();
 }
 
 // expands term t to all minterms and save their indexes to v
-void Term::expandTerm(std::vector<int> &v, const Term &t)
+template <typename S>
+void BasicTerm<S>::expandTerm(std::vector<int> &v, const BasicTerm &t)
 {
-    Term *pt;
-
-    if (t.valuesCount(LiteralValue::MISSING) == 0)
-        v.push_back(t.getIdx());
-    else {
-        pt = t.expandMissingValue();
-        if (pt) {
-            expandTerm(v, pt[0]);
-            expandTerm(v, pt[1]);
-            delete [] pt;
-        }
-    }
+    for (minterm_iterator it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+        v.push_back(it.idx());
 }
 
 // expands term t to all minterms and saves minterms (maxterms) to vector v
-void Term::expandTerm(vector<Term> &v, const Term &t)
+template <typename S>
+void BasicTerm<S>::expandTerm(vector<BasicTerm> &v, const BasicTerm &t)
 {
-    Term *pt;
-
-    if (t.valuesCount(LiteralValue::MISSING) == 0)
-        v.push_back(t);
-    else {
-        pt = t.expandMissingValue();
-        if (pt) {
-            expandTerm(v, pt[0]);
-            expandTerm(v, pt[1]);
-            delete [] pt;
-        }
-    }
+    for (minterm_iterator it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+        v.push_back(*it);
 }
 
 // expands term t to all minterms and saves minterms (maxterms) to list l
-void Term::expandTerm(list<Term> &l, const Term &t)
+template <typename S>
+void BasicTerm<S>::expandTerm(list<BasicTerm> &l, const BasicTerm &t)
 {
-    Term *pt;
-
-    if (t.valuesCount(LiteralValue::MISSING) == 0)
-        l.push_back(t);
-    else {
-        pt = t.expandMissingValue();
-        if (pt) {
-            expandTerm(l, pt[0]);
-            expandTerm(l, pt[1]);
-            delete [] pt;
-        }
-    }
+    for (minterm_iterator it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+        l.push_back(*it);
 }
+
+// instances for all storages
+template class BasicTerm<TermStorage16>;
+template class BasicTerm<TermStorage32>;
+template class BasicTerm<TermStorage64>;
+template class BasicTerm<TermStorage128>;
+template class BasicTerm<TermStorage256>;
+
+template ostream &operator<<(ostream &os, const BasicTerm<TermStorage16> &term);
+template ostream &operator<<(ostream &os, const BasicTerm<TermStorage32> &term);
+template ostream &operator<<(ostream &os, const BasicTerm<TermStorage64> &term);
+template ostream &operator<<(ostream &os, const BasicTerm<TermStorage128> &term);
+template ostream &operator<<(ostream &os, const BasicTerm<TermStorage256> &term);
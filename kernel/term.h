@@ -22,27 +22,34 @@
 #define TERM_H
 
 #include "kernelexc.h"
+#include "termstorage.h"
 
 #include <iostream>
 #include <vector>
 #include <list>
 #include <string>
+#include <iterator>
+#include <cstddef>
 #include <limits.h>
 
-// term mask
-typedef int term_t;
-
-// maximum number of literals (-1 means sign in int)
-#define TERM_MAX_SIZE (sizeof (term_t) * 8 - 1)
-
 class LiteralValue;
 class InvalidPositionExc;
 
-// Class represented product term
-class Term
+template <typename S> class BasicMintermIterator;
+
+// Class represented product term, literals are saved in the storage S
+template <typename S>
+class BasicTerm
 {
 public:
+    // storage policy
+    typedef S storage_type;
+    // literals mask
+    typedef typename S::bits_t bits_t;
+
     static const int MISSING_ALL = -1;
+    // maximum number of literals
+    static const unsigned MAX_SIZE = S::MAX_SIZE;
     // flags
     static const int ONE      = 0x001; // term is one
     static const int DC       = 0x002; // term is dont care term
@@ -58,22 +65,30 @@ public:
     enum StringForm { SF_BIN, SF_SET };
 
     // returns full position
-    static term_t getFullLiters(unsigned size);
+    static bits_t getFullLiters(unsigned size);
 
     // constructor - the term of size s with all variables set on missing value
-    Term(unsigned s = 0, bool isDC = false);
+    BasicTerm(unsigned s = 0, bool isDC = false);
     // constructor - makes the variables array of the size s by the index idx
-    Term(int idx, unsigned s, bool isDC = false);
+    BasicTerm(int idx, unsigned s, bool isDC = false);
     // constructor - for the internal usage
-    Term(term_t lit, term_t miss, unsigned s, int flg = ONE);
+    BasicTerm(const bits_t &lit, const bits_t &miss, unsigned s, int flg = ONE);
     // constructor - parsed from the string str
-    Term(const std::string &str, unsigned s = 0) throw(InvalidTermExc);
+    BasicTerm(const std::string &str, unsigned s = 0) throw(InvalidTermExc);
+    // constructor - conversion from the term with another storage
+    template <typename S2>
+    explicit BasicTerm(const BasicTerm<S2> &t)
+    {
+        init(bits_t(t.liters), bits_t(t.missing), t.size, t.flags);
+    }
 
     // FLAGS methods
     // sets certain flag
     void setFlag(int flag, bool is = true);
     // finds out if the flag flg is set
     inline bool hasFlags(int flg) const { return (flags & flg); }
+    // returns all flags
+    inline int getFlags() const { return flags; }
 
     inline bool isOne() const { return hasFlags(ONE); }
     inline void setOne(bool is = true) { setFlag(ONE, is); }
@@ -100,77 +115,164 @@ public:
     // returns index of the boolean function for the term
     int getIdx() const;
     // returns liters
-    term_t getLiters() { return liters; }
+    const bits_t &getLiters() const { return liters; }
     // returns missings
-    term_t getMissing() { return missing; }
+    const bits_t &getMissing() const { return missing; }
+    // lazy iterating over minterms (maxterms) of the term in increasing order
+    typedef BasicMintermIterator<S> minterm_iterator;
+    inline minterm_iterator mintermsBegin() const { return minterm_iterator(*this); }
+    inline minterm_iterator mintermsEnd() const { return minterm_iterator(); }
+
     // returns the count of values in term
-    int valuesCount(int value, term_t varMask = 0) const;
-    inline int valuesCount(const LiteralValue & value, term_t varMask = 0) const;
+    int valuesCount(int value, const bits_t &varMask = bits_t()) const;
+    int valuesCount(const LiteralValue & value, const bits_t &varMask = bits_t()) const;
     // returns the new term combined (only by difference of one varible)
     // with *this and t, for example 0010 & 0000 => 00X0
-    Term *combine(const Term & t) const;
+    BasicTerm *combine(const BasicTerm & t) const;
     // returns true if term t can be combined with this term, otherwise returns false
-    bool isCombinable(const Term & t) const;
-    // replace first dont care by zero and one
-    Term *expandMissingValue() const;
+    bool isCombinable(const BasicTerm & t) const;
     // returns true if *this term implies term t
-    bool implies(Term & t) const;
+    bool implies(const BasicTerm & t) const;
 
     // ESPRESSO FEATURES
     // makes row of blocking matrix
-    void makeBB(const Term &cube);
+    void makeBB(const BasicTerm &cube);
     // make srow of covering matrix
-    void makeCC(const Term &cube);
+    void makeCC(const BasicTerm &cube);
     // lower *this term
-    void lower(term_t loweringSet);
+    void lower(const bits_t &loweringSet);
     // returns position of first one in liters
-    term_t getFirstOnePos(term_t colMask = 0) const;
+    bits_t getFirstOnePos(const bits_t &colMask = bits_t()) const;
     // returns cofactor with respect to term t, if it isn't exist disable ONE flag
-    Term cofactor(const Term &t, term_t full = 0) const;
+    BasicTerm cofactor(const BasicTerm &t, bits_t full = bits_t()) const;
     // returns cofactor with respect to var at pos with val, if it isn't exist disable ONE flag
-    Term cofactor(unsigned pos, bool val, term_t full = 0) const;
+    BasicTerm cofactor(unsigned pos, bool val, const bits_t &full = bits_t()) const;
     // special merge for reduce procedure
-    Term reduceMerge(unsigned pos, const Term &t) const;
+    BasicTerm reduceMerge(unsigned pos, const BasicTerm &t) const;
+    // returns true if *this cube contains cube t
+    bool contains(const BasicTerm &t) const;
 
     // eqaulity operators
-    bool operator==(const Term &t) const;
-    bool operator!=(const Term &t) const;
-    bool operator<(const Term &t) const;
-    bool operator>(const Term &t) const;
+    bool operator==(const BasicTerm &t) const;
+    bool operator!=(const BasicTerm &t) const;
+    bool operator<(const BasicTerm &t) const;
+    bool operator>(const BasicTerm &t) const;
     // intersection
-    Term operator&(const Term &t) const;
+    BasicTerm operator&(const BasicTerm &t) const;
     // inversion
-    Term operator~() const;
+    BasicTerm operator~() const;
 
     // delta distance - number of mismatches
-    int distance(const Term &t) const;
+    int distance(const BasicTerm &t) const;
 
     // index operator
     LiteralValue operator[](int position) const;
     LiteralValue at(unsigned position) const throw(InvalidPositionExc);
     int getValueAt(unsigned position) const;
     void setValueAt(unsigned position, const LiteralValue &value);
-    
+
     // term to string
     std::string toString(StringForm sf = SF_BIN, bool showPrime = true) const;
-    // friend function to place term to ostream
-    friend std::ostream & operator<<(std::ostream & os, const Term & t);
 
     // expands term t to all minterms and saves their indexes to vector v
-    static void expandTerm(std::vector<int> &v, const Term &t);
+    static void expandTerm(std::vector<int> &v, const BasicTerm &t);
     // expands term t to all minterms and saves minterms (maxterms) to vector v
-    static void expandTerm(std::vector<Term> &v, const Term &t);
+    static void expandTerm(std::vector<BasicTerm> &v, const BasicTerm &t);
     // expands term t to all minterms and saves minterms (maxterms) to list l
-    static void expandTerm(std::list<Term> &l, const Term &t);
+    static void expandTerm(std::list<BasicTerm> &l, const BasicTerm &t);
 
 protected:
     // term initialization
-    void init(term_t lit, term_t mis, unsigned s, int flg);
+    void init(const bits_t &lit, const bits_t &mis, unsigned s, int flg);
+
+    bits_t liters;                   // literals value
+    bits_t missing;                  // which literals are missing literals
+    typename S::size_type size;      // number of literals
+    typename S::flags_type flags;    // flags
+
+    template <typename S2> friend class BasicTerm;
+};
+
+// function to place term to ostream
+template <typename S>
+std::ostream & operator<<(std::ostream & os, const BasicTerm<S> & t);
 
-    term_t liters;     // literals value
-    term_t missing;    // which literals are missing literals
-    unsigned size;		   // number of literals
-    int flags;		   // flags
+// forward iterator over minterms (maxterms) of the term - missing positions
+// are enumerated as subsets of the missing mask by x = (x - missing) & missing
+// (without allocation), minterms keep flags of the term
+template <typename S>
+class BasicMintermIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef BasicTerm<S> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const BasicTerm<S> *pointer;
+    typedef const BasicTerm<S> &reference;
+    typedef typename S::bits_t bits_t;
+
+    // end iterator
+    BasicMintermIterator() : atEnd(true) {}
+    // iterator at the first minterm of term t
+    explicit BasicMintermIterator(const BasicTerm<S> &t)
+            : mask(t.getMissing() & BasicTerm<S>::getFullLiters(t.getSize())),
+              fixed(t.getLiters() & ~mask), atEnd(false)
+    {
+        current = BasicTerm<S>(fixed, bits_t(), t.getSize(), t.getFlags());
+    }
+
+    inline reference operator*() const { return current; }
+    inline pointer operator->() const { return &current; }
+    // returns index of the actual minterm
+    inline int idx() const { return int(current.getLiters().low()); }
+
+    BasicMintermIterator &operator++()
+    {
+        // sub = (sub - mask) & mask, i.e. increment of the bits in mask
+        bits_t sub = current.getLiters() & mask;
+        uint64_t carry = 1;
+        for (unsigned i = 0; i < sub.words64() && carry; i++) {
+            uint64_t m = mask.getWord64(i);
+            uint64_t w = (sub.getWord64(i) | ~m) + carry;
+            carry = (w == 0)? 1: 0;
+            sub.setWord64(i, w & m);
+        }
+        if (carry)
+            atEnd = true;
+        else
+            current = BasicTerm<S>(fixed | sub, bits_t(), current.getSize(), current.getFlags());
+        return *this;
+    }
+    inline BasicMintermIterator operator++(int)
+    {
+        BasicMintermIterator it(*this);
+        operator++();
+        return it;
+    }
+
+    inline bool operator==(const BasicMintermIterator &it) const
+    {
+        if (atEnd || it.atEnd)
+            return atEnd == it.atEnd;
+        return current.getLiters() == it.current.getLiters() && mask == it.mask;
+    }
+    inline bool operator!=(const BasicMintermIterator &it) const { return !operator==(it); }
+
+private:
+    bits_t mask;
+    bits_t fixed;
+    BasicTerm<S> current;
+    bool atEnd;
 };
 
+// term used for passing terms of functions (the widest storage), terms are
+// saved in the narrowest storage by the number of variables (TermsContainer)
+typedef BasicTerm<TermStorage256> Term;
+
+// term mask
+typedef Term::bits_t term_t;
+
+// maximum number of literals
+#define TERM_MAX_SIZE (Term::MAX_SIZE)
+
 #endif /* TERM_H */
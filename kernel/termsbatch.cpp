@@ -0,0 +1,254 @@
+/*
+ * termsbatch.cpp - terms saved by words for batched combining
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "termsbatch.h"
+
+#include <vector>
+#include <stdint.h>
+
+// SIMD kernel is compiled for x86 with runtime CPU dispatch
+#if !defined(BMIN_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+        && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define TERMSBATCH_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// appends positions of rows from start to n (words of rows are in lit and mis)
+// which have missings m and exactly one different liter from l
+static void findScalar(const uint64_t *const *lit, const uint64_t *const *mis, unsigned words,
+        unsigned start, unsigned n, const uint64_t *l, const uint64_t *m, vector<unsigned> &found)
+{
+    for (unsigned j = start; j < n; j++) {
+        unsigned diffs = 0;
+        bool single = true;
+        for (unsigned w = 0; w < words; w++) {
+            uint64_t d = lit[w][j] ^ l[w];
+            diffs += (d != 0);
+            single &= (mis[w][j] == m[w]) && !(d & (d - 1));
+        }
+        if (single && diffs == 1)
+            found.push_back(j);
+    }
+}
+
+// appends positions of 32 bits rows from start to n which have missings m
+// and exactly one different liter from l
+static void findScalar32(const uint32_t *lit, const uint32_t *mis, unsigned start, unsigned n,
+        uint32_t l, uint32_t m, vector<unsigned> &found)
+{
+    for (unsigned j = start; j < n; j++) {
+        uint32_t d = lit[j] ^ l;
+        if (mis[j] == m && d && !(d & (d - 1)))
+            found.push_back(j);
+    }
+}
+
+#ifdef TERMSBATCH_X86
+// AVX2 kernel for 32 bits rows - eight rows in one register
+__attribute__((target("avx2")))
+static void findAvx2_32(const uint32_t *lit, const uint32_t *mis, unsigned start, unsigned n,
+        uint32_t l, uint32_t m, vector<unsigned> &found)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i vl = _mm256_set1_epi32(l);
+    const __m256i vm = _mm256_set1_epi32(m);
+
+    unsigned j = start;
+    for (; j + 8 <= n; j += 8) {
+        __m256i d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (lit + j)), vl);
+        __m256i dm = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (mis + j)), vm);
+        // different missings or more than one different liter
+        __m256i bad = _mm256_or_si256(dm, _mm256_and_si256(d, _mm256_sub_epi32(d, one)));
+        // no bad bit and some different liter
+        __m256i ok = _mm256_andnot_si256(_mm256_cmpeq_epi32(d, zero),
+                _mm256_cmpeq_epi32(bad, zero));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(ok));
+        for (; mask; mask &= mask - 1)
+            found.push_back(j + __builtin_ctz(mask));
+    }
+    findScalar32(lit, mis, j, n, l, m, found);
+}
+
+// AVX2 kernel - four rows in one register
+__attribute__((target("avx2")))
+static void findAvx2(const uint64_t *const *lit, const uint64_t *const *mis, unsigned words,
+        unsigned start, unsigned n, const uint64_t *l, const uint64_t *m, vector<unsigned> &found)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    unsigned j = start;
+    for (; j + 4 <= n; j += 4) {
+        __m256i diffs = zero;
+        __m256i bad = zero;
+        for (unsigned w = 0; w < words; w++) {
+            __m256i d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (lit[w] + j)),
+                    _mm256_set1_epi64x(l[w]));
+            __m256i dm = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (mis[w] + j)),
+                    _mm256_set1_epi64x(m[w]));
+            // different missings or more than one different liter in the word
+            bad = _mm256_or_si256(bad, dm);
+            bad = _mm256_or_si256(bad, _mm256_and_si256(d, _mm256_sub_epi64(d, one)));
+            // zero compare is -1 for the word without difference
+            diffs = _mm256_sub_epi64(diffs, _mm256_cmpeq_epi64(d, zero));
+        }
+        // exactly one word with difference: diffs == words - 1
+        __m256i ok = _mm256_and_si256(_mm256_cmpeq_epi64(bad, zero),
+                _mm256_cmpeq_epi64(diffs, _mm256_set1_epi64x(words - 1)));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(ok));
+        for (; mask; mask &= mask - 1)
+            found.push_back(j + __builtin_ctz(mask));
+    }
+    findScalar(lit, mis, words, j, n, l, m, found);
+}
+#endif
+
+typedef void (*FindKernel)(const uint64_t *const *lit, const uint64_t *const *mis, unsigned words,
+        unsigned start, unsigned n, const uint64_t *l, const uint64_t *m, vector<unsigned> &found);
+typedef void (*FindKernel32)(const uint32_t *lit, const uint32_t *mis, unsigned start, unsigned n,
+        uint32_t l, uint32_t m, vector<unsigned> &found);
+
+// selects the widest kernel supported by CPU
+static FindKernel selectFindKernel()
+{
+#ifdef TERMSBATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return findAvx2;
+#endif
+    return findScalar;
+}
+
+// selects the widest kernel for 32 bits rows supported by CPU
+static FindKernel32 selectFindKernel32()
+{
+#ifdef TERMSBATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return findAvx2_32;
+#endif
+    return findScalar32;
+}
+
+static const FindKernel findKernel = selectFindKernel();
+static const FindKernel32 findKernel32 = selectFindKernel32();
+
+
+// sets number of variables and removes all terms
+void TermsBatch::reset(unsigned vc)
+{
+    words = (vc + 63) / 64;
+    if (words == 0)
+        words = 1;
+    else if (words > MAX_WORDS)
+        words = MAX_WORDS;
+    narrow = (vc <= NARROW_VARS);
+    clear();
+}
+
+// removes all terms
+void TermsBatch::clear()
+{
+    for (unsigned w = 0; w < MAX_WORDS; w++) {
+        lit[w].clear();
+        mis[w].clear();
+    }
+    lit32.clear();
+    mis32.clear();
+    flags.clear();
+}
+
+// prepares the batch for n terms
+void TermsBatch::reserve(unsigned n)
+{
+    if (narrow) {
+        lit32.reserve(n);
+        mis32.reserve(n);
+    }
+    else {
+        for (unsigned w = 0; w < words; w++) {
+            lit[w].reserve(n);
+            mis[w].reserve(n);
+        }
+    }
+    flags.reserve(n);
+}
+
+// appends term i of batch b
+void TermsBatch::add(const TermsBatch &b, unsigned i)
+{
+    if (narrow) {
+        lit32.push_back(b.lit32[i]);
+        mis32.push_back(b.mis32[i]);
+    }
+    else {
+        for (unsigned w = 0; w < words; w++) {
+            lit[w].push_back(b.lit[w][i]);
+            mis[w].push_back(b.mis[w][i]);
+        }
+    }
+    flags.push_back(b.flags[i]);
+}
+
+// appends positions of terms which can be combined with term i of batch left
+void TermsBatch::findCombinable(const TermsBatch &left, unsigned i, vector<unsigned> &partners) const
+{
+    if (isEmpty())
+        return;
+    if (narrow) {
+        findKernel32(&lit32[0], &mis32[0], 0, size(), left.lit32[i], left.mis32[i], partners);
+        return;
+    }
+
+    const uint64_t *litRows[MAX_WORDS], *misRows[MAX_WORDS];
+    uint64_t l[MAX_WORDS], m[MAX_WORDS];
+    for (unsigned w = 0; w < words; w++) {
+        litRows[w] = &lit[w][0];
+        misRows[w] = &mis[w][0];
+        l[w] = left.lit[w][i];
+        m[w] = left.mis[w][i];
+    }
+    findKernel(litRows, misRows, words, 0, size(), l, m, partners);
+}
+
+// appends terms combined from term i of batch left and partners to batch out
+void TermsBatch::combine(const TermsBatch &left, unsigned i, const vector<unsigned> &partners,
+        TermsBatch &out, int flg) const
+{
+    for (unsigned k = 0; k < partners.size(); k++) {
+        unsigned j = partners[k];
+        if (narrow) {
+            uint32_t d = lit32[j] ^ left.lit32[i];
+            out.lit32.push_back(left.lit32[i] & ~d);
+            out.mis32.push_back(left.mis32[i] | d);
+        }
+        else {
+            for (unsigned w = 0; w < words; w++) {
+                uint64_t d = lit[w][j] ^ left.lit[w][i];
+                out.lit[w].push_back(left.lit[w][i] & ~d);
+                out.mis[w].push_back(left.mis[w][i] | d);
+            }
+        }
+        out.flags.push_back(flg);
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * termsbatch.h - terms saved by words for batched combining
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TERMSBATCH_H
+#define TERMSBATCH_H
+
+#include <vector>
+#include <stdint.h>
+
+// terms saved by words - the word w of liters (missings) of all terms is in one
+// contiguous array, so SIMD lanes test the same word of consecutive terms,
+// terms with at most NARROW_VARS variables are saved in 32 bits words
+class TermsBatch
+{
+public:
+    // maximal number of 64 bits words of liters
+    static const unsigned MAX_WORDS = 4;
+    // maximal number of variables of terms in 32 bits words
+    static const unsigned NARROW_VARS = 32;
+
+    TermsBatch(unsigned vc = 0) { reset(vc); }
+
+    // sets number of variables and removes all terms
+    void reset(unsigned vc);
+    // removes all terms
+    void clear();
+    // prepares the batch for n terms
+    void reserve(unsigned n);
+
+    inline unsigned size() const { return flags.size(); }
+    inline bool isEmpty() const { return flags.empty(); }
+    inline unsigned wordsCount() const { return words; }
+    inline bool isNarrow() const { return narrow; }
+
+    // appends term with liters l, missings m and flags flg
+    template <typename B> void add(const B &l, const B &m, int flg)
+    {
+        if (narrow) {
+            uint32_t mw = static_cast<uint32_t>(m.getWord64(0));
+            lit32.push_back(static_cast<uint32_t>(l.getWord64(0)) & ~mw);
+            mis32.push_back(mw);
+            flags.push_back(flg);
+            return;
+        }
+        for (unsigned w = 0; w < words; w++) {
+            uint64_t mw = (w < m.words64())? m.getWord64(w): 0;
+            uint64_t lw = (w < l.words64())? l.getWord64(w): 0;
+            lit[w].push_back(lw & ~mw);
+            mis[w].push_back(mw);
+        }
+        flags.push_back(flg);
+    }
+    // appends term i of batch b
+    void add(const TermsBatch &b, unsigned i);
+
+    // returns liters of term i
+    template <typename B> B getLiters(unsigned i) const
+    {
+        return narrow? getBits<B>(lit32, i): getBits<B>(lit, i);
+    }
+    // returns missings of term i
+    template <typename B> B getMissing(unsigned i) const
+    {
+        return narrow? getBits<B>(mis32, i): getBits<B>(mis, i);
+    }
+    // returns flags of term i
+    inline int getFlags(unsigned i) const { return flags[i]; }
+
+    // appends positions of terms which can be combined with term i of batch
+    // left (the same missings and exactly one different liter) to partners
+    void findCombinable(const TermsBatch &left, unsigned i, std::vector<unsigned> &partners) const;
+    // appends terms combined from term i of batch left and partners to batch out
+    void combine(const TermsBatch &left, unsigned i, const std::vector<unsigned> &partners,
+            TermsBatch &out, int flg) const;
+
+private:
+    template <typename B> B getBits(const std::vector<uint64_t> *v, unsigned i) const
+    {
+        B b;
+        for (unsigned w = 0; w < words && w < b.words64(); w++)
+            b.setWord64(w, v[w][i]);
+        return b;
+    }
+    template <typename B> B getBits(const std::vector<uint32_t> &v, unsigned i) const
+    {
+        B b;
+        b.setWord64(0, v[i]);
+        return b;
+    }
+
+    unsigned words;
+    // whether terms are saved in lit32 and mis32
+    bool narrow;
+    std::vector<uint64_t> lit[MAX_WORDS];
+    std::vector<uint64_t> mis[MAX_WORDS];
+    std::vector<uint32_t> lit32;
+    std::vector<uint32_t> mis32;
+    std::vector<int> flags;
+};
+
+#endif // TERMSBATCH_H
@@ -20,8 +20,11 @@
 
 #include "termscontainer.h"
 #include "term.h"
+#include "termstorage.h"
 #include "literalvalue.h"
 #include "outputvalue.h"
+#include "espresso.h"
+#include "espressocover.h"
 
 #include <vector>
 #include <list>
@@ -29,181 +32,779 @@
 
 using namespace std;
 
-// main contructor
-TermsContainer::TermsContainer(int varsCount, TermsType tt, ContainerType ct)
+static inline unsigned popCount(uint64_t w)
 {
-    termVarsCount = varsCount;
-    ttype = tt;
-    ctype = ct;
-    changed = false;
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
+    unsigned c = 0;
+    for (; w; c++)
+        w &= w - 1;
+    return c;
+#endif
+}
 
-    termsVectorOnes = new vector<Term>;
-    termsVectorZeros = new vector<Term>;
-    termsVector = (ttype == MINTERMS)? termsVectorOnes: termsVectorZeros;
+// atomically adds delta to reference counter v and returns the new value
+static inline unsigned refsAdd(unsigned &v, int delta)
+{
+#ifdef __GNUC__
+    return __sync_add_and_fetch(&v, delta);
+#else
+    return v += delta;
+#endif
 }
 
-// copy constructor
-TermsContainer::TermsContainer(const TermsContainer &tc)
+static inline unsigned firstOne(uint64_t w)
 {
-    copy(tc);
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
+#else
+    unsigned pos = 0;
+    while (!(w & 1)) {
+        w >>= 1;
+        pos++;
+    }
+    return pos;
+#endif
 }
 
-// assignment operator
-TermsContainer &TermsContainer::operator=(const TermsContainer &tc)
+// returns whether position idx of bitmap is set
+static inline bool testBit(const vector<uint64_t> &b, unsigned idx)
 {
-    if (this == &tc)
-        return *this;
+    return (b[idx / 64] >> (idx % 64)) & 1;
+}
 
-    delete termsVectorOnes;
-    delete termsVectorZeros;
+// sets position idx of bitmap to value
+static inline void setBit(vector<uint64_t> &b, unsigned idx, bool value)
+{
+    if (value)
+        b[idx / 64] |= uint64_t(1) << (idx % 64);
+    else
+        b[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+}
+
+// appends minterms (maxterms) of term t to v
+template <typename S>
+static void expandTerm(vector<Term> &v, const BasicTerm<S> &t)
+{
+    typename BasicTerm<S>::minterm_iterator it;
+    for (it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+        v.push_back(Term(*it));
+}
 
-    copy(tc);
-    return *this;
+// TermsContainer
+
+// returns new container with the narrowest storage for varsCount variables
+TermsContainer *TermsContainer::create(unsigned varsCount, TermsType tt, ContainerType ct)
+{
+    switch (getTermWidth(varsCount)) {
+    case TW_16:
+        return new BasicTermsContainer<TermStorage16>(varsCount, tt, ct);
+    case TW_32:
+        return new BasicTermsContainer<TermStorage32>(varsCount, tt, ct);
+    case TW_64:
+        return new BasicTermsContainer<TermStorage64>(varsCount, tt, ct);
+    case TW_128:
+        return new BasicTermsContainer<TermStorage128>(varsCount, tt, ct);
+    default:
+        return new BasicTermsContainer<TermStorage256>(varsCount, tt, ct);
+    }
 }
 
-// internal copying
-void TermsContainer::copy(const TermsContainer &tc)
+// base contructor
+TermsContainer::TermsContainer(unsigned varsCount, TermsType tt, ContainerType ct)
+{
+    termVarsCount = varsCount;
+    ttype = tt;
+    ctype = (ct == BIT_SET)? STL_VECTOR: ct;
+    changed = false;
+}
+
+// base copy constructor
+TermsContainer::TermsContainer(const TermsContainer &tc)
 {
     termVarsCount = tc.termVarsCount;
     ttype = tc.ttype;
     ctype = tc.ctype;
     changed = tc.changed;
+}
 
-    termsVectorOnes = new vector<Term>(tc.termsVectorOnes->begin(), tc.termsVectorOnes->end());
-    termsVectorZeros = new vector<Term>(tc.termsVectorZeros->begin(), tc.termsVectorZeros->end());
-    termsVector = (ttype == MINTERMS)? termsVectorOnes: termsVectorZeros;
+// sets value of the term with idx to val
+bool TermsContainer::setTermValue(int idx, OutputValue val)
+{
+    if (val.isDC())
+        return pushTerm(idx, true);
+    else if ((val.isOne() && ttype == MINTERMS) || (val.isZero() && ttype == MAXTERMS))
+        return pushTerm(idx, false);
+    else
+        return removeTerm(idx);
 }
 
-// destructor
-TermsContainer::~TermsContainer()
+// sets value of the term t to val
+bool TermsContainer::setTermValue(const Term &t, OutputValue val)
+{
+    if (val.isDC() && !t.isDC()) {
+        Term tNew = t;
+        tNew.setDC(true);
+        return pushTerm(tNew);
+    }
+    else if (val.isDC() || (val.isOne() && ttype == MINTERMS) || (val.isZero() && ttype == MAXTERMS))
+        return pushTerm(t);
+    else
+        return removeTerm(t);
+}
+
+// returns terms id for terms with value equal to val
+vector<int> TermsContainer::getTermsIdx(int val)
+{
+    vector<int> idxs;
+    getTermsIdx(val, idxs);
+    return idxs;
+}
+
+// returns actual terms
+vector<Term> TermsContainer::getTerms()
+{
+    vector<Term> terms;
+    return getTerms(terms);
+}
+
+// returns actual minterms
+vector<Term> TermsContainer::getMinterms()
+{
+    vector<Term> minterms;
+    return getMinterms(minterms);
+}
+
+// returns actual maxterms
+vector<Term> TermsContainer::getMaxterms()
+{
+    vector<Term> maxterms;
+    return getMaxterms(maxterms);
+}
+
+// returns on-set, off-set and dc-set covers
+void TermsContainer::getCovers(list<Term> &f, list<Term> &d, list<Term> &r)
+{
+    vector<Term> minterms = getMinterms();
+    vector<Term> maxterms = getMaxterms();
+
+    f.clear();
+    d.clear();
+    r.clear();
+
+    for (unsigned i = 0; i < minterms.size(); i++) {
+        if (minterms[i].isDC())
+            d.push_back(minterms[i]);
+        else
+            f.push_back(minterms[i]);
+    }
+
+    for (unsigned i = 0; i < maxterms.size(); i++) {
+        if (!maxterms[i].isDC())
+            r.push_back(maxterms[i]);
+    }
+}
+
+// nonequality
+bool TermsContainer::operator!=(const TermsContainer &tc) const
+{
+    return !operator==(tc);
+}
+
+// BasicTermsContainer
+
+// shared data constructor
+template <typename S>
+BasicTermsContainer<S>::Data::Data(unsigned varsCount) : tree(varsCount)
+{
+    termsVectorOnes = new vector<term_type>;
+    termsVectorZeros = new vector<term_type>;
+    refs = 1;
+}
+
+// shared data copy constructor (the copy isn't shared)
+template <typename S>
+BasicTermsContainer<S>::Data::Data(const Data &data) : index(data.index), tree(data.tree),
+        bits(data.bits), dcBits(data.dcBits)
+{
+    termsVectorOnes = new vector<term_type>(*data.termsVectorOnes);
+    termsVectorZeros = new vector<term_type>(*data.termsVectorZeros);
+    refs = 1;
+}
+
+// shared data destructor
+template <typename S>
+BasicTermsContainer<S>::Data::~Data()
 {
     delete termsVectorOnes;
     delete termsVectorZeros;
 }
 
-// sets container
-void TermsContainer::setContainer(vector<Term> &v)
+// main contructor
+template <typename S>
+BasicTermsContainer<S>::BasicTermsContainer(unsigned varsCount, TermsType tt, ContainerType ct)
+        : TermsContainer(varsCount, tt, ct)
 {
-    delete termsVector;
-    termsVector = new vector<Term>(v.begin(), v.end());
-    if (ttype == MINTERMS)
-        termsVectorOnes = termsVector;
+    bitsCount = 0;
+    bitsSynced = false;
+    autoType = (ct == STL_VECTOR);
+    itPos = 0;
+
+    // bitmaps take the same memory as the vector of denseCheck terms
+    unsigned bitsSize = (termVarsCount <= BIT_SET_MAX_VARS)? ((1u << termVarsCount) + 63) / 64 * 16: 0;
+    denseCheck = bitsSize / sizeof(term_type) + 1;
+
+    d = new Data(termVarsCount);
+    termsVector = (ttype == MINTERMS)? d->termsVectorOnes: d->termsVectorZeros;
+
+    if (ct == BIT_SET)
+        toBitSet();
+}
+
+// copy constructor - the data are shared until the first change
+template <typename S>
+BasicTermsContainer<S>::BasicTermsContainer(const BasicTermsContainer &tc) : TermsContainer(tc)
+{
+    autoType = tc.autoType;
+    denseCheck = tc.denseCheck;
+    bitsCount = tc.bitsCount;
+    bitsSynced = false;
+    itPos = 0;
+
+    d = tc.d;
+    refsAdd(d->refs, 1);
+    termsVector = tc.termsVector;
+}
+
+// destructor
+template <typename S>
+BasicTermsContainer<S>::~BasicTermsContainer()
+{
+    release();
+}
+
+// returns copy of the container
+template <typename S>
+TermsContainer *BasicTermsContainer<S>::clone() const
+{
+    return new BasicTermsContainer(*this);
+}
+
+// releases the shared data
+template <typename S>
+void BasicTermsContainer<S>::release()
+{
+    if (refsAdd(d->refs, -1) == 0)
+        delete d;
+    d = 0;
+}
+
+// makes own copy of the shared data (has to be called before every change),
+// the container is emptied instead if copyData isn't set
+template <typename S>
+void BasicTermsContainer<S>::detach(bool copyData)
+{
+    if (refsAdd(d->refs, 0) == 1)
+        return;
+
+    Data *data;
+    if (copyData)
+        data = new Data(*d);
+    else {
+        data = new Data(termVarsCount);
+        data->bits.assign(d->bits.size(), 0);
+        data->dcBits.assign(d->dcBits.size(), 0);
+        bitsCount = 0;
+        changed = true;
+    }
+    release();
+    d = data;
+    termsVector = (ttype == MINTERMS)? d->termsVectorOnes: d->termsVectorZeros;
+}
+
+// sets container type
+template <typename S>
+bool BasicTermsContainer<S>::setContainerType(ContainerType ct)
+{
+    autoType = false;
+    if (ct == ctype)
+        return true;
+
+    detach();
+    if (ct == BIT_SET)
+        return toBitSet();
+    toVector();
+    ctype = ct;
+    buildIndex();
+    return true;
+}
+
+// switches to STL_SET if the terms vector is big or to BIT_SET if it is dense
+template <typename S>
+void BasicTermsContainer<S>::checkType()
+{
+    if (!autoType || ctype == BIT_SET)
+        return;
+
+    if (termVarsCount <= BIT_SET_MAX_VARS && termsVector->size() >= denseCheck) {
+        if (toBitSet())
+            return;
+        denseCheck = termsVector->size() * 2;
+    }
+    if (ctype == STL_VECTOR && termsVector->size() >= STL_SET_MIN_SIZE) {
+        ctype = STL_SET;
+        buildIndex();
+    }
+}
+
+// rebuilds STL_SET or TERMS_TREE index of the terms vector
+template <typename S>
+void BasicTermsContainer<S>::buildIndex()
+{
+    d->index.clear();
+    d->tree.clear();
+    if (ctype == STL_SET) {
+        d->index.reserve(termsVector->size());
+        for (unsigned i = 0; i < termsVector->size(); i++)
+            d->index.insert(termsVector->at(i), i);
+    }
+    else if (ctype == TERMS_TREE) {
+        for (unsigned i = 0; i < termsVector->size(); i++)
+            d->tree.insert(termsVector->at(i), i);
+    }
+}
+
+// returns position of term t in the terms vector or -1
+template <typename S>
+int BasicTermsContainer<S>::findTerm(const term_type &t) const
+{
+    if (ctype == STL_SET)
+        return d->index.find(t);
+    else if (ctype == TERMS_TREE)
+        return d->tree.find(t);
+
+    typename vector<term_type>::const_iterator it = find(termsVector->begin(), termsVector->end(), t);
+    return (it == termsVector->end())? -1: it - termsVector->begin();
+}
+
+// removes term at position pos from the terms vector
+template <typename S>
+void BasicTermsContainer<S>::eraseTerm(unsigned pos)
+{
+    if (ctype != STL_SET && ctype != TERMS_TREE) {
+        termsVector->erase(termsVector->begin() + pos);
+        return;
+    }
+
+    // the last term is moved to the position
+    if (ctype == STL_SET)
+        d->index.remove(termsVector->at(pos));
     else
-        termsVectorZeros = termsVector;
+        d->tree.remove(termsVector->at(pos));
+    if (pos + 1 != termsVector->size()) {
+        termsVector->at(pos) = termsVector->back();
+        if (ctype == STL_SET)
+            d->index.update(termsVector->at(pos), pos);
+        else
+            d->tree.update(termsVector->at(pos), pos);
+    }
+    termsVector->pop_back();
+}
+
+// moves terms to bitmaps, returns false if some term isn't minterm
+template <typename S>
+bool BasicTermsContainer<S>::toBitSet()
+{
+    if (termVarsCount > BIT_SET_MAX_VARS)
+        return false;
+    for (unsigned i = 0; i < termsVector->size(); i++) {
+        if (termsVector->at(i).getIdx() < 0)
+            return false;
+    }
+
+    unsigned words = ((1u << termVarsCount) + 63) / 64;
+    d->bits.assign(words, 0);
+    d->dcBits.assign(words, 0);
+    bitsCount = 0;
+    for (unsigned i = 0; i < termsVector->size(); i++) {
+        const term_type &t = termsVector->at(i);
+        unsigned idx = t.getIdx();
+        if (!testBit(d->bits, idx) && !testBit(d->dcBits, idx)) {
+            setBit(t.isDC()? d->dcBits: d->bits, idx, true);
+            bitsCount++;
+        }
+    }
+    d->termsVectorOnes->clear();
+    d->termsVectorZeros->clear();
+    d->index.clear();
+    d->tree.clear();
+    ctype = BIT_SET;
+    bitsSynced = false;
+    return true;
+}
+
+// moves terms from bitmaps to terms vector
+template <typename S>
+void BasicTermsContainer<S>::toVector()
+{
+    if (ctype != BIT_SET)
+        return;
+
+    syncVector();
+    termsVector->swap(bitsTerms);
+    vector<term_type>().swap(bitsTerms);
+    bitsSynced = false;
+    d->bits.clear();
+    d->dcBits.clear();
+    bitsCount = 0;
+    ctype = STL_VECTOR;
+    changed = true;
+}
+
+// appends terms from bitmaps (complement of the saved terms if complement is set)
+template <typename S>
+template <typename T>
+void BasicTermsContainer<S>::bitsToTerms(vector<T> &v, bool complement) const
+{
+    bitsToTerms(v, complement, d->bits, d->dcBits);
+}
+
+// appends terms from bitmaps bits and dcBits
+template <typename S>
+template <typename T>
+void BasicTermsContainer<S>::bitsToTerms(vector<T> &v, bool complement,
+        const vector<uint64_t> &bits, const vector<uint64_t> &dcBits) const
+{
+    unsigned all = 1u << termVarsCount;
+    for (unsigned w = 0; w < bits.size(); w++) {
+        uint64_t saved = complement? ~(bits[w] | dcBits[w]): bits[w];
+        if (all < 64)
+            saved &= (uint64_t(1) << all) - 1;
+        for (uint64_t b = saved | dcBits[w]; b; b &= b - 1) {
+            unsigned pos = firstOne(b);
+            v.push_back(T(w * 64 + pos, termVarsCount, (dcBits[w] >> pos) & 1));
+        }
+    }
+}
+
+// sets bitmaps to minterms of the terms vector, returns false if there
+// are too many variables
+template <typename S>
+bool BasicTermsContainer<S>::termsToBits(vector<uint64_t> &bits, vector<uint64_t> &dcBits) const
+{
+    if (termVarsCount > BIT_SET_MAX_VARS)
+        return false;
+
+    unsigned words = ((1u << termVarsCount) + 63) / 64;
+    bits.assign(words, 0);
+    dcBits.assign(words, 0);
+    for (unsigned i = 0; i < termsVector->size(); i++) {
+        const term_type &t = termsVector->at(i);
+        vector<uint64_t> &b = t.isDC()? dcBits: bits;
+        if (t.getMissing().none())
+            setBit(b, t.getIdx(), true);
+        else {
+            typename term_type::minterm_iterator it;
+            for (it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+                setBit(b, it.idx(), true);
+        }
+    }
+    // minterms which are in both are saved as ones
+    for (unsigned w = 0; w < words; w++)
+        dcBits[w] &= ~bits[w];
+    return true;
+}
+
+// returns terms vector, for BIT_SET it's rebuilt from bitmaps to the own
+// vector of the container (for access by position)
+template <typename S>
+const vector<BasicTerm<S> > &BasicTermsContainer<S>::syncVector() const
+{
+    if (ctype != BIT_SET)
+        return *termsVector;
+
+    if (!bitsSynced) {
+        bitsTerms.clear();
+        bitsTerms.reserve(bitsCount);
+        bitsToTerms(bitsTerms, false);
+        bitsSynced = true;
+    }
+    return bitsTerms;
+}
+
+// returns index of term t in bitmaps or -1 if t isn't minterm
+template <typename S>
+int BasicTermsContainer<S>::bitIdx(const term_type &t) const
+{
+    if (t.getSize() != termVarsCount)
+        return -1;
+    return t.getIdx();
+}
+
+// sets container
+template <typename S>
+void BasicTermsContainer<S>::setContainer(vector<Term> &v)
+{
+    vector<Term> terms(v);
+    swapContainer(terms);
+}
+
+// sets container by taking terms of v without copying (v is emptied)
+template <typename S>
+void BasicTermsContainer<S>::swapContainer(vector<Term> &v)
+{
+    // the old terms aren't copied
+    detach(false);
+    if (ctype == BIT_SET) {
+        d->bits.clear();
+        d->dcBits.clear();
+        bitsCount = 0;
+        vector<term_type>().swap(bitsTerms);
+        bitsSynced = false;
+        ctype = STL_VECTOR;
+    }
+    termsVector->clear();
+    termsVector->reserve(v.size());
+    for (unsigned i = 0; i < v.size(); i++)
+        termsVector->push_back(term_type(v[i]));
+    vector<Term>().swap(v);
+    buildIndex();
     changed = true;
 }
 
 // sets terms type
-void TermsContainer::setTermsType(TermsType tt)
+template <typename S>
+void BasicTermsContainer<S>::setTermsType(TermsType tt)
 {
-    if (tt != ttype) {
+    if (tt != ttype)
+        detach();
+    if (tt != ttype && ctype == BIT_SET) {
+        // complement of the saved terms (dont cares are kept)
+        unsigned all = 1u << termVarsCount;
+        bitsCount = 0;
+        for (unsigned w = 0; w < d->bits.size(); w++) {
+            d->bits[w] = ~(d->bits[w] | d->dcBits[w]);
+            if (all < 64)
+                d->bits[w] &= (uint64_t(1) << all) - 1;
+            bitsCount += popCount(d->bits[w]) + popCount(d->dcBits[w]);
+        }
+        ttype = tt;
+        termsVector = (ttype == MINTERMS)? d->termsVectorOnes: d->termsVectorZeros;
+        bitsSynced = false;
+    }
+    else if (tt != ttype) {
         setComplement();
         ttype = tt;
-        termsVector = (ttype == MINTERMS)? termsVectorOnes: termsVectorZeros;
+        termsVector = (ttype == MINTERMS)? d->termsVectorOnes: d->termsVectorZeros;
+        buildIndex();
     }
 }
 
 // returns the number of elements in the container
-unsigned TermsContainer::getSize() const
+template <typename S>
+unsigned BasicTermsContainer<S>::getSize() const
 {
-    return termsVector->size();
+    return (ctype == BIT_SET)? bitsCount: termsVector->size();
 }
 
 // pushes new term to the container by idx
-bool TermsContainer::pushTerm(int idx, bool isDC)
-{
-    for (vector<Term>::iterator it = termsVector->begin(); it != termsVector->end(); it++) {
-        if (idx == (*it).getIdx()) {
-            if ((*it).isDC() ^ isDC) {
-                (*it).setDC(isDC);
-                return (changed = true);
-            }
-            else
+template <typename S>
+bool BasicTermsContainer<S>::pushTerm(int idx, bool isDC)
+{
+    if (ctype == BIT_SET) {
+        if (!isBitIdx(idx))
+            return false;
+        if (testBit(d->bits, idx) || testBit(d->dcBits, idx)) {
+            if (testBit(d->dcBits, idx) == isDC)
                 return false;
+            detach();
+            setBit(d->bits, idx, !isDC);
+            setBit(d->dcBits, idx, isDC);
+        }
+        else {
+            detach();
+            setBit(isDC? d->dcBits: d->bits, idx, true);
+            bitsCount++;
         }
+        bitsSynced = false;
+        return (changed = true);
     }
-    termsVector->push_back(Term(idx, termVarsCount, isDC));
+
+    int pos = findTerm(term_type(idx, termVarsCount));
+    if (pos >= 0) {
+        if (termsVector->at(pos).isDC() ^ isDC) {
+            detach();
+            termsVector->at(pos).setDC(isDC);
+            return (changed = true);
+        }
+        else
+            return false;
+    }
+    detach();
+    termsVector->push_back(term_type(idx, termVarsCount, isDC));
+    if (ctype == STL_SET)
+        d->index.insert(termsVector->back(), termsVector->size() - 1);
+    else if (ctype == TERMS_TREE)
+        d->tree.insert(termsVector->back(), termsVector->size() - 1);
+    checkType();
     return (changed = true);
 }
 
 // pushes term t to the container
-bool TermsContainer::pushTerm(const Term &t)
+template <typename S>
+bool BasicTermsContainer<S>::pushTerm(const Term &term)
 {
-    if (find(termsVector->begin(), termsVector->end(), t) == termsVector->end()) {
+    term_type t(term);
+    if (ctype == BIT_SET) {
+        int idx = bitIdx(t);
+        if (idx >= 0) {
+            if (testBit(d->bits, idx) || testBit(d->dcBits, idx))
+                return false;
+            return pushTerm(idx, t.isDC());
+        }
+        // cubes are saved only in vector
+        detach();
+        toVector();
+    }
+
+    if (findTerm(t) < 0) {
+        detach();
         termsVector->push_back(t);
+        if (ctype == STL_SET)
+            d->index.insert(t, termsVector->size() - 1);
+        else if (ctype == TERMS_TREE)
+            d->tree.insert(t, termsVector->size() - 1);
+        checkType();
         return (changed = true);
     }
     return false;
 }
 
 // removes term from the container by idx
-bool TermsContainer::removeTerm(int idx)
+template <typename S>
+bool BasicTermsContainer<S>::removeTerm(int idx)
 {
-    for (vector<Term>::iterator it = termsVector->begin(); it != termsVector->end(); it++) {
-        if (idx == (*it).getIdx()) {
-            termsVector->erase(it);
-            return (changed = true);
-        }
+    if (ctype == BIT_SET) {
+        if (!isBitIdx(idx) || (!testBit(d->bits, idx) && !testBit(d->dcBits, idx)))
+            return false;
+        detach();
+        setBit(d->bits, idx, false);
+        setBit(d->dcBits, idx, false);
+        bitsCount--;
+        bitsSynced = false;
+        return (changed = true);
     }
-    return false;
+
+    int pos = findTerm(term_type(idx, termVarsCount));
+    if (pos < 0)
+        return false;
+    detach();
+    eraseTerm(pos);
+    return (changed = true);
 }
 
 // removes term t from the container
-bool TermsContainer::removeTerm(const Term &t)
+template <typename S>
+bool BasicTermsContainer<S>::removeTerm(const Term &term)
 {
-    vector<Term>::iterator it;
-    if ((it = find(termsVector->begin(), termsVector->end(), t)) != termsVector->end()) {
-        termsVector->erase(it);
-        return (changed = true);
+    term_type t(term);
+    if (ctype == BIT_SET) {
+        int idx = bitIdx(t);
+        return (idx >= 0)? removeTerm(idx): false;
     }
-    return false;
+
+    int pos = findTerm(t);
+    if (pos < 0)
+        return false;
+    detach();
+    eraseTerm(pos);
+    return (changed = true);
 }
 
 // finds out whether term t is in the container
-bool TermsContainer::hasTerm(const Term &t) const
+template <typename S>
+bool BasicTermsContainer<S>::hasTerm(const Term &term) const
 {
+    term_type t(term);
+    if (ctype == BIT_SET) {
+        int idx = bitIdx(t);
+        return idx >= 0 && (testBit(d->bits, idx) || testBit(d->dcBits, idx));
+    }
+
     if (termsVector->empty() || termsVector->at(0).getSize() != t.getSize())
         return false;
-    return find(termsVector->begin(), termsVector->end(),t) != termsVector->end();
+    return findTerm(t) >= 0;
 }
 
-// sets value of the term with idx to val
-bool TermsContainer::setTermValue(int idx, OutputValue val)
+// finds out whether some term in the container contains term t
+template <typename S>
+bool BasicTermsContainer<S>::hasCover(const Term &term) const
 {
-    if (val.isDC())
-        return pushTerm(idx, true);
-    else if ((val.isOne() && ttype == MINTERMS) || (val.isZero() && ttype == MAXTERMS))
-        return pushTerm(idx, false);
-    else
-        return removeTerm(idx);
+    if (ctype == BIT_SET)
+        return hasTerm(term);
+
+    term_type t(term);
+    if (ctype == TERMS_TREE)
+        return d->tree.findContaining(t) != BasicTermsTree<S>::NONE;
+
+    for (unsigned i = 0; i < termsVector->size(); i++) {
+        if (termsVector->at(i).contains(t))
+            return true;
+    }
+    return false;
 }
 
-// sets value of the term t to val
-bool TermsContainer::setTermValue(const Term &t, OutputValue val)
+// returns terms which intersect term t
+template <typename S>
+vector<Term> &BasicTermsContainer<S>::getIntersecting(const Term &term, vector<Term> &terms) const
 {
-    if (val.isDC() && !t.isDC()) {
-        Term tNew = t;
-        tNew.setDC(true);
-        return pushTerm(tNew);
+    term_type t(term);
+    terms.clear();
+    if (ctype == BIT_SET) {
+        typename term_type::minterm_iterator it;
+        for (it = t.mintermsBegin(); it != t.mintermsEnd(); ++it) {
+            int idx = it.idx();
+            if (testBit(d->bits, idx) || testBit(d->dcBits, idx))
+                terms.push_back(Term(idx, termVarsCount, testBit(d->dcBits, idx)));
+        }
     }
-    else if (val.isDC() || (val.isOne() && ttype == MINTERMS) || (val.isZero() && ttype == MAXTERMS))
-        return pushTerm(t);
-    else
-        return removeTerm(t);
+    else if (ctype == TERMS_TREE) {
+        vector<int> positions;
+        d->tree.findIntersecting(t, positions);
+        for (unsigned i = 0; i < positions.size(); i++)
+            terms.push_back(Term(termsVector->at(positions[i])));
+    }
+    else {
+        typename term_type::bits_t tFixed = ~t.getMissing();
+        for (unsigned i = 0; i < termsVector->size(); i++) {
+            const term_type &tt = termsVector->at(i);
+            if (((tt.getLiters() ^ t.getLiters()) & tFixed & ~tt.getMissing()).none())
+                terms.push_back(Term(tt));
+        }
+    }
+    return terms;
 }
 
  // returns value of the term with idx
-OutputValue TermsContainer::getTermValue(int idx) const
+template <typename S>
+OutputValue BasicTermsContainer<S>::getTermValue(int idx) const
 {
-    for (unsigned i = 0; i < termsVector->size(); i++) {
-        if (idx == termsVector->at(i).getIdx()) {
-            if (termsVector->at(i).isDC())
-                return OutputValue::DC;
-            else if (ttype == MINTERMS)
-                return OutputValue::ONE;
-            else
-                return OutputValue::ZERO;
-        }
+    if (ctype == BIT_SET && isBitIdx(idx) && testBit(d->dcBits, idx))
+        return OutputValue::DC;
+    else if (ctype == BIT_SET && isBitIdx(idx) && testBit(d->bits, idx))
+        return (ttype == MINTERMS)? OutputValue::ONE: OutputValue::ZERO;
+    else if (ctype == BIT_SET)
+        return (ttype == MINTERMS)? OutputValue::ZERO: OutputValue::ONE;
+
+    int pos = findTerm(term_type(idx, termVarsCount));
+    if (pos >= 0) {
+        if (termsVector->at(pos).isDC())
+            return OutputValue::DC;
+        else if (ttype == MINTERMS)
+            return OutputValue::ONE;
+        else
+            return OutputValue::ZERO;
     }
     if (ttype == MINTERMS)
         return OutputValue::ZERO;
@@ -212,218 +813,291 @@ OutputValue TermsContainer::getTermValue(int idx) const
 }
 
 // returns term at the position pos
-const Term &TermsContainer::at(unsigned pos) const
+template <typename S>
+Term BasicTermsContainer<S>::at(unsigned pos) const
 {
-    return termsVector->at(pos);
-}
-
-// returns actual terms
-std::vector<Term> TermsContainer::getTerms()
-{
-    return *termsVector;
+    return Term(syncVector().at(pos));
 }
 
 // returns actual terms (copies result to idxs)
-std::vector<Term> &TermsContainer::getTerms(std::vector<Term> &terms)
+template <typename S>
+vector<Term> &BasicTermsContainer<S>::getTerms(vector<Term> &terms)
 {
-    terms = *termsVector;
+    const vector<term_type> &v = syncVector();
+    terms.clear();
+    terms.reserve(v.size());
+    for (unsigned i = 0; i < v.size(); i++)
+        terms.push_back(Term(v[i]));
     return terms;
 }
 
 // returns actual minterms (copies result to idxs)
-vector<Term> &TermsContainer::getMinterms(vector<Term> &minterms)
+template <typename S>
+vector<Term> &BasicTermsContainer<S>::getMinterms(vector<Term> &minterms)
 {
     minterms.clear();
-    if (ttype == MINTERMS) {
+    // maxterms are returned for MAXTERMS (the same as for terms vector)
+    if (ctype == BIT_SET)
+        bitsToTerms(minterms, false);
+    else if (ttype == MINTERMS) {
         minterms.reserve(termsVector->size());
         for (unsigned i = 0; i < termsVector->size(); i++)
-            Term::expandTerm(minterms, termsVector->at(i));
+            expandTerm(minterms, termsVector->at(i));
     }
     else {
         setComplement();
-        minterms.reserve(termsVectorZeros->size());
-        for (unsigned i = 0; i < termsVectorZeros->size(); i++)
-            Term::expandTerm(minterms, termsVectorZeros->at(i));
+        minterms.reserve(d->termsVectorZeros->size());
+        for (unsigned i = 0; i < d->termsVectorZeros->size(); i++)
+            expandTerm(minterms, d->termsVectorZeros->at(i));
     }
     return minterms;
 }
 
-// returns actual minterms
-vector<Term> TermsContainer::getMinterms()
-{
-    vector<Term> minterms;
-    return getMinterms(minterms);
-}
-
 // returns actual maxterms (copies result to idxs)
-vector<Term> &TermsContainer::getMaxterms(vector<Term> &maxterms)
+template <typename S>
+vector<Term> &BasicTermsContainer<S>::getMaxterms(vector<Term> &maxterms)
 {
     maxterms.clear();
-    if (ttype == MAXTERMS) {
+    if (ctype == BIT_SET)
+        bitsToTerms(maxterms, ttype != MAXTERMS);
+    else if (ttype == MAXTERMS) {
         maxterms.reserve(termsVector->size());
         for (unsigned i = 0; i < termsVector->size(); i++)
-            Term::expandTerm(maxterms, termsVector->at(i));
+            expandTerm(maxterms, termsVector->at(i));
     }
     else {
         setComplement();
-        maxterms.reserve(termsVectorZeros->size());
-        for (unsigned i = 0; i < termsVectorZeros->size(); i++)
-            Term::expandTerm(maxterms, termsVectorZeros->at(i));
+        maxterms.reserve(d->termsVectorZeros->size());
+        for (unsigned i = 0; i < d->termsVectorZeros->size(); i++)
+            expandTerm(maxterms, d->termsVectorZeros->at(i));
     }
     return maxterms;
 }
 
-// returns actual maxterms
-vector<Term> TermsContainer::getMaxterms()
-{
-    vector<Term> maxterms;
-    return getMaxterms(maxterms);
-}
-
-// returns on-set, off-set and dc-set covers
-void TermsContainer::getCovers(list<Term> &f, list<Term> &d, list<Term> &r)
+// returns saved cubes without expanding - on-set (off-set for maxterms) and dc-set
+template <typename S>
+void BasicTermsContainer<S>::getCubes(list<Term> &c, list<Term> &d) const
 {
-    vector<Term> minterms = getMinterms();
-    vector<Term> maxterms = getMaxterms();
-
-    f.clear();
+    c.clear();
     d.clear();
-    r.clear();
 
-    for (unsigned i = 0; i < minterms.size(); i++) {
-        if (minterms[i].isDC())
-            d.push_back(minterms[i]);
+    const vector<term_type> &v = syncVector();
+    for (unsigned i = 0; i < v.size(); i++) {
+        Term t(v[i]);
+        if (t.isDC())
+            d.push_back(t);
         else
-            f.push_back(minterms[i]);
-    }
-
-    for (unsigned i = 0; i < maxterms.size(); i++) {
-        if (!maxterms[i].isDC())
-            r.push_back(maxterms[i]);
+            c.push_back(t);
     }
 }
 
 // returns terms id for terms with value equal to val (copies result to idxs)
-vector<int> &TermsContainer::getTermsIdx(int val, vector<int> &idxs)
+template <typename S>
+vector<int> &BasicTermsContainer<S>::getTermsIdx(int val, vector<int> &idxs)
 {
     OutputValue value(val);
-    vector<Term> v;
 
     idxs.clear();
 
-    if ((!value.isZero() && ttype == MINTERMS) || (!value.isOne() && ttype == MAXTERMS)) {
-        v.reserve(termsVector->size());
-        for (unsigned i = 0; i < termsVector->size(); i++)
-            Term::expandTerm(v, termsVector->at(i));
+    if (ctype == BIT_SET) {
+        // dont cares or saved terms or the rest
+        bool saved = (value.isOne() && ttype == MINTERMS) || (value.isZero() && ttype == MAXTERMS);
+        for (unsigned w = 0; w < d->bits.size(); w++) {
+            uint64_t b = value.isDC()? d->dcBits[w]: (saved? d->bits[w]: ~(d->bits[w] | d->dcBits[w]));
+            if ((1u << termVarsCount) < 64)
+                b &= (uint64_t(1) << (1u << termVarsCount)) - 1;
+            for (; b; b &= b - 1)
+                idxs.push_back(w * 64 + firstOne(b));
+        }
+        return idxs;
     }
-    else {
+
+    const vector<term_type> *v = termsVector;
+    if ((value.isZero() && ttype == MINTERMS) || (value.isOne() && ttype == MAXTERMS)) {
         setComplement();
-        vector<Term> *cv = (ttype == MINTERMS)? termsVectorZeros: termsVectorOnes;
-        v.reserve(cv->size());
-        for (unsigned i = 0; i < cv->size(); i++)
-            Term::expandTerm(v, cv->at(i));
+        v = (ttype == MINTERMS)? d->termsVectorZeros: d->termsVectorOnes;
     }
 
-    for (unsigned i = 0; i < v.size(); i++) {
-        if (!(value.isDC() ^ v[i].isDC()))
-            idxs.push_back(v[i].getIdx());
+    // minterms of the terms are enumerated without expanding them to vector
+    for (unsigned i = 0; i < v->size(); i++) {
+        const term_type &t = v->at(i);
+        if (value.isDC() ^ t.isDC())
+            continue;
+        typename term_type::minterm_iterator it;
+        for (it = t.mintermsBegin(); it != t.mintermsEnd(); ++it)
+            idxs.push_back(it.idx());
     }
 
     return idxs;
 }
 
-// returns terms id for terms with value equal to val
-vector<int> TermsContainer::getTermsIdx(int val)
-{
-    vector<int> idxs;
-    getTermsIdx(val, idxs);
-    return idxs;
-}
-
 // removes all terms from the container
-void TermsContainer::clear()
+template <typename S>
+void BasicTermsContainer<S>::clear()
 {
+    detach(false);
+    if (ctype == BIT_SET) {
+        d->bits.assign(d->bits.size(), 0);
+        d->dcBits.assign(d->dcBits.size(), 0);
+        bitsCount = 0;
+        bitsSynced = false;
+    }
     termsVector->clear();
+    d->index.clear();
+    d->tree.clear();
     changed = true;
 }
 
 // equality
-bool TermsContainer::operator==(const TermsContainer &tc) const
+template <typename S>
+bool BasicTermsContainer<S>::operator==(const TermsContainer &tc) const
 {
-    if (termsVector->size() != tc.termsVector->size())
+    if (getSize() != tc.getSize())
         return false;
+
+    // containers with the same number of variables have the same storage
+    bool bitSet = (ctype == BIT_SET), tcBitSet = (tc.getContainerType() == BIT_SET);
+    if ((bitSet || tcBitSet) && tc.getVarsCount() == termVarsCount) {
+        const BasicTermsContainer &c = static_cast<const BasicTermsContainer &>(tc);
+        if (bitSet && tcBitSet)
+            return d->bits == c.d->bits && d->dcBits == c.d->dcBits;
+
+        // terms of the other container are looked up in bitmaps
+        const BasicTermsContainer &bc = bitSet? *this: c;
+        const vector<term_type> &v = bitSet? *c.termsVector: *termsVector;
+        for (unsigned i = 0; i < v.size(); i++) {
+            int idx = bc.bitIdx(v[i]);
+            if (idx < 0 || !testBit(v[i].isDC()? bc.d->dcBits: bc.d->bits, idx))
+                return false;
+        }
+        return true;
+    }
+
+    const vector<term_type> &v = syncVector();
     // checks all terms
-    for (unsigned i = 0; i < termsVector->size(); i++) {
-        if (find(tc.termsVector->begin(), tc.termsVector->end(), termsVector->at(i)) == tc.termsVector->end())
+    for (unsigned i = 0; i < v.size(); i++) {
+        if (!tc.hasTerm(Term(v[i])))
             return false;
     }
     return true;
 }
 
-// nonequality
-bool TermsContainer::operator!=(const TermsContainer &tc) const
+// appends cubes of the complement of saved terms and saved dont cares to v
+template <typename S>
+void BasicTermsContainer<S>::complementCubes(vector<term_type> &v) const
 {
-    return !operator==(tc);
+    BasicEspressoCover<S> f(termVarsCount), d(termVarsCount), r(termVarsCount);
+    for (unsigned i = 0; i < termsVector->size(); i++) {
+        const term_type &t = termsVector->at(i);
+        if (t.isDC()) {
+            d.add(t);
+            v.push_back(t);
+        }
+        else
+            f.add(t);
+    }
+    EspressoEngine<S> engine(termVarsCount);
+    engine.complement(f, d, r);
+    for (unsigned i = 0; i < r.count(); i++)
+        v.push_back(term_type(r.getLiters(i), r.getMissing(i), termVarsCount));
 }
 
 // makes complement terms
-void TermsContainer::setComplement()
+template <typename S>
+void BasicTermsContainer<S>::setComplement()
 {
     if (changed) {
-        toBaseTerms();
-        vector<Term> *v = (ttype == MINTERMS)? termsVectorZeros: termsVectorOnes;
-        vector<Term> *complement = new vector<Term>;
+        detach();
+        vector<term_type> *v = (ttype == MINTERMS)? d->termsVectorZeros: d->termsVectorOnes;
+        vector<term_type> *complement = new vector<term_type>;
         complement->reserve(v->size());
 
-        int all = 1 << termVarsCount;
-        int tSize = static_cast<int>(termsVector->size());
-        int i;
-        for (int idx = 0; idx < all; idx++) {
-            for (i = 0; i < tSize; i++) {
-                if (termsVector->at(i).getIdx() == idx) {
-                    if (termsVector->at(i).isDC())
-                        complement->push_back(termsVector->at(i));
-                    break;
-                }
-            }
-            if (i == tSize) // not found in termsVector
-                complement->push_back(Term(idx, termVarsCount));
+        vector<uint64_t> bits, dcBits;
+        if (termsToBits(bits, dcBits)) {
+            // complement and dont cares are taken word by word
+            bitsToTerms(*complement, true, bits, dcBits);
+        }
+        else {
+            // too many variables for bitmaps - the complement is made
+            // of cubes by the unate recursive complement of saved cubes
+            complementCubes(*complement);
         }
 
         delete v;
         if (ttype == MINTERMS)
-            termsVectorZeros = complement;
+            d->termsVectorZeros = complement;
         else
-            termsVectorOnes = complement;
+            d->termsVectorOnes = complement;
 
         changed = false;
     }
 }
 
-// expandes all terms to the base term
-void TermsContainer::toBaseTerms()
-{
-    vector<Term> v;
-    v.reserve(termsVector->size());
-    for (unsigned i = 0; i < termsVector->size(); i++)
-            Term::expandTerm(v, termsVector->at(i));
-    *termsVector = vector<Term>(v.begin(), v.end());
-}
-
 // iterating initialization
-void TermsContainer::itInit()
+template <typename S>
+void BasicTermsContainer<S>::itInit()
 {
+    syncVector();
     itPos = 0;
 }
 
 // iterating next checking
-bool TermsContainer::itHasNext()
+template <typename S>
+bool BasicTermsContainer<S>::itHasNext()
 {
-    return termsVector->size() != itPos;
+    return syncVector().size() != itPos;
 }
 
 // iterating next shift
-Term &TermsContainer::itNext()
+template <typename S>
+Term &BasicTermsContainer<S>::itNext()
 {
-    return termsVector->at(itPos++);
+    current = Term(syncVector().at(itPos++));
+    return current;
 }
+
+// moves pos to the first saved term from pos and sets t to it, BIT_SET
+// positions are indices in bitmaps (the same order as bitsToTerms)
+template <typename S>
+void BasicTermsContainer<S>::fetchTerm(unsigned &pos, Term &t) const
+{
+    if (ctype != BIT_SET) {
+        if (pos < termsVector->size())
+            t = Term(termsVector->at(pos));
+        return;
+    }
+
+    const vector<uint64_t> &bits = d->bits;
+    const vector<uint64_t> &dcBits = d->dcBits;
+    unsigned w = pos / 64;
+    if (w >= bits.size())
+        return;
+
+    uint64_t b = (bits[w] | dcBits[w]) & (~uint64_t(0) << (pos % 64));
+    while (!b) {
+        if (++w == bits.size()) {
+            pos = w * 64;
+            return;
+        }
+        b = bits[w] | dcBits[w];
+    }
+    pos = w * 64 + firstOne(b);
+    t = Term(pos, termVarsCount, (dcBits[w] >> (pos % 64)) & 1);
+}
+
+// returns iterating position behind the last term
+template <typename S>
+unsigned BasicTermsContainer<S>::endPos() const
+{
+    if (ctype == BIT_SET)
+        return d->bits.size() * 64;
+    else
+        return termsVector->size();
+}
+
+// instances for all storages
+template class BasicTermsContainer<TermStorage16>;
+template class BasicTermsContainer<TermStorage32>;
+template class BasicTermsContainer<TermStorage64>;
+template class BasicTermsContainer<TermStorage128>;
+template class BasicTermsContainer<TermStorage256>;
@@ -22,112 +22,393 @@
 #define TERMSCONTAINER_H
 
 #include "term.h"
+#include "termshash.h"
+#include "termstree.h"
 
 #include <vector>
 #include <list>
+#include <iterator>
+#include <cstddef>
+#include <stdint.h>
 
 class OutputValue;
-class Term;
 
-// terms container wrapper class
+// terms container wrapper class - terms are saved in the narrowest term storage
+// for the number of variables (BasicTermsContainer), Term is used for passing them
 class TermsContainer
 {
 public:
     // terms representation
     enum TermsType { MINTERMS, MAXTERMS };
     // possible internal container types
-    enum ContainerType { STL_SET, STL_VECTOR, TERMS_TREE };
+    enum ContainerType { STL_SET, STL_VECTOR, TERMS_TREE, BIT_SET };
+    // maximal number of variables for BIT_SET (bitmaps of 2^n bits)
+    static const unsigned BIT_SET_MAX_VARS = 24;
+    // minimal number of terms for automatic switch to STL_SET
+    static const unsigned STL_SET_MIN_SIZE = 32;
 
-    // main contructor
-    TermsContainer(int varsCount, TermsType tt = MINTERMS, ContainerType ct = STL_VECTOR);
-    // copy constructor
-    TermsContainer(const TermsContainer &tc);
+    // returns new container with the narrowest storage for varsCount variables
+    static TermsContainer *create(unsigned varsCount, TermsType tt = MINTERMS,
+            ContainerType ct = STL_VECTOR);
+    // returns copy of the container (terms are shared until the first change)
+    virtual TermsContainer *clone() const = 0;
     // destructor
-    ~TermsContainer();
+    virtual ~TermsContainer() {}
 
-    // sets container
-    void setContainer(std::vector<Term> &v);
+    // sets container (terms of v are copied)
+    virtual void setContainer(std::vector<Term> &v) = 0;
+    // sets container by taking terms of v without copying (v is emptied)
+    virtual void swapContainer(std::vector<Term> &v) = 0;
     // sets terms type
-    void setTermsType(TermsType tt);
+    virtual void setTermsType(TermsType tt) = 0;
+    // returns terms type
+    inline TermsType getTermsType() const { return ttype; }
+    // sets internal container type (BIT_SET is possible only if all terms
+    // are minterms or maxterms), returns whether the type was set
+    virtual bool setContainerType(ContainerType ct) = 0;
+    // returns internal container type
+    inline ContainerType getContainerType() const { return ctype; }
+    // returns number of variables of saved terms
+    inline unsigned getVarsCount() const { return termVarsCount; }
 
     // returns the number of elements in the container
-    unsigned getSize() const;
+    virtual unsigned getSize() const = 0;
 
     // sets changing flat
     void touch() { changed = true; }
     // pushes term t to the container
-    bool pushTerm(const Term &t);
+    virtual bool pushTerm(const Term &t) = 0;
     // pushes new term to the container by idx
-    bool pushTerm(int idx, bool isDC = false);
+    virtual bool pushTerm(int idx, bool isDC = false) = 0;
     // removes term t from the container
-    bool removeTerm(const Term &t);
+    virtual bool removeTerm(const Term &t) = 0;
     // removes term from the container by idx
-    bool removeTerm(int idx);
+    virtual bool removeTerm(int idx) = 0;
     // finds out whether term t is in the container
-    bool hasTerm(const Term &t) const;
+    virtual bool hasTerm(const Term &t) const = 0;
+    // finds out whether some term in the container contains term t
+    virtual bool hasCover(const Term &t) const = 0;
+    // returns terms which intersect term t
+    virtual std::vector<Term> &getIntersecting(const Term &t, std::vector<Term> &terms) const = 0;
     // sets value of the term with idx to val
     bool setTermValue(int idx, OutputValue val);
     // sets value of the term t to val
     bool setTermValue(const Term &t, OutputValue val);
     // returns value of the term with idx
-    OutputValue getTermValue(int idx) const;
+    virtual OutputValue getTermValue(int idx) const = 0;
     // returns term at the position pos
-    const Term &at(unsigned pos) const;
+    virtual Term at(unsigned pos) const = 0;
 
     // returns terms id for terms with value equal to val
     std::vector<int> getTermsIdx(int val);
     // returns terms id for terms with value equal to val (copies result to idxs)
-    std::vector<int> &getTermsIdx(int val, std::vector<int> &idxs);
+    virtual std::vector<int> &getTermsIdx(int val, std::vector<int> &idxs) = 0;
     // returns actual terms
     std::vector<Term> getTerms();
     // returns actual terms (copies result to idxs)
-    std::vector<Term> &getTerms(std::vector<Term> &terms);
+    virtual std::vector<Term> &getTerms(std::vector<Term> &terms) = 0;
     // returns actual minterms
     std::vector<Term> getMinterms();
     // returns actual minterms (copies result to idxs)
-    std::vector<Term> &getMinterms(std::vector<Term> &minterms);
+    virtual std::vector<Term> &getMinterms(std::vector<Term> &minterms) = 0;
     // returns actual maxterms
     std::vector<Term> getMaxterms();
     // returns actual maxterms (copies result to idxs)
-    std::vector<Term> &getMaxterms(std::vector<Term> &minterms);
+    virtual std::vector<Term> &getMaxterms(std::vector<Term> &minterms) = 0;
     // returns on-set, off-set and dc-set covers
     void getCovers(std::list<Term> &f, std::list<Term> &d, std::list<Term> &r);
+    // returns saved cubes without expanding - on-set (off-set for maxterms) and dc-set
+    virtual void getCubes(std::list<Term> &c, std::list<Term> &d) const = 0;
 
     // removes all terms from the container
-    void clear();
+    virtual void clear() = 0;
 
     // equality
-    bool operator==(const TermsContainer &tc) const;
+    virtual bool operator==(const TermsContainer &tc) const = 0;
     // nonequality
     bool operator!=(const TermsContainer &tc) const;
-    // assignment
-    TermsContainer &operator=(const TermsContainer &tc);
 
     // iterating initialization
-    void itInit();
+    virtual void itInit() = 0;
     // iterating next checking
+    virtual bool itHasNext() = 0;
+    // iterating next shift (changes of the term aren't saved to the container)
+    virtual Term &itNext() = 0;
+
+    // read-only iterator over the terms - it doesn't change the container,
+    // so more iterators can be used at once (even from more threads)
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Term value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Term *pointer;
+        typedef const Term &reference;
+
+        const_iterator() : tc(0), pos(0) {}
+
+        inline reference operator*() const { return term; }
+        inline pointer operator->() const { return &term; }
+
+        inline const_iterator &operator++()
+        {
+            tc->fetchTerm(++pos, term);
+            return *this;
+        }
+        inline const_iterator operator++(int)
+        {
+            const_iterator it(*this);
+            operator++();
+            return it;
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return tc == it.tc && pos == it.pos;
+        }
+        inline bool operator!=(const const_iterator &it) const { return !operator==(it); }
+
+    private:
+        const_iterator(const TermsContainer *c, unsigned p) : tc(c), pos(p)
+        {
+            tc->fetchTerm(pos, term);
+        }
+
+        const TermsContainer *tc;
+        // position in the terms vector or index in bitmaps
+        unsigned pos;
+        // actual term converted from the storage of the container
+        Term term;
+
+        friend class TermsContainer;
+    };
+
+    // returns iterator to the first term
+    inline const_iterator begin() const { return const_iterator(this, 0); }
+    // returns iterator behind the last term
+    inline const_iterator end() const { return const_iterator(this, endPos()); }
+
+    // read-only iterator over minterms (maxterms) of the saved terms - cubes
+    // are expanded one by one (nothing is allocated), minterms keep flags of
+    // their cube and minterms of overlapping cubes are repeated
+    class minterm_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Term value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Term *pointer;
+        typedef const Term &reference;
+
+        minterm_iterator() {}
+
+        inline reference operator*() const { return *mt; }
+        inline pointer operator->() const { return &*mt; }
+        // returns index of the actual minterm
+        inline int idx() const { return mt.idx(); }
+
+        inline minterm_iterator &operator++()
+        {
+            if (++mt == Term::minterm_iterator() && ++it != last)
+                mt = it->mintermsBegin();
+            return *this;
+        }
+        inline minterm_iterator operator++(int)
+        {
+            minterm_iterator m(*this);
+            operator++();
+            return m;
+        }
+
+        inline bool operator==(const minterm_iterator &m) const
+        {
+            return it == m.it && (it == last || mt == m.mt);
+        }
+        inline bool operator!=(const minterm_iterator &m) const { return !operator==(m); }
+
+    private:
+        minterm_iterator(const const_iterator &first, const const_iterator &l) : it(first), last(l)
+        {
+            if (it != last)
+                mt = it->mintermsBegin();
+        }
+
+        // actual term and the end of terms
+        const_iterator it;
+        const_iterator last;
+        // actual minterm of the term
+        Term::minterm_iterator mt;
+
+        friend class TermsContainer;
+    };
+
+    // returns iterator to the first minterm (maxterm) of the saved terms
+    inline minterm_iterator mintermsBegin() const { return minterm_iterator(begin(), end()); }
+    // returns iterator behind the last minterm (maxterm) of the saved terms
+    inline minterm_iterator mintermsEnd() const { return minterm_iterator(end(), end()); }
+
+protected:
+    TermsContainer(unsigned varsCount, TermsType tt, ContainerType ct);
+    TermsContainer(const TermsContainer &tc);
+
+    // moves pos to the first saved term from pos and sets t to it
+    // (t isn't changed at the end)
+    virtual void fetchTerm(unsigned &pos, Term &t) const = 0;
+    // returns iterating position behind the last term
+    virtual unsigned endPos() const = 0;
+
+    TermsType ttype;
+    ContainerType ctype;
+    unsigned termVarsCount;
+    bool changed;
+
+private:
+    TermsContainer &operator=(const TermsContainer &tc);
+};
+
+// terms container with terms in the storage S
+template <typename S>
+class BasicTermsContainer : public TermsContainer
+{
+public:
+    typedef BasicTerm<S> term_type;
+
+    // main contructor
+    BasicTermsContainer(unsigned varsCount, TermsType tt = MINTERMS, ContainerType ct = STL_VECTOR);
+    // copy constructor
+    BasicTermsContainer(const BasicTermsContainer &tc);
+    // destructor
+    ~BasicTermsContainer();
+
+    TermsContainer *clone() const;
+
+    void setContainer(std::vector<Term> &v);
+    void swapContainer(std::vector<Term> &v);
+    void setTermsType(TermsType tt);
+    bool setContainerType(ContainerType ct);
+
+    unsigned getSize() const;
+
+    bool pushTerm(const Term &t);
+    bool pushTerm(int idx, bool isDC = false);
+    bool removeTerm(const Term &t);
+    bool removeTerm(int idx);
+    bool hasTerm(const Term &t) const;
+    bool hasCover(const Term &t) const;
+    std::vector<Term> &getIntersecting(const Term &t, std::vector<Term> &terms) const;
+    OutputValue getTermValue(int idx) const;
+    Term at(unsigned pos) const;
+
+    std::vector<int> &getTermsIdx(int val, std::vector<int> &idxs);
+    std::vector<Term> &getTerms(std::vector<Term> &terms);
+    std::vector<Term> &getMinterms(std::vector<Term> &minterms);
+    std::vector<Term> &getMaxterms(std::vector<Term> &minterms);
+    void getCubes(std::list<Term> &c, std::list<Term> &d) const;
+
+    void clear();
+
+    bool operator==(const TermsContainer &tc) const;
+
+    void itInit();
     bool itHasNext();
-    // iterating next shift
     Term &itNext();
 
+protected:
+    void fetchTerm(unsigned &pos, Term &t) const;
+    unsigned endPos() const;
+
 private:
+    // terms data shared by copies of the container until the first change
+    struct Data
+    {
+        Data(unsigned varsCount);
+        Data(const Data &data);
+        ~Data();
+
+        std::vector<term_type> *termsVectorOnes;
+        std::vector<term_type> *termsVectorZeros;
+
+        // STL_SET - positions of terms in the terms vector
+        BasicTermsHash<S> index;
+        // TERMS_TREE - positions of terms in the terms vector
+        BasicTermsTree<S> tree;
+
+        // BIT_SET - bitmaps of saved terms (without dont cares) and dont care terms
+        std::vector<uint64_t> bits;
+        std::vector<uint64_t> dcBits;
+
+        // number of containers sharing the data
+        unsigned refs;
+
+    private:
+        Data &operator=(const Data &data);
+    };
+
+    BasicTermsContainer &operator=(const BasicTermsContainer &tc);
+
+    // makes own copy of the shared data (has to be called before every change),
+    // the container is emptied instead if copyData isn't set
+    void detach(bool copyData = true);
+    // releases the shared data
+    void release();
+
     // makes complement terms
     void setComplement();
-    // expandes all terms to the base term
-    void toBaseTerms();
-    // internal copying
-    void copy(const TermsContainer &tc);
+    // appends cubes of the complement and dont cares to v (for functions
+    // with too many variables for bitmaps)
+    void complementCubes(std::vector<term_type> &v) const;
 
-    std::vector<Term> *termsVectorOnes;
-    std::vector<Term> *termsVectorZeros;
-    std::vector<Term> *termsVector;
+    // switches to STL_SET if the terms vector is big or to BIT_SET if it is dense
+    void checkType();
+    // rebuilds STL_SET or TERMS_TREE index of the terms vector
+    void buildIndex();
+    // returns position of term t in the terms vector or -1
+    int findTerm(const term_type &t) const;
+    // removes term at position pos from the terms vector
+    void eraseTerm(unsigned pos);
+    // moves terms to bitmaps, returns false if some term isn't minterm
+    bool toBitSet();
+    // moves terms from bitmaps to terms vector
+    void toVector();
+    // returns terms vector, for BIT_SET it's rebuilt from bitmaps to the own
+    // vector of the container (shared data aren't changed), terms are ordered
+    // by index, so the insertion order isn't kept in BIT_SET
+    const std::vector<term_type> &syncVector() const;
+    // appends terms from bitmaps (complement of the saved terms if complement is set)
+    template <typename T> void bitsToTerms(std::vector<T> &v, bool complement) const;
+    template <typename T> void bitsToTerms(std::vector<T> &v, bool complement,
+            const std::vector<uint64_t> &bits, const std::vector<uint64_t> &dcBits) const;
+    // sets bitmaps to minterms of the terms vector, returns false if there
+    // are too many variables
+    bool termsToBits(std::vector<uint64_t> &bits, std::vector<uint64_t> &dcBits) const;
+    // returns index of term t in bitmaps or -1 if t isn't minterm
+    int bitIdx(const term_type &t) const;
+    // whether idx is a position in bitmaps
+    inline bool isBitIdx(int idx) const
+    {
+        return idx >= 0 && static_cast<unsigned>(idx) < (1u << termVarsCount);
+    }
 
-    TermsType ttype;
-    ContainerType ctype;
-    unsigned termVarsCount;
-    bool changed;
+    // shared data
+    Data *d;
+    // actual terms vector (ones or zeros in data)
+    std::vector<term_type> *termsVector;
+
+    // BIT_SET - number of terms in bitmaps
+    unsigned bitsCount;
+    // BIT_SET - terms of bitmaps for access by position and whether they are actual
+    mutable std::vector<term_type> bitsTerms;
+    mutable bool bitsSynced;
+
+    // whether the container type is switched automatically by size and density
+    bool autoType;
+    // size of terms vector when the density is checked next time
+    unsigned denseCheck;
 
     unsigned itPos;
+    // term returned by itNext
+    Term current;
 };
 
 #endif // TERMSCONTAINER_H
@@ -0,0 +1,173 @@
+/*
+ * termshash.cpp - open addressing hash index of terms
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "termshash.h"
+
+#include <vector>
+#include <stdint.h>
+using namespace std;
+
+template <typename S>
+BasicTermsHash<S>::BasicTermsHash(unsigned n)
+{
+    mask = 0;
+    size = 0;
+    // the table is allocated by the first insertion
+    if (n > 0)
+        reserve(n);
+}
+
+// removes all terms (capacity is kept)
+template <typename S>
+void BasicTermsHash<S>::clear()
+{
+    for (unsigned i = 0; i < table.size(); i++)
+        table[i].value = NONE;
+    size = 0;
+}
+
+// prepares the index for n terms (load factor is at most 1/2)
+template <typename S>
+void BasicTermsHash<S>::reserve(unsigned n)
+{
+    unsigned capacity = 16;
+    while (capacity < 2 * n)
+        capacity *= 2;
+    if (capacity > table.size())
+        rehash(capacity);
+}
+
+// returns hash of the key (missing liters are ignored)
+template <typename S>
+uint64_t BasicTermsHash<S>::hash(const bits_t &liters, const bits_t &missing)
+{
+    bits_t l = liters & ~missing;
+    uint64_t h = 0;
+    for (unsigned i = 0; i < l.words64(); i++) {
+        h = (h ^ l.getWord64(i)) * 0x9e3779b97f4a7c15ULL;
+        h = (h ^ missing.getWord64(i)) * 0xc2b2ae3d27d4eb4fULL;
+    }
+    return h ^ (h >> 32);
+}
+
+// returns position of the key in the table or -1 if it isn't there
+template <typename S>
+int BasicTermsHash<S>::lookup(const bits_t &liters, const bits_t &missing) const
+{
+    if (size == 0)
+        return -1;
+
+    bits_t l = liters & ~missing;
+    for (unsigned i = unsigned(hash(liters, missing)) & mask; table[i].value != NONE; i = (i + 1) & mask) {
+        if (table[i].missing == missing && table[i].liters == l)
+            return i;
+    }
+    return -1;
+}
+
+// returns value of term or NONE if it isn't in the index
+template <typename S>
+int BasicTermsHash<S>::find(const bits_t &liters, const bits_t &missing) const
+{
+    int pos = lookup(liters, missing);
+    return (pos < 0)? NONE: table[pos].value;
+}
+
+// inserts term with value, returns false if it is already in the index
+template <typename S>
+bool BasicTermsHash<S>::insert(const bits_t &liters, const bits_t &missing, int value)
+{
+    if (2 * (size + 1) > table.size())
+        rehash(table.size() * 2);
+
+    bits_t l = liters & ~missing;
+    unsigned i = unsigned(hash(liters, missing)) & mask;
+    for (; table[i].value != NONE; i = (i + 1) & mask) {
+        if (table[i].missing == missing && table[i].liters == l)
+            return false;
+    }
+    table[i].liters = l;
+    table[i].missing = missing;
+    table[i].value = value;
+    size++;
+    return true;
+}
+
+// sets value of term, returns false if it isn't in the index
+template <typename S>
+bool BasicTermsHash<S>::update(const bits_t &liters, const bits_t &missing, int value)
+{
+    int pos = lookup(liters, missing);
+    if (pos < 0)
+        return false;
+    table[pos].value = value;
+    return true;
+}
+
+// removes term, returns false if it isn't in the index
+template <typename S>
+bool BasicTermsHash<S>::remove(const bits_t &liters, const bits_t &missing)
+{
+    int pos = lookup(liters, missing);
+    if (pos < 0)
+        return false;
+
+    // backward shift of the following entries (no tombstones are needed)
+    unsigned hole = pos;
+    for (unsigned i = (hole + 1) & mask; table[i].value != NONE; i = (i + 1) & mask) {
+        unsigned home = unsigned(hash(table[i].liters, table[i].missing)) & mask;
+        // entry can be moved if its home isn't in the cyclic interval (hole, i]
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            table[hole] = table[i];
+            hole = i;
+        }
+    }
+    table[hole].value = NONE;
+    size--;
+    return true;
+}
+
+// rebuilds the table with capacity entries
+template <typename S>
+void BasicTermsHash<S>::rehash(unsigned capacity)
+{
+    if (capacity < 16)
+        capacity = 16;
+
+    vector<Entry> old;
+    old.swap(table);
+    Entry empty;
+    empty.value = NONE;
+    table.assign(capacity, empty);
+    mask = capacity - 1;
+    size = 0;
+
+    for (unsigned i = 0; i < old.size(); i++) {
+        if (old[i].value != NONE)
+            insert(old[i].liters, old[i].missing, old[i].value);
+    }
+}
+
+// instances for all storages
+template class BasicTermsHash<TermStorage16>;
+template class BasicTermsHash<TermStorage32>;
+template class BasicTermsHash<TermStorage64>;
+template class BasicTermsHash<TermStorage128>;
+template class BasicTermsHash<TermStorage256>;
@@ -0,0 +1,92 @@
+/*
+ * termshash.h - open addressing hash index of terms
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TERMSHASH_H
+#define TERMSHASH_H
+
+#include "term.h"
+
+#include <vector>
+#include <stdint.h>
+
+// open addressing (linear probing) hash index of terms - the key is pair
+// of liters and missings of the term (flags are ignored), value is an integer
+template <typename S>
+class BasicTermsHash
+{
+public:
+    typedef BasicTerm<S> term_type;
+    typedef typename S::bits_t bits_t;
+
+    // value of not found term
+    static const int NONE = -1;
+
+    BasicTermsHash(unsigned n = 0);
+
+    // returns the number of terms in the index
+    inline unsigned getSize() const { return size; }
+    // removes all terms (capacity is kept)
+    void clear();
+    // prepares the index for n terms
+    void reserve(unsigned n);
+
+    // returns value of term t or NONE if t isn't in the index
+    inline int find(const term_type &t) const { return find(t.getLiters(), t.getMissing()); }
+    int find(const bits_t &liters, const bits_t &missing) const;
+    // inserts term t with value, returns false if t is already in the index
+    inline bool insert(const term_type &t, int value)
+    {
+        return insert(t.getLiters(), t.getMissing(), value);
+    }
+    bool insert(const bits_t &liters, const bits_t &missing, int value);
+    // sets value of term t, returns false if t isn't in the index
+    inline bool update(const term_type &t, int value)
+    {
+        return update(t.getLiters(), t.getMissing(), value);
+    }
+    bool update(const bits_t &liters, const bits_t &missing, int value);
+    // removes term t, returns false if t isn't in the index
+    inline bool remove(const term_type &t) { return remove(t.getLiters(), t.getMissing()); }
+    bool remove(const bits_t &liters, const bits_t &missing);
+
+private:
+    struct Entry
+    {
+        bits_t liters;
+        bits_t missing;
+        int value;
+    };
+
+    // returns hash of the key
+    static uint64_t hash(const bits_t &liters, const bits_t &missing);
+    // returns position of the key in the table or -1 if it isn't there
+    int lookup(const bits_t &liters, const bits_t &missing) const;
+    // rebuilds the table with capacity entries
+    void rehash(unsigned capacity);
+
+    std::vector<Entry> table;
+    unsigned mask;
+    unsigned size;
+};
+
+// hash index with the term storage
+typedef BasicTermsHash<Term::storage_type> TermsHash;
+
+#endif // TERMSHASH_H
@@ -19,6 +19,7 @@
  */
 
 #include "termssortinglist.h"
+#include "literalvalue.h"
 
 #include <list>
 #include <vector>
@@ -32,13 +33,12 @@ TermsSortingItem::TermsSortingItem()
 
 TermsSortingItem::TermsSortingItem(const Term *term) : Term(*term)
 {
-    vector<int> v;
-    Term::expandTerm(v, *term);
-    isize = v.size();
+    isize = 1u << term->valuesCount(LiteralValue::MISSING);
     indexes = new int[isize];
-    for (unsigned i = 0; i < isize; i++) {
-        indexes[i] = v[i];
-    }
+    // indexes in descending order
+    unsigned i = isize;
+    for (Term::minterm_iterator it = term->mintermsBegin(); it != term->mintermsEnd(); ++it)
+        indexes[--i] = it.idx();
 }
 
 TermsSortingItem::TermsSortingItem(const TermsSortingItem &tsi) : Term(tsi)
@@ -0,0 +1,273 @@
+/*
+ * termstorage.h - storage policies for Term class
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TERMSTORAGE_H
+#define TERMSTORAGE_H
+
+#include <stdint.h>
+
+// bit vector of fixed width (N words of type W) used for liters and missings
+template <typename W, unsigned N>
+class TermBits
+{
+public:
+    typedef W word_t;
+    static const unsigned WORDS = N;
+    static const unsigned WORD_BITS = sizeof(W) * 8;
+    static const unsigned BITS = N * WORD_BITS;
+
+    // constructor - empty bits
+    TermBits() { for (unsigned i = 0; i < N; i++) words[i] = 0; }
+    // constructor - the lowest bits are set by v
+    TermBits(uint64_t v) { setLow(v); }
+    // constructor - conversion from another width (extra bits are lost)
+    template <typename W2, unsigned N2>
+    explicit TermBits(const TermBits<W2, N2> &b)
+    {
+        for (unsigned i = 0; i < N; i++)
+            words[i] = 0;
+        for (unsigned i = 0; i < b.words64() && i < words64(); i++)
+            setWord64(i, b.getWord64(i));
+    }
+
+    // returns bits with the first size positions set
+    static TermBits full(unsigned size)
+    {
+        TermBits b;
+        for (unsigned i = 0; i < N; i++, size = (size > WORD_BITS)? size - WORD_BITS: 0)
+            b.words[i] = (size >= WORD_BITS)? W(~W(0)): W((W(1) << size) - 1);
+        return b;
+    }
+    // returns bits with only one position set
+    static TermBits bit(unsigned pos)
+    {
+        TermBits b;
+        b.set(pos);
+        return b;
+    }
+
+    // whether position pos is set
+    inline bool test(unsigned pos) const
+    {
+        return (words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+    }
+    // sets position pos to value
+    inline void set(unsigned pos, bool value = true)
+    {
+        W mask = W(W(1) << (pos % WORD_BITS));
+        if (value)
+            words[pos / WORD_BITS] |= mask;
+        else
+            words[pos / WORD_BITS] &= W(~mask);
+    }
+    // whether some position is set
+    inline bool any() const
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (words[i])
+                return true;
+        }
+        return false;
+    }
+    // whether no position is set
+    inline bool none() const { return !any(); }
+    // returns number of set positions
+    unsigned count() const
+    {
+        unsigned c = 0;
+        for (unsigned i = 0; i < N; i++)
+            c += popCount(words[i]);
+        return c;
+    }
+    // returns the first set position or -1 if there is no one
+    int first() const
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (words[i])
+                return i * WORD_BITS + firstOne(words[i]);
+        }
+        return -1;
+    }
+    // returns the lowest 64 bits
+    inline uint64_t low() const { return getWord64(0); }
+
+    // access by 64 bits chunks (for conversion and hashing)
+    inline unsigned words64() const { return (BITS + 63) / 64; }
+    uint64_t getWord64(unsigned idx) const
+    {
+        if (WORD_BITS >= 64)
+            return uint64_t(words[idx]);
+        uint64_t v = 0;
+        unsigned per = 64 / WORD_BITS;
+        for (unsigned i = 0; i < per && idx * per + i < N; i++)
+            v |= uint64_t(words[idx * per + i]) << (i * WORD_BITS);
+        return v;
+    }
+    void setWord64(unsigned idx, uint64_t v)
+    {
+        if (WORD_BITS >= 64) {
+            words[idx] = W(v);
+            return;
+        }
+        unsigned per = 64 / WORD_BITS;
+        for (unsigned i = 0; i < per && idx * per + i < N; i++)
+            words[idx * per + i] = W(v >> (i * WORD_BITS));
+    }
+
+    // word access
+    inline W word(unsigned idx) const { return words[idx]; }
+
+    // bit operators
+    inline TermBits operator&(const TermBits &b) const { TermBits r(*this); return r &= b; }
+    inline TermBits operator|(const TermBits &b) const { TermBits r(*this); return r |= b; }
+    inline TermBits operator^(const TermBits &b) const { TermBits r(*this); return r ^= b; }
+    inline TermBits operator~() const
+    {
+        TermBits r;
+        for (unsigned i = 0; i < N; i++)
+            r.words[i] = W(~words[i]);
+        return r;
+    }
+    inline TermBits &operator&=(const TermBits &b)
+    {
+        for (unsigned i = 0; i < N; i++)
+            words[i] &= b.words[i];
+        return *this;
+    }
+    inline TermBits &operator|=(const TermBits &b)
+    {
+        for (unsigned i = 0; i < N; i++)
+            words[i] |= b.words[i];
+        return *this;
+    }
+    inline TermBits &operator^=(const TermBits &b)
+    {
+        for (unsigned i = 0; i < N; i++)
+            words[i] ^= b.words[i];
+        return *this;
+    }
+
+    // comparing
+    inline bool operator==(const TermBits &b) const
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (words[i] != b.words[i])
+                return false;
+        }
+        return true;
+    }
+    inline bool operator!=(const TermBits &b) const { return !operator==(b); }
+    inline bool operator<(const TermBits &b) const
+    {
+        for (unsigned i = N; i > 0; i--) {
+            if (words[i - 1] != b.words[i - 1])
+                return words[i - 1] < b.words[i - 1];
+        }
+        return false;
+    }
+
+private:
+    inline void setLow(uint64_t v)
+    {
+        for (unsigned i = 0; i < N; i++)
+            words[i] = 0;
+        setWord64(0, v);
+    }
+
+    static inline unsigned popCount(W w)
+    {
+#ifdef __GNUC__
+        return __builtin_popcountll(uint64_t(w));
+#else
+        unsigned c = 0;
+        for (; w; c++)
+            w &= W(w - 1);
+        return c;
+#endif
+    }
+
+    static inline unsigned firstOne(W w)
+    {
+#ifdef __GNUC__
+        return __builtin_ctzll(uint64_t(w));
+#else
+        unsigned pos = 0;
+        while (!(w & 1)) {
+            w >>= 1;
+            pos++;
+        }
+        return pos;
+#endif
+    }
+
+    W words[N];
+};
+
+// packed storage for functions with at most 16 variables
+struct TermStorage16
+{
+    typedef TermBits<uint16_t, 1> bits_t;
+    typedef uint8_t size_type;
+    typedef uint16_t flags_type;
+    static const unsigned MAX_SIZE = 16;
+};
+
+// storage for functions with at most 32 variables
+struct TermStorage32
+{
+    typedef TermBits<uint32_t, 1> bits_t;
+    typedef uint8_t size_type;
+    typedef uint16_t flags_type;
+    static const unsigned MAX_SIZE = 32;
+};
+
+// multi-word storage for functions with at most N * 64 variables
+template <unsigned N>
+struct TermStorageWide
+{
+    typedef TermBits<uint64_t, N> bits_t;
+    typedef uint16_t size_type;
+    typedef uint16_t flags_type;
+    static const unsigned MAX_SIZE = N * 64;
+};
+
+typedef TermStorageWide<1> TermStorage64;
+typedef TermStorageWide<2> TermStorage128;
+typedef TermStorageWide<4> TermStorage256;
+
+// storage width needed for the number of variables
+enum TermWidth { TW_16, TW_32, TW_64, TW_128, TW_256 };
+
+// returns the narrowest storage width for vc variables
+inline TermWidth getTermWidth(unsigned vc)
+{
+    if (vc <= TermStorage16::MAX_SIZE)
+        return TW_16;
+    else if (vc <= TermStorage32::MAX_SIZE)
+        return TW_32;
+    else if (vc <= TermStorage64::MAX_SIZE)
+        return TW_64;
+    else if (vc <= TermStorage128::MAX_SIZE)
+        return TW_128;
+    else
+        return TW_256;
+}
+
+#endif // TERMSTORAGE_H
@@ -1,30 +1,231 @@
+/*
+ * termstree.cpp - ternary tree (trie) of terms
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
 #include "termstree.h"
 
+#include <vector>
+#include <utility>
+using namespace std;
+
 TermsItem::TermsItem()
 {
-    p = zero = one = 0;
-    term = 0;
-    depth = 0;
-    flags = 0;
+    next[ZERO] = next[ONE] = next[MISSING] = 0;
+    value = -1;
+}
+
+template <typename S>
+BasicTermsTree<S>::BasicTermsTree(unsigned vc)
+{
+    varsCount = vc;
+    clear();
+}
+
+// removes all terms
+template <typename S>
+void BasicTermsTree<S>::clear()
+{
+    items.assign(1, TermsItem());
+    freeItems.clear();
+    size = 0;
+}
+
+// returns index of new node
+template <typename S>
+unsigned BasicTermsTree<S>::newItem()
+{
+    if (freeItems.empty()) {
+        items.push_back(TermsItem());
+        return items.size() - 1;
+    }
+    unsigned item = freeItems.back();
+    freeItems.pop_back();
+    items[item] = TermsItem();
+    return item;
+}
+
+// returns leaf of term t or 0
+template <typename S>
+unsigned BasicTermsTree<S>::findLeaf(const term_type &t) const
+{
+    unsigned item = 0;
+    for (unsigned pos = 0; pos < varsCount; pos++) {
+        if (!(item = items[item].next[branch(t, pos)]))
+            return 0;
+    }
+    return item;
+}
+
+// returns value of term t or NONE if t isn't in the tree
+template <typename S>
+int BasicTermsTree<S>::find(const term_type &t) const
+{
+    if (size == 0)
+        return NONE;
+    unsigned leaf = findLeaf(t);
+    return (leaf || varsCount == 0)? items[leaf].value: NONE;
+}
+
+// inserts term t with value, returns false if t is already in the tree
+template <typename S>
+bool BasicTermsTree<S>::insert(const term_type &t, int value)
+{
+    unsigned item = 0;
+    for (unsigned pos = 0; pos < varsCount; pos++) {
+        unsigned b = branch(t, pos);
+        if (!items[item].next[b]) {
+            // newItem can reallocate items
+            unsigned child = newItem();
+            items[item].next[b] = child;
+        }
+        item = items[item].next[b];
+    }
+    if (items[item].value != NONE)
+        return false;
+    items[item].value = value;
+    size++;
+    return true;
+}
+
+// sets value of term t, returns false if t isn't in the tree
+template <typename S>
+bool BasicTermsTree<S>::update(const term_type &t, int value)
+{
+    unsigned leaf = findLeaf(t);
+    if ((!leaf && varsCount > 0) || items[leaf].value == NONE)
+        return false;
+    items[leaf].value = value;
+    return true;
 }
 
-TermsItem::TermsItem(TermsItem *p, Term *t) : parent(p)
+// removes term t, returns false if t isn't in the tree
+template <typename S>
+bool BasicTermsTree<S>::remove(const term_type &t)
 {
-    zero = one = 0;
-    depth = p->depth() + 1;
-    term = t;
-    flags = t? TI_OCCUPIED: 0;
+    vector<unsigned> path(varsCount + 1, 0);
+    for (unsigned pos = 0; pos < varsCount; pos++) {
+        if (!(path[pos + 1] = items[path[pos]].next[branch(t, pos)]))
+            return false;
+    }
+    if (items[path[varsCount]].value == NONE)
+        return false;
+    items[path[varsCount]].value = NONE;
+    size--;
+
+    // empty nodes are unlinked from the leaf to the root
+    for (unsigned pos = varsCount; pos > 0; pos--) {
+        const TermsItem &item = items[path[pos]];
+        if (item.next[TermsItem::ZERO] || item.next[TermsItem::ONE]
+                || item.next[TermsItem::MISSING] || item.value != NONE)
+            break;
+        items[path[pos - 1]].next[branch(t, pos - 1)] = 0;
+        freeItems.push_back(path[pos]);
+    }
+    return true;
 }
 
-void TermsItem::setTerm(Term *t)
+// searches the tree, returns the number of found values (stops by the first if first is set)
+template <typename S>
+unsigned BasicTermsTree<S>::search(const term_type &t, Query q, vector<int> &values, bool first) const
 {
-    term = t;
-    if (t)
-        enableOccupied();
+    if (size == 0)
+        return 0;
+
+    unsigned found = 0;
+    // pairs of node and its depth
+    vector<pair<unsigned, unsigned> > stack;
+    stack.push_back(make_pair(0u, 0u));
+    while (!stack.empty()) {
+        unsigned item = stack.back().first;
+        unsigned pos = stack.back().second;
+        stack.pop_back();
+
+        if (pos == varsCount) {
+            if (items[item].value != NONE) {
+                values.push_back(items[item].value);
+                found++;
+                if (first)
+                    break;
+            }
+            continue;
+        }
+
+        const unsigned *next = items[item].next;
+        unsigned b = branch(t, pos);
+        if (b == TermsItem::MISSING) {
+            // containing terms have to miss the variable too
+            if (q != CONTAINING) {
+                if (next[TermsItem::ZERO])
+                    stack.push_back(make_pair(next[TermsItem::ZERO], pos + 1));
+                if (next[TermsItem::ONE])
+                    stack.push_back(make_pair(next[TermsItem::ONE], pos + 1));
+            }
+            if (next[TermsItem::MISSING])
+                stack.push_back(make_pair(next[TermsItem::MISSING], pos + 1));
+        }
+        else {
+            if (next[b])
+                stack.push_back(make_pair(next[b], pos + 1));
+            // contained terms can't miss the variable
+            if (q != CONTAINED && next[TermsItem::MISSING])
+                stack.push_back(make_pair(next[TermsItem::MISSING], pos + 1));
+        }
+    }
+    return found;
 }
 
-TermsTree::TermsTree(int depth)
+// returns value of some term which contains t or NONE
+template <typename S>
+int BasicTermsTree<S>::findContaining(const term_type &t) const
 {
-    root = new TermsItem;
-    maxDepth = depth;
+    vector<int> values;
+    return search(t, CONTAINING, values, true)? values.back(): NONE;
 }
+
+// appends values of all terms which contain t
+template <typename S>
+vector<int> &BasicTermsTree<S>::findContaining(const term_type &t, vector<int> &values) const
+{
+    search(t, CONTAINING, values, false);
+    return values;
+}
+
+// appends values of all terms which intersect t
+template <typename S>
+vector<int> &BasicTermsTree<S>::findIntersecting(const term_type &t, vector<int> &values) const
+{
+    search(t, INTERSECTING, values, false);
+    return values;
+}
+
+// appends values of all terms which are contained in t
+template <typename S>
+vector<int> &BasicTermsTree<S>::findContained(const term_type &t, vector<int> &values) const
+{
+    search(t, CONTAINED, values, false);
+    return values;
+}
+
+// instances for all storages
+template class BasicTermsTree<TermStorage16>;
+template class BasicTermsTree<TermStorage32>;
+template class BasicTermsTree<TermStorage64>;
+template class BasicTermsTree<TermStorage128>;
+template class BasicTermsTree<TermStorage256>;
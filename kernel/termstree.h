@@ -1,39 +1,113 @@
+/*
+ * termstree.h - ternary tree (trie) of terms
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+
 #ifndef TERMSTREE_H
 #define TERMSTREE_H
 
-#define TI_OCCUPIED 1
+#include "term.h"
 
-class TermsItem
+#include <vector>
+
+// node of the terms tree
+struct TermsItem
 {
-private:
-    int depth;
-    int flags;
-    Term *term;
+    // indices of values of the variable at the node depth
+    enum Branch { ZERO, ONE, MISSING };
 
+    TermsItem();
+
+    // children nodes by the variable value (0 if there is no child)
+    unsigned next[3];
+    // value of the term ending at the node (leaves only)
+    int value;
+};
+
+// ternary tree (trie) of terms - the node at depth d branches by the value
+// of variable d (0, 1 or missing) and leaves keep integer values of terms,
+// flags of terms are ignored
+template <typename S>
+class BasicTermsTree
+{
 public:
-    TermsItem(TermsItem *p, Term *t = 0);
+    typedef BasicTerm<S> term_type;
+    typedef typename S::bits_t bits_t;
 
-    inline int depth() { return depth; }
+    // value of not found term
+    static const int NONE = -1;
 
-    inline int isOccupied() { return flags & TI_OCCUPIED; }
-    inline int enableOccupied() { flags |= TI_OCCUPIED; }
-    inline int disableOccupied() { flags &= ~TI_OCCUPIED; }
+    BasicTermsTree(unsigned vc = 0);
 
-    inline Term *getTerm() { return term; }
-    void setTerm(Term *t);
+    // returns the number of terms in the tree
+    inline unsigned getSize() const { return size; }
+    // returns the depth of the tree
+    inline unsigned getVarsCount() const { return varsCount; }
+    // removes all terms
+    void clear();
 
-    TermsItem *parent;
-    TermsItem *zero;
-    TermsItem *one;
-};
+    // returns value of term t or NONE if t isn't in the tree
+    int find(const term_type &t) const;
+    // inserts term t with value, returns false if t is already in the tree
+    bool insert(const term_type &t, int value);
+    // sets value of term t, returns false if t isn't in the tree
+    bool update(const term_type &t, int value);
+    // removes term t, returns false if t isn't in the tree
+    bool remove(const term_type &t);
+
+    // returns value of some term which contains t or NONE
+    int findContaining(const term_type &t) const;
+    // appends values of all terms which contain t
+    std::vector<int> &findContaining(const term_type &t, std::vector<int> &values) const;
+    // appends values of all terms which intersect t
+    std::vector<int> &findIntersecting(const term_type &t, std::vector<int> &values) const;
+    // appends values of all terms which are contained in t
+    std::vector<int> &findContained(const term_type &t, std::vector<int> &values) const;
 
-class TermsTree
-{
 private:
-    TermsItem *root;
-    int maxDepth;
-public:
-    TermsTree(int depth);
+    // query types
+    enum Query { CONTAINING, INTERSECTING, CONTAINED };
+
+    // returns branch of the variable at pos in term t
+    static inline unsigned branch(const term_type &t, unsigned pos)
+    {
+        if (t.getMissing().test(pos))
+            return TermsItem::MISSING;
+        return t.getLiters().test(pos)? TermsItem::ONE: TermsItem::ZERO;
+    }
+
+    // returns leaf of term t or 0
+    unsigned findLeaf(const term_type &t) const;
+    // searches the tree, returns the number of found values (stops by the first if first is set)
+    unsigned search(const term_type &t, Query q, std::vector<int> &values, bool first) const;
+    // returns index of new node
+    unsigned newItem();
+
+    // nodes (the root is at index 0)
+    std::vector<TermsItem> items;
+    // indices of removed nodes
+    std::vector<unsigned> freeItems;
+    unsigned varsCount;
+    unsigned size;
 };
 
+// tree with the term storage
+typedef BasicTermsTree<Term::storage_type> TermsTree;
+
 #endif // TERMSTREE_H
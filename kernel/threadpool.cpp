@@ -0,0 +1,217 @@
+/*
+ * threadpool.cpp - pool of worker threads for parallel loops
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "threadpool.h"
+
+#include <vector>
+
+#ifdef BMIN_THREADS
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// preinicialize static instance
+ThreadPool *ThreadPool::s_instance = 0;
+
+// return instance of ThreadPool class
+ThreadPool *ThreadPool::instance()
+{
+    if (s_instance == 0)
+        s_instance = new ThreadPool();
+
+    return s_instance;
+}
+
+// deletes thread pool instance
+void ThreadPool::destroy()
+{
+    delete s_instance;
+    s_instance = 0;
+}
+
+#ifdef BMIN_THREADS
+
+ThreadPool::ThreadPool()
+{
+    pthread_mutex_init(&mutex, 0);
+    pthread_cond_init(&startCond, 0);
+    pthread_cond_init(&doneCond, 0);
+    task = 0;
+    next = count = active = 0;
+    generation = base = 0;
+    busy = quit = false;
+    threadsCount = 0;
+    setThreadsCount(0);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+    pthread_cond_destroy(&doneCond);
+    pthread_cond_destroy(&startCond);
+    pthread_mutex_destroy(&mutex);
+}
+
+// sets the number of threads including the calling one
+void ThreadPool::setThreadsCount(unsigned n)
+{
+    if (n == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        n = (cpus > 0)? unsigned(cpus): 1;
+    }
+    if (n == threadsCount)
+        return;
+
+    // workers are started by the next run
+    stop();
+    threadsCount = n;
+}
+
+// runs task for all indexes from 0 to n - 1
+void ThreadPool::run(ThreadTask &t, unsigned n)
+{
+    pthread_mutex_lock(&mutex);
+    bool serial = busy || threadsCount < 2 || n < 2;
+    if (!serial) {
+        busy = true;
+        if (threads.empty()) {
+            pthread_mutex_unlock(&mutex);
+            start();
+            pthread_mutex_lock(&mutex);
+        }
+        task = &t;
+        next = 0;
+        count = n;
+        active = threads.size();
+        generation++;
+        pthread_cond_broadcast(&startCond);
+    }
+    pthread_mutex_unlock(&mutex);
+
+    if (serial) {
+        for (unsigned i = 0; i < n; i++)
+            t.run(i);
+        return;
+    }
+
+    // calling thread works too
+    work();
+
+    pthread_mutex_lock(&mutex);
+    while (active > 0)
+        pthread_cond_wait(&doneCond, &mutex);
+    task = 0;
+    busy = false;
+    pthread_mutex_unlock(&mutex);
+}
+
+// worker thread entry
+void *ThreadPool::worker(void *p)
+{
+    ThreadPool *pool = static_cast<ThreadPool *>(p);
+
+    pthread_mutex_lock(&pool->mutex);
+    // generation of the pool when the worker was started
+    unsigned long seen = pool->base;
+    for (;;) {
+        while (pool->generation == seen && !pool->quit)
+            pthread_cond_wait(&pool->startCond, &pool->mutex);
+        if (pool->quit)
+            break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        pool->work();
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->active == 0)
+            pthread_cond_signal(&pool->doneCond);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return 0;
+}
+
+// runs indexes of the current task until the range is exhausted
+void ThreadPool::work()
+{
+    for (;;) {
+        pthread_mutex_lock(&mutex);
+        if (next >= count) {
+            pthread_mutex_unlock(&mutex);
+            return;
+        }
+        unsigned idx = next++;
+        ThreadTask *t = task;
+        pthread_mutex_unlock(&mutex);
+
+        t->run(idx);
+    }
+}
+
+// starts workers
+void ThreadPool::start()
+{
+    pthread_mutex_lock(&mutex);
+    quit = false;
+    base = generation;
+    pthread_mutex_unlock(&mutex);
+
+    for (unsigned i = 1; i < threadsCount; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, 0, worker, this) != 0)
+            break;
+        threads.push_back(thread);
+    }
+}
+
+// stops and joins workers
+void ThreadPool::stop()
+{
+    pthread_mutex_lock(&mutex);
+    quit = true;
+    pthread_cond_broadcast(&startCond);
+    pthread_mutex_unlock(&mutex);
+
+    for (unsigned i = 0; i < threads.size(); i++)
+        pthread_join(threads[i], 0);
+    threads.clear();
+}
+
+#else
+
+ThreadPool::ThreadPool()
+{
+    threadsCount = 1;
+}
+
+ThreadPool::~ThreadPool() {}
+
+// only one thread is available
+void ThreadPool::setThreadsCount(unsigned) {}
+
+// runs task serially
+void ThreadPool::run(ThreadTask &t, unsigned n)
+{
+    for (unsigned i = 0; i < n; i++)
+        t.run(i);
+}
+
+#endif // BMIN_THREADS
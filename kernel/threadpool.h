@@ -0,0 +1,133 @@
+/*
+ * threadpool.h - pool of worker threads for parallel loops
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+
+// threads are available only with pthreads (tasks are run serially otherwise),
+// win32 builds have no worker threads, so the parallel parts of minimizing
+// algorithms are faster only on POSIX systems
+#if !defined(BMIN_NO_THREADS) && !defined(_WIN32)
+#define BMIN_THREADS
+#include <pthread.h>
+#endif
+
+// mutual exclusion of threads (nothing is locked without threads)
+class Mutex
+{
+public:
+#ifdef BMIN_THREADS
+    Mutex() { pthread_mutex_init(&m, 0); }
+    ~Mutex() { pthread_mutex_destroy(&m); }
+    inline void lock() { pthread_mutex_lock(&m); }
+    inline void unlock() { pthread_mutex_unlock(&m); }
+#else
+    Mutex() {}
+    inline void lock() {}
+    inline void unlock() {}
+#endif
+
+private:
+    Mutex(const Mutex &);
+    Mutex &operator=(const Mutex &);
+
+#ifdef BMIN_THREADS
+    pthread_mutex_t m;
+#endif
+};
+
+// locks mutex until the end of the scope
+class MutexLocker
+{
+public:
+    explicit MutexLocker(Mutex &mx) : m(mx) { m.lock(); }
+    ~MutexLocker() { m.unlock(); }
+
+private:
+    MutexLocker(const MutexLocker &);
+    MutexLocker &operator=(const MutexLocker &);
+
+    Mutex &m;
+};
+
+// task for thread pool - run is called once for every index of the range
+class ThreadTask
+{
+public:
+    virtual ~ThreadTask() {}
+    virtual void run(unsigned idx) = 0;
+};
+
+// pool of worker threads - singleton
+class ThreadPool
+{
+public:
+    // returns instance of the ThreadPool class - singleton pattern
+    static ThreadPool *instance();
+    // deletes thread pool instance (worker threads are joined)
+    static void destroy();
+
+    // returns the number of threads including the calling one
+    unsigned getThreadsCount() const { return threadsCount; }
+    // sets the number of threads including the calling one (0 - one per processor)
+    void setThreadsCount(unsigned n);
+
+    // runs task for all indexes from 0 to n - 1 and waits for all of them,
+    // indexes are run serially if the pool is busy or has only one thread
+    void run(ThreadTask &task, unsigned n);
+
+private:
+    ThreadPool();
+    ~ThreadPool();
+
+    // static instance
+    static ThreadPool *s_instance;
+
+    unsigned threadsCount;
+
+#ifdef BMIN_THREADS
+    // worker thread entry
+    static void *worker(void *pool);
+    // runs indexes of the current task until the range is exhausted
+    void work();
+    // starts workers (threadsCount - 1)
+    void start();
+    // stops and joins workers
+    void stop();
+
+    std::vector<pthread_t> threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t startCond;
+    pthread_cond_t doneCond;
+
+    ThreadTask *task;
+    unsigned next;
+    unsigned count;
+    unsigned active;
+    unsigned long generation;
+    unsigned long base;
+    bool busy;
+    bool quit;
+#endif
+};
+
+#endif // THREADPOOL_H
@@ -23,6 +23,7 @@
 #include <QHBoxLayout>
 #include <QGridLayout>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
@@ -51,6 +52,8 @@ ControlWidget::ControlWidget(QWidget *parent) : QWidget(parent)
     connect(m_gm, SIGNAL(repreChanged(bool)), this, SLOT(setRepre(bool)));
     // changing algorithm
     connect(m_gm, SIGNAL(algorithmChanged(bool)), this, SLOT(setAlgorithm(bool)));
+    // changing covering
+    connect(m_gm, SIGNAL(coverChanged(bool)), this, SLOT(setExactCover(bool)));
 
     // emitte by changing fce
     connect(this, SIGNAL(fceChanged(const QString &)),
@@ -104,6 +107,10 @@ ControlWidget::ControlWidget(QWidget *parent) : QWidget(parent)
     repreLayout->addWidget(repreLabel);
     repreLayout->addWidget(m_repreCombo);
 
+    m_exactCheck = new QCheckBox(tr("E&xact covering"));
+    m_exactCheck->setChecked(m_gm->isExactCover());
+    connect(m_exactCheck, SIGNAL(toggled(bool)), m_gm, SLOT(setExactCover(bool)));
+
     m_algCombo = new QComboBox;
     m_algCombo->insertItem(ALG_QM_IDX, tr("Quine-McCluskey"));
     m_algCombo->insertItem(ALG_ESPRESSO_IDX, tr("Espresso"));
@@ -116,6 +123,7 @@ ControlWidget::ControlWidget(QWidget *parent) : QWidget(parent)
     algLayout->addSpacing(20);
     algLayout->addWidget(algLabel);
     algLayout->addWidget(m_algCombo);
+    algLayout->addWidget(m_exactCheck);
 
     m_minBtn = new QPushButton(tr("&Minimize"), this);
     connect(m_minBtn, SIGNAL(clicked()), m_gm, SLOT(minimizeFormula()));
@@ -208,6 +216,14 @@ void ControlWidget::setAlgorithm(bool qm)
         m_algCombo->setCurrentIndex(ALG_QM_IDX);
     else
         m_algCombo->setCurrentIndex(ALG_ESPRESSO_IDX);
+    // Espresso doesn't use covering table
+    m_exactCheck->setEnabled(qm);
+}
+
+// called by changing covering of prime implicants
+void ControlWidget::setExactCover(bool exact)
+{
+    m_exactCheck->setChecked(exact);
 }
 
 
@@ -27,6 +27,7 @@ class QLineEdit;
 class QPushButton;
 class QString;
 class QComboBox;
+class QCheckBox;
 
 class GUIManager;
 
@@ -60,6 +61,8 @@ private:
     QComboBox *m_repreCombo;
     // combo box for choosing minimizing algorithm
     QComboBox *m_algCombo;
+    // check box for exact covering of Quine-McCluskey
+    QCheckBox *m_exactCheck;
 
     // previous function
     QString m_prevFce;
@@ -82,6 +85,8 @@ public slots:
     void setRepre(bool sop);
     // called by changing minimizing algorithm
     void setAlgorithm(bool qm);
+    // called by changing covering of prime implicants
+    void setExactCover(bool exact);
 
 private slots:
     // called when QLineEdit with fce is changed
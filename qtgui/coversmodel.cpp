@@ -65,7 +65,7 @@ QVariant CoversModel::data(const QModelIndex &index, int role) const
                 form = Parser::PF_SUM;
 
             return QString::fromStdString(Parser::termToString(
-                    m_formula->getTermAt(index.row()), m_formula->getVars(), form));
+                    m_formula->getTermAt(index.row()), m_formula, form));
 
         }
         catch (std::exception &) {
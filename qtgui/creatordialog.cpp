@@ -25,6 +25,7 @@
 #include "truthtabledelegate.h"
 // kernel
 #include "formula.h"
+#include "symboltable.h"
 
 #include <QLineEdit>
 #include <QComboBox>
@@ -51,9 +52,9 @@ CreatorDialog::CreatorDialog(bool edit, QWidget *parent)
     else
         m_name = Formula::DEFAULT_NAME;
 
-    m_nameLine = new QLineEdit(QString(m_name));
+    m_nameLine = new QLineEdit(QString::fromStdString(m_name));
     m_nameLine->setMinimumWidth(20);
-    m_nameLine->setMaximumWidth(40);
+    m_nameLine->setMaximumWidth(80);
     m_nameLine->setAlignment(Qt::AlignRight);
     connect(m_nameLine, SIGNAL(editingFinished()), this, SLOT(setName()));
     QLabel *nameLabel = new QLabel(tr("Function &name: "));
@@ -83,7 +84,7 @@ CreatorDialog::CreatorDialog(bool edit, QWidget *parent)
     m_vcCombo = new QComboBox;
     m_vcCombo->setMinimumWidth(30);
     m_vcCombo->addItem(QString());
-    for (unsigned i = 1; i <= Formula::MAX_VARS; i++)
+    for (unsigned i = 1; i <= MAX_VARS; i++)
         m_vcCombo->addItem(QString::number(i));
     connect(m_vcCombo, SIGNAL(currentIndexChanged(int)), this, SLOT(setVarsCount(int)));
     QLabel *vcLabel = new QLabel(tr("Variables &count: "));
@@ -147,12 +148,13 @@ void CreatorDialog::accept()
 
 void CreatorDialog::setName()
 {
-    QString name = m_nameLine->text().trimmed();
-    if (name.length() != 1 || !name.at(0).isLetter()) {
-        showError(tr("Incorrect function name (only one character name is permitted)"));
-        m_nameLine->setText(QString(m_name));
+    string name = m_nameLine->text().trimmed().toStdString();
+    if (!SymbolTable::isValidName(name)) {
+        showError(tr("Incorrect function name (it has to start with Ascii letter)"));
+        m_nameLine->setText(QString::fromStdString(m_name));
     }
-    m_name = name.at(0).toAscii();
+    else
+        m_name = name;
 }
 
 void CreatorDialog::setRepre(int idx)
@@ -188,17 +190,21 @@ void CreatorDialog::setVars()
     bool ok = true;
     for (int i = 0; i < list.length(); i++) {
         QString var = list[i].trimmed();
-        if (var.length() > 1 || !var.at(0).isLetter()) {
+        if (!SymbolTable::isValidName(var.toStdString())) {
             m_vcCombo->setCurrentIndex(0);
-            showError(tr("Only Ascii character name of variable is permitted:"));
+            showError(tr("Name of variable has to start with Ascii letter:"));
             ok = false;
         }
     }
+    if (ok && static_cast<unsigned>(list.size()) > MAX_VARS) {
+        showError(tr("Too many variables for the truth table"));
+        ok = false;
+    }
 
     if (ok) {
         m_vars.resize(list.size());
         for (int i = 0; i < list.size(); i++)
-            m_vars[i] = list[list.size() - i - 1].at(0).toAscii();
+            m_vars[i] = list[list.size() - i - 1].trimmed().toStdString();
 
         m_varsCount = m_vars.size();
 
@@ -228,7 +234,7 @@ void CreatorDialog::printVars()
     // print vars
     QStringList list;
     for (unsigned i = 0; i < m_varsCount; i++)
-        list.insert(0, QString(m_vars[i]));
+        list.insert(0, QString::fromStdString(m_vars[i]));
     m_varsLine->setText(list.join(","));
 }
 
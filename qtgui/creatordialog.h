@@ -26,6 +26,7 @@
 #include <QDialog>
 
 #include <vector>
+#include <string>
 
 class GUIManager;
 class TruthTableModel;
@@ -44,6 +45,8 @@ public:
 private:
     static const int SOP_IDX = 0;
     static const int POS_IDX = 1;
+    // maximal number of variables in the truth table
+    static const unsigned MAX_VARS = 10;
 
     void printVars();
     void clearFormula();
@@ -58,10 +61,10 @@ private:
     TruthTableView *m_ttView;
     TruthTableModel *m_ttModel;
 
-    char m_name;
+    std::string m_name;
     Formula::Repre m_repre;
     unsigned m_varsCount;
-    std::vector<char> m_vars;
+    std::vector<std::string> m_vars;
 
 public slots:
     virtual void accept();
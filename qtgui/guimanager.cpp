@@ -123,6 +123,11 @@ void GUIManager::evtAlgorithmChanged(Kernel::Algorithm alg)
     emit algorithmChanged(m_isQM);
 }
 
+void GUIManager::evtCoverChanged(bool exact)
+{
+    emit coverChanged(exact);
+}
+
 void GUIManager::evtError(std::exception &exc)
 {
     emit errorInvoked(exc.what());
@@ -256,6 +261,11 @@ void GUIManager::setAlgorithm(bool isQM)
         m_kernel->setAlgorithm(isQM? Kernel::QM: Kernel::ESPRESSO);
 }
 
+void GUIManager::setExactCover(bool exact)
+{
+    m_kernel->setExactCover(exact);
+}
+
 // changes cursor
 void GUIManager::setCursor(const QCursor &cursor)
 {
@@ -63,6 +63,8 @@ public:
     bool isSoP() const { return m_isSoP; }
     // whether actual algorithm is Quine-McCluskey
     bool isQM() const { return m_isQM; }
+    // whether exact covering of prime implicants is used
+    bool isExactCover() const { return m_kernel->isExactCover(); }
 
     // loads fce from PLA file
     void loadPLAfile(const QString &);
@@ -96,6 +98,7 @@ protected:
     virtual void evtMinimalFormulaChanged(Formula *);
     virtual void evtFormulasSet(unsigned count);
     virtual void evtAlgorithmChanged(Kernel::Algorithm alg);
+    virtual void evtCoverChanged(bool exact);
     virtual void evtError(std::exception &exc);
     virtual void evtExit();
 
@@ -140,6 +143,8 @@ public slots:
     void setRepre(bool sop);
     // changes algorithm
     void setAlgorithm(bool isQM);
+    // changes covering of prime implicants
+    void setExactCover(bool exact);
     // changes cursor
     void setCursor(const QCursor &cursor);
     // sets status
@@ -174,6 +179,8 @@ signals:
     void repreChanged(bool);
     // emitted when minimizing algorithm is changed
     void algorithmChanged(bool);
+    // emitted when covering of prime implicants is changed
+    void coverChanged(bool);
     // emitted when espresso stepping is started
     void espressoStarted();
     // emitted when espresso stepping is finished
@@ -57,7 +57,7 @@ private:
     unsigned m_colsCount;
     KMap *m_kmap;
 
-    std::vector<char> m_vars;
+    std::vector<std::string> m_vars;
     // selecting mode
     KMapHeadWidget::Mode m_mode;
     // main layout
@@ -27,6 +27,7 @@
 #include <QGraphicsSceneContextMenuEvent>
 
 #include <vector>
+#include <string>
 using namespace std;
 
 KMapHeadWidget::KMapHeadWidget(Mode m, Direction d, QGraphicsItem *parent)
@@ -79,7 +80,7 @@ void KMapHeadWidget::setBinaryMode()
 
 // Vars - lines
 
-KMapLineVarsWidget::KMapLineVarsWidget(vector<char> *vars, Direction d, QGraphicsItem *parent)
+KMapLineVarsWidget::KMapLineVarsWidget(vector<string> *vars, Direction d, QGraphicsItem *parent)
         : KMapHeadWidget(LINES, d, parent)
 {
     m_vars = vars;
@@ -110,15 +111,15 @@ void KMapLineVarsWidget::paint(QPainter *painter, const QStyleOptionGraphicsItem
     int linePos = SIZE - LINE_SPACING;
     for (unsigned i = 0; i < m_varsCount; i++, linePos -= LINE_SPACING) {
         if (m_direction == HORIZONTAL)
-            painter->drawText(charShift, linePos + charShift, QString(m_vars->at(i)));
+            painter->drawText(charShift, linePos + charShift, QString::fromStdString(m_vars->at(i)));
         else
-            painter->drawText(linePos - charShift, FONT_SIZE + charShift, QString(m_vars->at(i)));
+            painter->drawText(linePos - charShift, FONT_SIZE + charShift, QString::fromStdString(m_vars->at(i)));
     }
 }
 
 // Vars - binary
 
-KMapBinaryVarsWidget::KMapBinaryVarsWidget(vector<char> *hVars, vector<char> *vVars, QGraphicsItem *parent)
+KMapBinaryVarsWidget::KMapBinaryVarsWidget(vector<string> *hVars, vector<string> *vVars, QGraphicsItem *parent)
         : KMapHeadWidget(BINARY, HORIZONTAL, parent)
 {
     setVars(hVars, vVars);
@@ -131,7 +132,7 @@ KMapBinaryVarsWidget::KMapBinaryVarsWidget(vector<char> *hVars, vector<char> *vV
     setMaximumSize(minimumSize());
 }
 
-void KMapBinaryVarsWidget::setVars(std::vector<char> *hVars, std::vector<char> *vVars)
+void KMapBinaryVarsWidget::setVars(std::vector<std::string> *hVars, std::vector<std::string> *vVars)
 {
     m_hVars = hVars;
     m_hVars = vVars;
@@ -140,9 +141,9 @@ void KMapBinaryVarsWidget::setVars(std::vector<char> *hVars, std::vector<char> *
     m_hVarsStr.clear();
     m_vVarsStr.clear();
     for (unsigned i = 0; i < hVars->size(); i++)
-        m_hVarsStr.insert(0, hVars->at(i));
+        m_hVarsStr.insert(0, QString::fromStdString(hVars->at(i)));
     for (unsigned i = 0; i < vVars->size(); i++)
-        m_vVarsStr.insert(0, vVars->at(i));
+        m_vVarsStr.insert(0, QString::fromStdString(vVars->at(i)));
 }
 
 void KMapBinaryVarsWidget::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
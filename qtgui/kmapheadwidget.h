@@ -22,6 +22,7 @@
 #define KMAPHEADWIDGET_H
 
 #include <vector>
+#include <string>
 
 #include <QGraphicsWidget>
 
@@ -74,29 +75,29 @@ signals:
 class KMapLineVarsWidget : public KMapHeadWidget
 {
 public:
-    KMapLineVarsWidget(std::vector<char> *vars, Direction d, QGraphicsItem *parent = 0);
+    KMapLineVarsWidget(std::vector<std::string> *vars, Direction d, QGraphicsItem *parent = 0);
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 
-    void setVars(std::vector<char> *vars) { m_vars = vars; }
+    void setVars(std::vector<std::string> *vars) { m_vars = vars; }
 
 private:
-    std::vector<char> *m_vars;
+    std::vector<std::string> *m_vars;
 };
 
 // Class for showing variables next to description in line mode
 class KMapBinaryVarsWidget : public KMapHeadWidget
 {
 public:
-    KMapBinaryVarsWidget(std::vector<char> *hVars, std::vector<char> *vVars, QGraphicsItem *parent = 0);\
+    KMapBinaryVarsWidget(std::vector<std::string> *hVars, std::vector<std::string> *vVars, QGraphicsItem *parent = 0);\
 
-    void setVars(std::vector<char> *hVars, std::vector<char> *vVars);
+    void setVars(std::vector<std::string> *hVars, std::vector<std::string> *vVars);
 
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 
 private:
-    std::vector<char> *m_hVars;
-    std::vector<char> *m_vVars;
+    std::vector<std::string> *m_hVars;
+    std::vector<std::string> *m_vVars;
 
     QString m_hVarsStr;
     QString m_vVarsStr;
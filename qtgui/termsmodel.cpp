@@ -67,7 +67,7 @@ QVariant TermsModel::data(const QModelIndex &index, int role) const
                 form = Parser::PF_SUM;
 
             return QString::fromStdString(Parser::termToString(
-                    Term(index.row(), m_formula->getVarsCount()), m_formula->getVars(), form));
+                    Term(index.row(), m_formula->getVarsCount()), m_formula, form));
 
         }
         catch (std::exception &) {
@@ -74,7 +74,7 @@ QVariant TruthTableModel::headerData(int section, Qt::Orientation orientation, i
     else if (section == static_cast<int>(m_formula->getVarsCount() + 1))
         return QString(tr("Output"));
     else
-        return QString(m_formula->getVars()[m_formula->getVarsCount() - section]);
+        return QString::fromStdString(m_formula->getVar(m_formula->getVarsCount() - section));
 }
 
 
@@ -312,8 +312,8 @@ void AsciiArt::showKMap(KMap *kmap)
     int mapOffset = offset.size() + MAX_KMAP_SIDE_VARS + 2;
     int maxVars = (MAX_KMAP_TOP_VARS > MAX_KMAP_SIDE_VARS)? MAX_KMAP_TOP_VARS: MAX_KMAP_SIDE_VARS;
     char *buff = new char[maxVars + 1];
-    vector<char> *topVars = kmap->getTopVars();
-    vector<char> *sideVars = kmap->getSideVars();
+    vector<string> *topVars = kmap->getTopVars();
+    vector<string> *sideVars = kmap->getSideVars();
 
     // adjust to right
     os->setf(ios_base::right, ios_base::adjustfield);
@@ -425,7 +425,7 @@ void AsciiArt::showCube(Cube *cube)
     int yArrowOffset = 2;
     int zArrowOffset = 2;
     int yArrowSize = 3;
-    vector<char> vars = cube->getVars();
+    vector<string> vars = cube->getVars();
 
     int cubeOffset = offset;
     if (legend)
@@ -142,7 +142,20 @@ void Konsole::evtFormulasSet(unsigned count)
 
 void Konsole::evtAlgorithmChanged(Kernel::Algorithm alg)
 {
-    out << MSG_ALG_CHANGED << ((alg == Kernel::QM)? MSG_ALG_QM: MSG_ALG_ESPRESSO) << endl;
+    out << MSG_ALG_CHANGED;
+    if (alg == Kernel::QM)
+        out << MSG_ALG_QM << endl;
+    else if (alg == Kernel::CONSENSUS)
+        out << MSG_ALG_CONSENSUS << endl;
+    else if (alg == Kernel::BITMAP_QM)
+        out << MSG_ALG_BITMAP_QM << endl;
+    else
+        out << MSG_ALG_ESPRESSO << endl;
+}
+
+void Konsole::evtCoverChanged(bool exact)
+{
+    out << MSG_COVER_CHANGED << (exact? MSG_COVER_EXACT: MSG_COVER_GREEDY) << endl;
 }
 
 void Konsole::evtError(exception &exc)
@@ -170,6 +183,10 @@ void Konsole::evtHelp()
     out << "  minimize      minimizing fce" << endl;
     out << "  qm            set actual minimizing algorithm to Quine-McCluskey" << endl;
     out << "  espresso      set actual minimizing algorithm to Espresso" << endl;
+    out << "  consensus     set actual minimizing algorithm to iterated consensus" << endl;
+    out << "  bitmap        set actual minimizing algorithm to Quine-McCluskey on bitmap" << endl;
+    out << "  exact         use exact covering of prime implicants (qm, consensus, bitmap)" << endl;
+    out << "  greedy        use greedy covering of prime implicants (default)" << endl;
     out << "  sop           set Sum of Products representation" << endl;
     out << "  pos           set Product of Sums representation" << endl;
     out << "  load PATH     load PLA file from PATH" << endl;
@@ -187,7 +204,7 @@ void Konsole::evtHelp()
 
 void Konsole::evtShowEspresso(EspressoData *data)
 {
-    if (Kernel::instance()->getAlgorithm() == Kernel::QM) {
+    if (Kernel::instance()->getAlgorithm() != Kernel::ESPRESSO) {
         Kernel::instance()->setAlgorithm(Kernel::ESPRESSO);
         Kernel::instance()->minimizeFormula(true);
         data = Kernel::instance()->getEspressoData();
@@ -203,7 +220,7 @@ void Konsole::evtShowEspresso(EspressoData *data)
 
 void Konsole::evtShowQm(QuineMcCluskeyData *data)
 {
-    if (Kernel::instance()->getAlgorithm() == Kernel::ESPRESSO) {
+    if (Kernel::instance()->getAlgorithm() != Kernel::QM) {
         Kernel::instance()->setAlgorithm(Kernel::QM);
         Kernel::instance()->minimizeFormula(true);
         data = Kernel::instance()->getQmData();
@@ -45,6 +45,7 @@ protected:
     virtual void evtMinimalFormulaChanged(Formula *mf);
     virtual void evtFormulasSet(unsigned count);
     virtual void evtAlgorithmChanged(Kernel::Algorithm alg);
+    virtual void evtCoverChanged(bool exact);
     virtual void evtError(std::exception &exc);
     virtual void evtExit();
     virtual void evtHelp();
@@ -87,6 +88,11 @@ static const char * const MSG_MV_UNKNOWN         = "Unknown output function numb
 static const char * const MSG_ALG_CHANGED        = "Minimizing algorithm was changed to ";
 static const char * const MSG_ALG_QM             = "Quine-McCluskey";
 static const char * const MSG_ALG_ESPRESSO       = "Espresso";
+static const char * const MSG_ALG_CONSENSUS      = "Iterated consensus";
+static const char * const MSG_ALG_BITMAP_QM      = "Quine-McCluskey on bitmap truth table";
+static const char * const MSG_COVER_CHANGED      = "Covering of prime implicants was changed to ";
+static const char * const MSG_COVER_EXACT        = "exact (minimal number of implicants)";
+static const char * const MSG_COVER_GREEDY       = "greedy";
 static const char * const MSG_ESPRESSO_STEPS     = "Espresso stepping (states after every procedure)";
 static const char * const MSG_ESPRESSO_EXPAND    = "REDUCE:      ";
 static const char * const MSG_ESPRESSO_IRREDUND  = "IRREDUNDANT: ";
@@ -40,6 +40,7 @@ const char *LexicalAnalyzer::getTokenName(Token tok) const
     switch (tok) {
     case NUMBER: return TN_NUMBER;
     case LETTER: return TN_LETTER;
+    case NAME: return TN_NAME;
     case LPAR: return TN_LPAR;
     case RPAR: return TN_RPAR;
     case PLUS: return TN_PLUS;
@@ -62,6 +63,10 @@ const char *LexicalAnalyzer::getCommandName(Command cmd) const
     case SHOW: return CMD_SHOW;
     case QM: return CMD_QM;
     case ESPRESSO: return CMD_ESPRESSO;
+    case CONSENSUS: return CMD_CONSENSUS;
+    case BITMAP: return CMD_BITMAP;
+    case EXACT: return CMD_EXACT;
+    case GREEDY: return CMD_GREEDY;
     case KMAP: return CMD_KMAP;
     case CUBE: return CMD_CUBE;
     case SOP: return CMD_SOP;
@@ -132,6 +137,14 @@ bool LexicalAnalyzer::isCommand(const string &str)
         command = QM;
     else if (strcmpi(word, CMD_ESPRESSO))
         command = ESPRESSO;
+    else if (strcmpi(word, CMD_CONSENSUS))
+        command = CONSENSUS;
+    else if (strcmpi(word, CMD_BITMAP))
+        command = BITMAP;
+    else if (strcmpi(word, CMD_EXACT))
+        command = EXACT;
+    else if (strcmpi(word, CMD_GREEDY))
+        command = GREEDY;
     else if (strcmpi(word, CMD_KMAP))
         command = KMAP;
     else if (strcmpi(word, CMD_CUBE))
@@ -174,20 +187,22 @@ LexicalAnalyzer::Token LexicalAnalyzer::readToken() throw(ShellExc)
     case ALPHA:
         readNext = false;
         letter = inputChar;
+        word = letter;
 
-        if (readInput() != ALPHA) // LETTER
+        readInput();
+        if (!isNameInput()) // LETTER
             return setToken(LETTER);
 
-        word = letter;
         do {
             word += inputChar;
-        } while (readInput() == ALPHA);
+            readInput();
+        } while (isNameInput());
 
-        // command
+        // command or name of variable or function
         if (isCommand(word))
             return setToken(CMD);
         else
-            throw CommandExc(word.c_str(), CommandExc::UNKNOWN, col);
+            return setToken(NAME);
     default: // OTHER
         switch (inputChar) {
         case SYM_DQUOT:
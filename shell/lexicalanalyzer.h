@@ -29,6 +29,7 @@
 
 static const char * const TN_NUMBER  = "NUMBER";
 static const char * const TN_LETTER  = "LETTER";
+static const char * const TN_NAME    = "NAME";
 static const char * const TN_LPAR    = "LPAR";
 static const char * const TN_RPAR    = "RPAR";
 static const char * const TN_PLUS    = "PLUS";
@@ -58,6 +59,10 @@ static const char * const CMD_HELP     = "help";
 static const char * const CMD_SHOW     = "show";
 static const char * const CMD_QM       = "qm";
 static const char * const CMD_ESPRESSO = "espresso";
+static const char * const CMD_CONSENSUS = "consensus";
+static const char * const CMD_BITMAP   = "bitmap";
+static const char * const CMD_EXACT    = "exact";
+static const char * const CMD_GREEDY   = "greedy";
 static const char * const CMD_KMAP     = "kmap";
 static const char * const CMD_CUBE     = "cube";
 static const char * const CMD_SOP      = "sop";
@@ -71,6 +76,7 @@ public:
     enum Token {
         NUMBER,
         LETTER,
+        NAME,
         LPAR,
         RPAR,
         PLUS,
@@ -91,6 +97,10 @@ public:
         SHOW,
         QM,
         ESPRESSO,
+        CONSENSUS,
+        BITMAP,
+        EXACT,
+        GREEDY,
         KMAP,
         CUBE,
         SOP,
@@ -119,6 +129,12 @@ public:
     inline int getCol() const { return col; }
 
 private:
+    // whether input can be a part of name (letters, digits and underscores)
+    inline bool isNameInput() const
+    {
+        return inputType == ALPHA || inputType == DIGIT || (inputType == OTHER && inputChar == '_');
+    }
+
 
     enum InputType { ALPHA, DIGIT, BLANK, OTHER, EOI };
 
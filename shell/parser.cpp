@@ -46,13 +46,33 @@ Parser::Parser()
     kernel = Kernel::instance();
 }
 
-string Parser::termToString(const Term &term, const vector<char> &vars, PrintForm form)
+// variables names of the formula accessible by position
+class FormulaVars
+{
+public:
+    FormulaVars(const Formula *f) : formula(f) {}
+    inline const string &operator[](unsigned pos) const { return formula->getVar(pos); }
+
+private:
+    const Formula *formula;
+};
+
+// term to string conversion for any variables names container
+template <typename Vars>
+static string termToStr(const Term &term, const Vars &vars, Parser::PrintForm form)
 {
     ostringstream oss;
     bool allMissing = true;
-    if (form == PF_SOP || form == PF_PROD) {
+    if (form == Parser::PF_SOP || form == Parser::PF_PROD) {
+        // names longer than one letter have to be separated
+        bool longNames = false;
+        for (unsigned i = 0; i < term.getSize() && !longNames; i++)
+            longNames = vars[i].size() > 1;
+
         for (unsigned i = 0; i < term.getSize(); i++) {
             if (!term[i].isMissing()) {
+                if (longNames && !allMissing)
+                    oss << SYM_MULT;
                 allMissing = false;
                 oss << vars[i];
                 if (term[i].isZero())
@@ -62,7 +82,7 @@ string Parser::termToString(const Term &term, const vector<char> &vars, PrintFor
         if (allMissing)
             oss << '1';
     }
-    else if (form == PF_POS || form == PF_SUM) {
+    else if (form == Parser::PF_POS || form == Parser::PF_SUM) {
         bool first = true;
         for (unsigned i = 0; i < term.getSize(); i++) {
             if (!term[i].isMissing()) {
@@ -83,7 +103,17 @@ string Parser::termToString(const Term &term, const vector<char> &vars, PrintFor
     return oss.str();
 }
 
-string Parser::formulaToString(PrintForm form, Formula *f)
+string Parser::termToString(const Term &term, const vector<string> &vars, PrintForm form)
+{
+    return termToStr(term, vars, form);
+}
+
+string Parser::termToString(const Term &term, const Formula *formula, PrintForm form)
+{
+    return termToStr(term, FormulaVars(formula), form);
+}
+
+string Parser::formulaToString(PrintForm form, const Formula *f)
 {
     if (!f)
         return "";
@@ -91,33 +121,45 @@ string Parser::formulaToString(PrintForm form, Formula *f)
     ostringstream oss;
     // variables
     oss << f->getName() << SYM_LPAR;
-    vector<char> vars = f->getVars();
-    for (unsigned i = vars.size(); i > 0; i--) {
-        if (i != vars.size())
+    for (unsigned i = f->getVarsCount(); i > 0; i--) {
+        if (i != f->getVarsCount())
             oss << SYM_COMMA;
-        oss << vars[i - 1];
+        oss << f->getVar(i - 1);
     }
     oss << SYM_RPAR << ' ' << SYM_ASSIGN << ' ';
 
+    // indexes can't be listed for too many variables (cubes are printed)
+    if (f->getVarsCount() > Formula::MAX_INDEX_VARS) {
+        if (form == PF_SUM)
+            form = PF_SOP;
+        else if (form == PF_PROD)
+            form = PF_POS;
+    }
+
     if (form == PF_SUM || form == PF_PROD) {
-        vector<int> idx;
-        if (form == PF_SUM) {
-            f->getTermsIdx(OutputValue::ONE, idx);
-            oss << CMD_SUM << ' ';
+        vector<int> idx, dcIdx;
+        bool saved = (form == PF_SUM) == (f->getRepre() == Formula::REP_SOP);
+        if (saved) {
+            // saved terms are expanded lazily (with dont cares)
+            for (Formula::minterm_iterator it = f->mintermsBegin(); it != f->mintermsEnd(); ++it)
+                (it->isDC()? dcIdx: idx).push_back(it.idx());
         }
         else {
-            f->getTermsIdx(OutputValue::ZERO, idx);
-            oss << CMD_PROD << ' ';
+            f->getTermsIdx((form == PF_SUM)? OutputValue::ONE: OutputValue::ZERO, idx);
+            f->getTermsIdx(OutputValue::DC, dcIdx);
         }
+        oss << ((form == PF_SUM)? CMD_SUM: CMD_PROD) << ' ';
         oss << FCE_MINTERM << SYM_LPAR;
+        // minterms of overlapping cubes are repeated
         sort(idx.begin(), idx.end());
+        idx.erase(unique(idx.begin(), idx.end()), idx.end());
         for (unsigned i = 0; i < idx.size(); i++) {
             if (i != 0)
                 oss << SYM_COMMA;
             oss << idx[i];
         }
         oss << SYM_RPAR;
-        idx = f->getTermsIdx(OutputValue::DC, idx);
+        idx.swap(dcIdx);
         if (!idx.empty()) {
             if (form == PF_SUM) {
                 oss << ' ' << SYM_PLUS << ' ';
@@ -129,6 +171,7 @@ string Parser::formulaToString(PrintForm form, Formula *f)
             }
             oss << FCE_DC << SYM_LPAR;
             sort(idx.begin(), idx.end());
+            idx.erase(unique(idx.begin(), idx.end()), idx.end());
             for (unsigned i = 0; i < idx.size(); i++) {
                 if (i != 0)
                     oss << SYM_COMMA;
@@ -142,19 +185,18 @@ string Parser::formulaToString(PrintForm form, Formula *f)
     else if (f->isTautology())
             oss << " 1";
     else {
-        f->itInit();
+        FormulaVars vars(f);
         bool first = true;
-        while (f->itHasNext()) {
+        for (Formula::const_iterator it = f->begin(); it != f->end(); ++it) {
             if (first)
                 first = false;
             else if (form == PF_SOP)
                 oss << ' ' << SYM_PLUS << ' ';
 
-            Term t = f->itNext();
-            bool bracket = (form == PF_POS && t.getSize(false) > 1);
+            bool bracket = (form == PF_POS && it->getSize(false) > 1);
             if (bracket)
                 oss << '(';
-            oss << termToString(t, vars, form);
+            oss << termToStr(*it, vars, form);
             if (bracket)
                 oss << ')';
         }
@@ -231,7 +273,7 @@ void Parser::program() throw(ShellExc, KernelExc)
 
     if (cmp(LexicalAnalyzer::CMD))
         command();
-    else if (cmp(LexicalAnalyzer::LETTER))
+    else if (cmpName())
         fceDef();
     else
         throw syntaxExc();
@@ -256,6 +298,18 @@ void Parser::command() throw(ShellExc)
     case LexicalAnalyzer::ESPRESSO:
         kernel->setAlgorithm(Kernel::ESPRESSO);
         break;
+    case LexicalAnalyzer::CONSENSUS:
+        kernel->setAlgorithm(Kernel::CONSENSUS);
+        break;
+    case LexicalAnalyzer::BITMAP:
+        kernel->setAlgorithm(Kernel::BITMAP_QM);
+        break;
+    case LexicalAnalyzer::EXACT:
+        kernel->setExactCover(true);
+        break;
+    case LexicalAnalyzer::GREEDY:
+        kernel->setExactCover(false);
+        break;
     case LexicalAnalyzer::SOP:
         kernel->setRepre(Formula::REP_SOP);
         break;
@@ -284,8 +338,8 @@ void Parser::showArg() throw(ShellExc)
 {
     if (cmp(LexicalAnalyzer::END))
         kernel->showFce();
-    else if (cmp(LexicalAnalyzer::LETTER))
-        kernel->showFce(lex.getLetter());
+    else if (cmpName())
+        kernel->showFce(lex.getWord());
     else {
         cmpe(LexicalAnalyzer::CMD);
         switch (lex.getCommand()) {
@@ -327,39 +381,45 @@ void Parser::fceDef() throw(ShellExc, KernelExc)
 
 FormulaDecl *Parser::fceDecl() throw(ShellExc)
 {
-    char name = fceName();
+    bool word = cmp(LexicalAnalyzer::NAME);
+    int col = lex.getCol();
+    string name = fceName();
+    // a word which is not followed by bracket is not function name
+    if (word && !cmp(LexicalAnalyzer::LPAR))
+        throw CommandExc(name.c_str(), CommandExc::UNKNOWN, col);
     cmpre(LexicalAnalyzer::LPAR);
-    vector<char> *v = fceVars();
+    vector<string> *v = fceVars();
     readToken(); // RPAR - assured by fceVarsRem
 
     return new FormulaDecl(v, name);
 }
 
-char Parser::fceName() throw(ShellExc)
+string Parser::fceName() throw(ShellExc)
 {
-    char name = lex.getLetter();
+    string name = lex.getWord();
     readToken();
     return name;
 }
 
-vector<char> *Parser::fceVars() throw(ShellExc)
+vector<string> *Parser::fceVars() throw(ShellExc)
 {
-    cmpe(LexicalAnalyzer::LETTER);
-    char var = lex.getLetter();
+    if (!cmpName())
+        throw syntaxExc();
+    string var = lex.getWord();
     readToken();
-    vector<char> *v = fceVarsRem();
+    vector<string> *v = fceVarsRem();
     v->push_back(var);
     return v;
 }
 
-vector<char> *Parser::fceVarsRem() throw(ShellExc)
+vector<string> *Parser::fceVarsRem() throw(ShellExc)
 {
     if (cmp(LexicalAnalyzer::RPAR))
-        return new vector<char>;
-    else if (cmpr(LexicalAnalyzer::COMMA) && cmp(LexicalAnalyzer::LETTER)) {
-        char var = lex.getLetter();
+        return new vector<string>;
+    else if (cmpr(LexicalAnalyzer::COMMA) && cmpName()) {
+        string var = lex.getWord();
         readToken();
-        vector<char> *v = fceVarsRem();
+        vector<string> *v = fceVarsRem();
         v->push_back(var);
         return v;
     }
@@ -496,6 +556,11 @@ inline bool Parser::cmp(LexicalAnalyzer::Token tok)
     return tok == lex.getToken();
 }
 
+inline bool Parser::cmpName()
+{
+    return cmp(LexicalAnalyzer::LETTER) || cmp(LexicalAnalyzer::NAME);
+}
+
 bool Parser::cmpr(LexicalAnalyzer::Token tok)
 {
     if (cmp(tok)) {
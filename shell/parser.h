@@ -25,6 +25,7 @@
 #include "shellexc.h"
 // kernel
 #include "kernelexc.h"
+#include "term.h"
 
 #include <istream>
 #include <string>
@@ -35,7 +36,6 @@ class Kernel;
 class Formula;
 class FormulaDecl;
 class FormulaSpec;
-class Term;
 class ShellExc;
 class SyntaxExc;
 class CommandExc;
@@ -50,8 +50,10 @@ public:
         PF_POS   // product of sums
     };
 
-    static std::string termToString(const Term &term, const std::vector<char> &vars, PrintForm form);
-    static std::string formulaToString(PrintForm form, Formula *formula);
+    static std::string termToString(const Term &term, const std::vector<std::string> &vars, PrintForm form);
+    // variables names are taken from formula (without copying them)
+    static std::string termToString(const Term &term, const Formula *formula, PrintForm form);
+    static std::string formulaToString(PrintForm form, const Formula *formula);
 
     Parser();
 
@@ -70,9 +72,9 @@ private:
     std::string filePath() throw(ShellExc);
     void fceDef() throw(ShellExc, KernelExc);
     FormulaDecl *fceDecl() throw(ShellExc);
-    char fceName() throw(ShellExc);
-    std::vector<char> *fceVars() throw(ShellExc);
-    std::vector<char> *fceVarsRem() throw(ShellExc);
+    std::string fceName() throw(ShellExc);
+    std::vector<std::string> *fceVars() throw(ShellExc);
+    std::vector<std::string> *fceVarsRem() throw(ShellExc);
     FormulaSpec *fceBody() throw(ShellExc);
     FormulaSpec *sum() throw(ShellExc);
     std::set<int> *sumRem() throw(ShellExc);
@@ -86,6 +88,8 @@ private:
 
     // only compare tokens
     inline bool cmp(LexicalAnalyzer::Token tok);
+    // whether token is name (one letter or word)
+    inline bool cmpName();
     // compare and if true read token
     bool cmpr(LexicalAnalyzer::Token tok);
     // compare and if false throw exception
@@ -24,6 +24,7 @@
 #include "formula.h"
 #include "term.h"
 #include "outputvalue.h"
+#include "symboltable.h"
 
 #include <iostream>
 #include <sstream>
@@ -33,7 +34,7 @@
 using namespace std;
 
 
-void PLAFormat::create(std::ostream &os, Formula *formula)
+void PLAFormat::create(std::ostream &os, const Formula *formula)
 {
     // inputs
     os << ".i " << formula->getVarsCount() << endl;
@@ -43,9 +44,8 @@ void PLAFormat::create(std::ostream &os, Formula *formula)
 
     // variables names
     os << ".ilb";
-    vector<char> vars = formula->getVars();
-    for (unsigned i = vars.size(); i > 0; i--)
-        os << ' ' << vars[i - 1];
+    for (unsigned i = formula->getVarsCount(); i > 0; i--)
+        os << ' ' << formula->getVar(i - 1);
     os << endl;
 
     // fce name
@@ -55,11 +55,8 @@ void PLAFormat::create(std::ostream &os, Formula *formula)
     os << ".p " << formula->getSize() << endl;
 
     // terms
-    formula->itInit();
-    while (formula->itHasNext()) {
-        Term &t = formula->itNext();
-        os << t.toString(Term::SF_BIN, false) << ' ' << (t.isDC()? '-': '1') << endl;
-    }
+    for (Formula::const_iterator it = formula->begin(); it != formula->end(); ++it)
+        os << it->toString(Term::SF_BIN, false) << ' ' << (it->isDC()? '-': '1') << endl;
 
     // end
     os << ".e" << endl;
@@ -111,7 +108,7 @@ PLAFormat::PLAFormat(istream &is) throw(PLAExc)
 
                 inputNames.resize(inputs);
                 for (int i = inputs - 1; i >= 0; i--)
-                    inputNames[i] = getNextChar(row, pos, PLAExc::VAR_NAME);
+                    inputNames[i] = getNextName(row, pos, PLAExc::VAR_NAME);
 
                 endError = PLAExc::VAR_COUNT;
             }
@@ -121,7 +118,7 @@ PLAFormat::PLAFormat(istream &is) throw(PLAExc)
 
                 outputNames.resize(outputs);
                 for (int i = 0; i < outputs; i++)
-                    outputNames[i] = getNextChar(row, pos, PLAExc::FCE_NAME);
+                    outputNames[i] = getNextName(row, pos, PLAExc::FCE_NAME);
 
                 endError = PLAExc::FCE_COUNT;
             }
@@ -150,10 +147,16 @@ PLAFormat::PLAFormat(istream &is) throw(PLAExc)
 
                 // formulas initialization
                 formulas.resize(outputs);
-                for (int i = 0; i < outputs; i++) {
-                    formulas[i] = new Formula(inputs,
-                            (outputNames.size() > 0)? outputNames[i]: Formula::DEFAULT_NAME,
-                            Formula::REP_SOP, (inputNames.size() > 0)? &inputNames: 0);
+                try {
+                    for (int i = 0; i < outputs; i++) {
+                        formulas[i] = new Formula(inputs,
+                                (outputNames.size() > 0)? outputNames[i]: Formula::DEFAULT_NAME,
+                                Formula::REP_SOP, (inputNames.size() > 0)? &inputNames: 0);
+                    }
+                }
+                catch (InvalidVarsExc &) { // too many or duplicated variables
+                    throw(PLAExc((static_cast<unsigned>(inputs) > Formula::MAX_VARS)?
+                                 PLAExc::VAR_COUNT: PLAExc::VAR_NAME, line, offset));
                 }
             }
 
@@ -243,25 +246,29 @@ int PLAFormat::getNextInt(string &str, size_t &pos, PLAExc::Error errType) throw
     return num;
 }
 
-char PLAFormat::getNextChar(string &str, size_t &pos, PLAExc::Error errType) throw(PLAExc)
+string PLAFormat::getNextName(string &str, size_t &pos, PLAExc::Error errType) throw(PLAExc)
 {
     // actual content
     while (pos < str.size() && !isblank(str[pos]))
         pos++;
     if (pos == str.size())
-        return 0;
+        throw PLAExc(errType, line, offset + pos);
 
     // spaces after actual
     while (pos < str.size() && isblank(str[pos]))
         pos++;
     if (pos == str.size())
-        return 0;
+        throw PLAExc(errType, line, offset + pos);
 
-    // found char
-    if (!isalpha(str[pos]) || ((pos + 1) < str.size() && !isblank(str[pos + 1])))
+    // found name
+    size_t end = pos;
+    while (end < str.size() && !isblank(str[end]))
+        end++;
+    string name = str.substr(pos, end - pos);
+    if (!SymbolTable::isValidName(name))
         throw PLAExc(errType, line, offset + pos);
 
-    return str[pos];
+    return name;
 }
 
 
@@ -22,25 +22,27 @@
 #define PLAFORMAT_H
 
 #include "shellexc.h"
+// kernel
+#include "term.h"
 
 #include <istream>
+#include <string>
 #include <vector>
 #include <exception>
 
 class Formula;
-class Term;
 
 class PLAFormat
 {
 public:
-    static void create(std::ostream &os, Formula *formula);
+    static void create(std::ostream &os, const Formula *formula);
 
     PLAFormat(std::istream &is) throw(PLAExc);
 
     std::vector<Term> terms;
 
-    std::vector<char> inputNames;
-    std::vector<char> outputNames;
+    std::vector<std::string> inputNames;
+    std::vector<std::string> outputNames;
     std::vector<Formula *> formulas;
 
     int termsCount;
@@ -54,8 +56,8 @@ private:
     bool isEndAfter(std::string &str, size_t &pos);
     int getNextInt(std::string &str, size_t &pos,
                    PLAExc::Error err = PLAExc::SYNTAX) throw(PLAExc);
-    char getNextChar(std::string &str, size_t &pos,
-                     PLAExc::Error err = PLAExc::SYNTAX) throw(PLAExc);
+    std::string getNextName(std::string &str, size_t &pos,
+                            PLAExc::Error err = PLAExc::SYNTAX) throw(PLAExc);
 
     size_t offset;
     int line;
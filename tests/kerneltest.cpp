@@ -0,0 +1,1642 @@
+/*
+ * kerneltest.cpp - tests of minimizing algorithms
+ * created date: 10/17/2026
+ *
+ * Copyright (C) 2026 Jakub Zelenka.
+ *
+ * Bmin is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Bmin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Bmin; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kernel.h"
+#include "formula.h"
+#include "term.h"
+#include "outputvalue.h"
+#include "termscontainer.h"
+#include "minimizingalgorithm.h"
+#include "quinemccluskey.h"
+#include "bitmapquinemccluskey.h"
+#include "consensus.h"
+#include "espresso.h"
+#include "symboltable.h"
+#include "kernelexc.h"
+#include "covertable.h"
+#include "greedycover.h"
+#include "exactcover.h"
+#include "coverblocks.h"
+#include "termsbatch.h"
+#include "espressocover.h"
+#include "threadpool.h"
+#include "termshash.h"
+#include "termstree.h"
+#include "arena.h"
+#include "bitmatrix.h"
+#include "cofactorview.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+// number of failed checks
+static int failures = 0;
+
+#define CHECK(cond, msg) \
+    do { \
+        if (!(cond)) { \
+            cerr << __FILE__ << ':' << __LINE__ << ": " << msg << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+// makes formula with n variables (values: 1 - one, 0 - zero, 2 - dont care)
+// in the same way as the shell (saved terms are set by specification)
+static Formula *makeFormula(const vector<int> &values, unsigned n, bool sop)
+{
+    set<int> *terms = new set<int>;
+    for (unsigned i = 0; i < values.size(); i++) {
+        if (values[i] == (sop? 1: 0))
+            terms->insert(i);
+    }
+    FormulaSpec spec;
+    if (sop)
+        spec.f = terms;
+    else
+        spec.r = terms;
+    spec.sop = sop;
+    vector<string> *vars = new vector<string>;
+    for (unsigned i = 0; i < n; i++)
+        vars->push_back(string(1, 'a' + i));
+    FormulaDecl decl(vars, "f");
+
+    Formula *f = new Formula(&spec, &decl);
+    for (unsigned i = 0; i < values.size(); i++) {
+        if (values[i] == 2)
+            f->setTermValue(i, OutputValue(OutputValue::DC));
+    }
+    return f;
+}
+
+// whether minimized formula mf has the values (dont cares can be anything)
+static bool hasValues(const Formula *mf, const vector<int> &values, unsigned n)
+{
+    for (int idx = 0; idx < static_cast<int>(values.size()); idx++) {
+        Term m(idx, n);
+        bool covered = false;
+        for (Formula::const_iterator it = mf->begin(); it != mf->end() && !covered; ++it)
+            covered = it->implies(m);
+        // terms of POS formula are the off-set cubes
+        int value = (mf->getRepre() == Formula::REP_SOP)? covered: !covered;
+        if (values[idx] != 2 && values[idx] != value)
+            return false;
+    }
+    return true;
+}
+
+// minimizes random functions in both forms by the algorithm
+static void testRandom(MinimizingAlgorithm *alg, const string &name)
+{
+    srand(12345);
+    for (int iter = 0; iter < 200; iter++) {
+        unsigned n = 1 + rand() % 7;
+        vector<int> values(1 << n);
+        int density = rand() % 100;
+        for (unsigned i = 0; i < values.size(); i++) {
+            int r = rand() % 100;
+            values[i] = (r < density)? 1: ((r < density + 10)? 2: 0);
+        }
+        for (int sop = 0; sop < 2; sop++) {
+            Formula *f = makeFormula(values, n, sop);
+            Formula *mf = alg->minimize(f, false);
+            CHECK(hasValues(mf, values, n), name << (sop? " SOP": " POS")
+                  << " iteration " << iter << ": wrong minimized function");
+            delete mf;
+            delete f;
+        }
+    }
+}
+
+// POS function which is saved in a dense container
+static void testPos(MinimizingAlgorithm *alg, const string &name)
+{
+    // f(a,b,c) = prod m(0,3,5) * prod d(7)
+    int v1[] = { 0, 1, 1, 0, 1, 0, 1, 2 };
+    vector<int> values(v1, v1 + 8);
+    Formula *f = makeFormula(values, 3, false);
+    Formula *mf = alg->minimize(f, false);
+    CHECK(hasValues(mf, values, 3), name << " POS: wrong minimized function");
+    delete mf;
+    delete f;
+
+    // f(a,b,c) = prod m(0,1,2,3)
+    int v2[] = { 0, 0, 0, 0, 1, 1, 1, 1 };
+    values.assign(v2, v2 + 8);
+    f = makeFormula(values, 3, false);
+    mf = alg->minimize(f, false);
+    CHECK(hasValues(mf, values, 3), name << " POS: wrong minimized function");
+    CHECK(mf->getSize() == 1, name << " POS: one clause expected");
+    delete mf;
+    delete f;
+}
+
+// returns cube of n variables with the first k variables set by idx
+static Term prefixCube(unsigned n, unsigned k, int idx)
+{
+    Term::bits_t liters, missing;
+    for (unsigned i = 0; i < n; i++) {
+        if (i >= k)
+            missing.set(i);
+        else if ((idx >> i) & 1)
+            liters.set(i);
+    }
+    return Term(liters, missing, n);
+}
+
+// POS functions with dont cares in every storage width, only the first four
+// variables are used, so the values can be checked on them
+static void testPosWidths()
+{
+    unsigned widths[] = { 5, 20, 40, 100, 200 };
+    const unsigned k = 4;
+    srand(3003);
+    for (unsigned w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        unsigned n = widths[w];
+        for (int iter = 0; iter < 20; iter++) {
+            vector<int> values(1 << k);
+            for (unsigned i = 0; i < values.size(); i++)
+                values[i] = (iter == 0 && i == 0)? 2: rand() % 3;
+
+            Formula f(n, string("f"), Formula::REP_POS);
+            for (unsigned i = 0; i < values.size(); i++) {
+                if (values[i] == 0)
+                    f.setTermValue(prefixCube(n, k, i), OutputValue::ZERO);
+                else if (values[i] == 2)
+                    f.setTermValue(prefixCube(n, k, i), OutputValue::DC);
+            }
+
+            Espresso es;
+            Formula *mf = es.minimize(&f, false);
+            bool ok = mf->getRepre() == Formula::REP_POS;
+            for (unsigned i = 0; i < values.size() && ok; i++) {
+                Term m = prefixCube(n, k, i);
+                bool covered = false;
+                for (Formula::const_iterator it = mf->begin(); it != mf->end() && !covered; ++it)
+                    covered = it->implies(m);
+                ok = values[i] == 2 || values[i] == !covered;
+            }
+            CHECK(ok, "Espresso POS " << n << " variables iteration " << iter
+                  << ": wrong minimized function");
+            delete mf;
+        }
+    }
+}
+
+// containers save terms in the storage by the number of variables, the terms
+// have to be the same after passing them in and out
+static void testContainerWidths()
+{
+    unsigned widths[] = { 5, 20, 40, 100, 200 };
+    srand(777);
+    for (unsigned w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        unsigned n = widths[w];
+        vector<Term> cubes;
+        while (cubes.size() < 50) {
+            Term::bits_t liters, missing;
+            for (unsigned k = 0; k < n; k++) {
+                int r = rand() % 3;
+                if (r == 2)
+                    missing.set(k);
+                else if (r == 1)
+                    liters.set(k);
+            }
+            Term t(liters, missing, n, (cubes.size() % 7)? Term::ONE: Term::DC);
+            if (find(cubes.begin(), cubes.end(), t) == cubes.end())
+                cubes.push_back(t);
+        }
+
+        TermsContainer *tc = TermsContainer::create(n);
+        for (unsigned i = 0; i < cubes.size(); i++)
+            tc->pushTerm(cubes[i]);
+        TermsContainer *copy = tc->clone();
+        CHECK(*copy == *tc, n << " variables: copy isn't equal");
+
+        unsigned count = 0;
+        for (TermsContainer::const_iterator it = tc->begin(); it != tc->end(); ++it, count++) {
+            CHECK(it->getSize() == n && it->isDC() == cubes[count].isDC()
+                  && it->getLiters() == cubes[count].getLiters()
+                  && it->getMissing() == cubes[count].getMissing(),
+                  n << " variables: term " << count << " was changed");
+        }
+        CHECK(count == cubes.size(), n << " variables: " << count << " terms iterated");
+
+        for (unsigned i = 0; i < cubes.size(); i += 2)
+            tc->removeTerm(cubes[i]);
+        for (unsigned i = 0; i < cubes.size(); i++) {
+            CHECK(tc->hasTerm(cubes[i]) == (i % 2 == 1), n << " variables: term " << i
+                  << " has wrong presence");
+            CHECK(copy->hasTerm(cubes[i]), n << " variables: copy was changed");
+        }
+        delete copy;
+        delete tc;
+    }
+}
+
+// returns random cube of n variables (r of 3 variables is missing)
+static Term randomCube(unsigned n, int r = 1)
+{
+    Term::bits_t liters, missing;
+    for (unsigned v = 0; v < n; v++) {
+        int x = rand() % 3;
+        if (x < r)
+            missing.set(v);
+        else if (rand() % 2)
+            liters.set(v);
+    }
+    return Term(liters, missing, n);
+}
+
+// returns cube of n variables with liters of the first variables
+static Term wideCube(unsigned n, const string &liters)
+{
+    Term::bits_t l, m;
+    for (unsigned i = 0; i < n; i++) {
+        if (i >= liters.size())
+            m.set(i);
+        else if (liters[i] == '1')
+            l.set(i);
+    }
+    return Term(l, m, n);
+}
+
+// hash index finds inserted terms after removing of others (probing chains
+// are kept), sparse containers give the same terms
+static void testTermsHash()
+{
+    srand(2020);
+    TermsHash hash;
+    vector<Term> terms;
+    while (terms.size() < 2000) {
+        Term t = randomCube(12);
+        if (find(terms.begin(), terms.end(), t) == terms.end())
+            terms.push_back(t);
+    }
+    bool ok = true;
+    for (unsigned i = 0; i < terms.size(); i++)
+        ok = ok && hash.insert(terms[i], i) && !hash.insert(terms[i], i + 1);
+    CHECK(ok && hash.getSize() == terms.size(), "terms hash: wrong insertion");
+
+    for (unsigned i = 0; i < terms.size(); i += 3)
+        ok = ok && hash.remove(terms[i]) && !hash.remove(terms[i]);
+    CHECK(ok, "terms hash: wrong removing");
+    for (unsigned i = 0; i < terms.size(); i++) {
+        int expected = (i % 3)? int(i): TermsHash::NONE;
+        ok = ok && hash.find(terms[i]) == expected;
+    }
+    CHECK(ok && hash.getSize() == terms.size() - (terms.size() + 2) / 3,
+          "terms hash: wrong lookup after removing");
+
+    for (unsigned i = 1; i < terms.size(); i += 3)
+        ok = ok && hash.update(terms[i], -2 - int(i));
+    ok = ok && !hash.update(terms[0], 5);
+    for (unsigned i = 1; i < terms.size(); i += 3)
+        ok = ok && hash.find(terms[i]) == -2 - int(i);
+    CHECK(ok, "terms hash: wrong update");
+    hash.clear();
+    CHECK(hash.getSize() == 0 && hash.find(terms[1]) == TermsHash::NONE,
+          "terms hash: not cleared");
+
+    // sparse container with hash index
+    TermsContainer *tc = TermsContainer::create(12, TermsContainer::MINTERMS,
+            TermsContainer::STL_SET);
+    for (unsigned i = 0; i < 500; i++)
+        tc->pushTerm(terms[i]);
+    for (unsigned i = 0; i < 500; i += 2)
+        tc->removeTerm(terms[i]);
+    for (unsigned i = 0; i < 600; i++)
+        ok = ok && tc->hasTerm(terms[i]) == (i < 500 && i % 2 == 1);
+    CHECK(ok && tc->getSize() == 250, "terms hash: wrong terms of sparse container");
+    delete tc;
+}
+
+// whether cube a contains cube b
+static bool cubeContains(const Term &a, const Term &b)
+{
+    Term::bits_t bound = ~a.getMissing() & Term::getFullLiters(a.getSize());
+    return (bound & b.getMissing()).none() && ((a.getLiters() ^ b.getLiters()) & bound).none();
+}
+
+// whether cubes a and b have a common minterm
+static bool cubesIntersect(const Term &a, const Term &b)
+{
+    Term::bits_t bound = ~a.getMissing() & ~b.getMissing() & Term::getFullLiters(a.getSize());
+    return ((a.getLiters() ^ b.getLiters()) & bound).none();
+}
+
+// subsumption queries of the trie are the same as the ones by scanning
+static void testTermsTree()
+{
+    srand(2121);
+    const unsigned n = 8;
+    TermsTree tree(n);
+    vector<Term> terms;
+    while (terms.size() < 300) {
+        Term t = randomCube(n);
+        if (find(terms.begin(), terms.end(), t) == terms.end())
+            terms.push_back(t);
+    }
+    bool ok = true;
+    for (unsigned i = 0; i < terms.size(); i++)
+        ok = ok && tree.insert(terms[i], i) && !tree.insert(terms[i], i);
+    for (unsigned i = 0; i < terms.size(); i += 4)
+        ok = ok && tree.remove(terms[i]) && !tree.remove(terms[i]);
+    CHECK(ok && tree.getSize() == terms.size() - terms.size() / 4,
+          "terms tree: wrong insertion or removing");
+
+    for (int q = 0; q < 200 && ok; q++) {
+        Term t = randomCube(n, q % 3);
+        vector<int> containing, intersecting, contained;
+        for (unsigned i = 0; i < terms.size(); i++) {
+            if (i % 4 == 0)
+                continue;
+            if (cubeContains(terms[i], t))
+                containing.push_back(i);
+            if (cubesIntersect(terms[i], t))
+                intersecting.push_back(i);
+            if (cubeContains(t, terms[i]))
+                contained.push_back(i);
+        }
+        vector<int> found;
+        tree.findContaining(t, found);
+        sort(found.begin(), found.end());
+        ok = ok && found == containing;
+        found.clear();
+        tree.findIntersecting(t, found);
+        sort(found.begin(), found.end());
+        ok = ok && found == intersecting;
+        found.clear();
+        tree.findContained(t, found);
+        sort(found.begin(), found.end());
+        ok = ok && found == contained;
+
+        int one = tree.findContaining(t);
+        ok = ok && (containing.empty()? one == TermsTree::NONE:
+                    find(containing.begin(), containing.end(), one) != containing.end());
+        int idx = find(terms.begin(), terms.end(), t) - terms.begin();
+        int value = (idx < int(terms.size()) && idx % 4)? idx: TermsTree::NONE;
+        ok = ok && tree.find(t) == value;
+    }
+    CHECK(ok, "terms tree: wrong result of query");
+
+    ok = tree.update(terms[1], 1000) && !tree.update(terms[0], 1000);
+    CHECK(ok && tree.find(terms[1]) == 1000 && tree.find(terms[0]) == TermsTree::NONE,
+          "terms tree: wrong updating");
+}
+
+// sorted indexes of terms with dont care flags (as a sign)
+template <typename It>
+static vector<int> termsSignature(It first, It last)
+{
+    vector<int> sig;
+    for (; first != last; ++first)
+        sig.push_back(first->isDC()? ~first->getIdx(): first->getIdx());
+    sort(sig.begin(), sig.end());
+    return sig;
+}
+
+// read-only iteration visits the same terms as the terms vector
+static void testConstIterator()
+{
+    TermsContainer::ContainerType types[] = { TermsContainer::STL_VECTOR, TermsContainer::STL_SET,
+        TermsContainer::TERMS_TREE, TermsContainer::BIT_SET };
+    srand(2525);
+    for (unsigned k = 0; k < sizeof(types) / sizeof(types[0]); k++) {
+        TermsContainer *tc = TermsContainer::create(6, TermsContainer::MINTERMS, types[k]);
+        CHECK(tc->begin() == tc->end(), "const iterator type " << k << ": empty container");
+        vector<Term> terms;
+        for (int i = 0; i < 64; i++) {
+            if (rand() % 3)
+                tc->pushTerm(i, rand() % 4 == 0);
+        }
+        for (int i = 0; i < 64; i += 5)
+            tc->removeTerm(i);
+        tc->getTerms(terms);
+        vector<int> expected = termsSignature(terms.begin(), terms.end());
+        CHECK(termsSignature(tc->begin(), tc->end()) == expected,
+              "const iterator type " << k << ": wrong terms");
+        unsigned count = 0;
+        for (TermsContainer::const_iterator it = tc->begin(); it != tc->end(); it++)
+            count++;
+        CHECK(count == tc->getSize(), "const iterator type " << k << ": wrong count");
+        delete tc;
+    }
+
+    vector<int> values(32);
+    for (unsigned i = 0; i < values.size(); i++)
+        values[i] = rand() % 3;
+    for (int sop = 0; sop < 2; sop++) {
+        Formula *f = makeFormula(values, 5, sop);
+        vector<Term> terms;
+        f->getTerms(terms);
+        CHECK(termsSignature(f->begin(), f->end()) == termsSignature(terms.begin(), terms.end()),
+              "const iterator: wrong terms of formula (sop " << sop << ")");
+        delete f;
+    }
+}
+
+// memory blocks of arena are reused after rewinding
+static void testArena()
+{
+    Arena arena(1024);
+    bool aligned = true;
+    for (int i = 0; i < 64; i++) {
+        size_t p = reinterpret_cast<size_t>(arena.allocate(i + 1));
+        aligned = aligned && p % Arena::ALIGNMENT == 0;
+    }
+    CHECK(aligned, "arena: memory isn't aligned");
+    CHECK(arena.getRequestsCount() == 64 && arena.getAllocsCount() == 3,
+          "arena: " << arena.getAllocsCount() << " blocks for 64 requests");
+
+    Arena::Mark m = arena.mark();
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 100; i++)
+            arena.allocate(48);
+        arena.rewind(m);
+    }
+    unsigned long allocs = arena.getAllocsCount();
+    CHECK(allocs == 8, "arena: blocks aren't reused after rewinding (" << allocs << " blocks)");
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 200; i++)
+            arena.allocate(16);
+        arena.reset();
+    }
+    CHECK(arena.getAllocsCount() == allocs && arena.getSize() == allocs * 1024,
+          "arena: blocks aren't reused after reset");
+    void *big = arena.allocate(4096);
+    CHECK(big && arena.getAllocsCount() == allocs + 1 && arena.getSize() == allocs * 1024 + 4096,
+          "arena: wrong allocation bigger than block");
+    {
+        // heap memory is only counted (it isn't released by rewinding)
+        vector<int, ArenaAllocator<int> > heap(ArenaAllocator<int>(&arena, true));
+        heap.reserve(10);
+        heap.assign(1000, 1);
+        arena.reset();
+        CHECK(arena.getHeapAllocsCount() == 2 && arena.getAllocsCount() == allocs + 1
+              && heap.back() == 1, "arena: wrong counting of heap memory");
+    }
+
+    // Espresso makes the same number of allocations in every run
+    vector<int> values(256);
+    srand(808);
+    for (unsigned i = 0; i < values.size(); i++)
+        values[i] = rand() % 10 < 4? 1: (rand() % 10 == 0? 2: 0);
+    Formula *f = makeFormula(values, 8, true);
+    Espresso es;
+    unsigned long counts[3];
+    for (int i = 0; i < 3; i++) {
+        delete es.minimize(f, false);
+        counts[i] = es.getAllocsCount();
+    }
+    CHECK(counts[0] > 0 && counts[0] == counts[1] && counts[1] == counts[2],
+          "arena: Espresso allocates " << counts[0] << ", " << counts[1] << ", "
+          << counts[2] << " times");
+    delete f;
+
+    // allocations aren't made per cube (only capacities of covers grow)
+    int percents[] = { 5, 20, 40 };
+    unsigned cubes[3];
+    values.assign(1024, 0);
+    for (int k = 0; k < 3; k++) {
+        for (unsigned i = 0; i < values.size(); i++)
+            values[i] = rand() % 100 < percents[k];
+        f = makeFormula(values, 10, true);
+        Formula *mf = es.minimize(f, false);
+        cubes[k] = mf->getSize();
+        counts[k] = es.getAllocsCount();
+        delete mf;
+        delete f;
+    }
+    CHECK(cubes[0] < cubes[1] && cubes[1] < cubes[2] && counts[2] < cubes[2]
+          && 2 * (counts[2] - counts[0]) < cubes[2] - cubes[0],
+          "arena: Espresso allocates " << counts[0] << ", " << counts[1] << ", " << counts[2]
+          << " times for " << cubes[0] << ", " << cubes[1] << ", " << cubes[2] << " cubes");
+}
+
+// copies share terms until the first change, reading of one copy doesn't
+// change the other ones
+static void testCopyOnWrite()
+{
+    TermsContainer::ContainerType types[] = { TermsContainer::STL_VECTOR, TermsContainer::STL_SET,
+        TermsContainer::TERMS_TREE, TermsContainer::BIT_SET };
+    for (unsigned k = 0; k < sizeof(types) / sizeof(types[0]); k++) {
+        TermsContainer *tc = TermsContainer::create(4, TermsContainer::MINTERMS, types[k]);
+        tc->pushTerm(3);
+        tc->pushTerm(9, true);
+        tc->pushTerm(12);
+
+        TermsContainer *copy = tc->clone();
+        copy->pushTerm(5);
+        copy->removeTerm(3);
+        CHECK(tc->getSize() == 3 && tc->hasTerm(Term(3, 4)) && !tc->hasTerm(Term(5, 4)),
+              "COW type " << k << ": original was changed by the copy");
+        CHECK(copy->getSize() == 3 && !copy->hasTerm(Term(3, 4)) && copy->hasTerm(Term(5, 4)),
+              "COW type " << k << ": copy wasn't changed");
+
+        // const access by position on a copy, then the original is changed
+        const TermsContainer *reader = tc->clone();
+        Term first = reader->at(0);
+        Term second = reader->at(1);
+        CHECK(first != second, "COW type " << k << ": at() results aren't independent");
+        tc->pushTerm(0);
+        tc->removeTerm(12);
+        CHECK(reader->getSize() == 3 && reader->hasTerm(Term(12, 4)) && !reader->hasTerm(Term(0, 4)),
+              "COW type " << k << ": reader was changed by the original");
+        set<int> read;
+        for (unsigned i = 0; i < reader->getSize(); i++)
+            read.insert(reader->at(i).getIdx());
+        CHECK(read.size() == 3 && read.count(3) && read.count(9) && read.count(12),
+              "COW type " << k << ": wrong terms of the reader by position");
+        CHECK(tc->hasTerm(Term(0, 4)) && !tc->hasTerm(Term(12, 4)),
+              "COW type " << k << ": original wasn't changed");
+
+        delete reader;
+        delete copy;
+        delete tc;
+    }
+}
+
+// lazy minterms of saved terms are the same as the expanded ones
+static void testMintermIterator()
+{
+    TermsContainer::ContainerType types[] = { TermsContainer::STL_VECTOR, TermsContainer::STL_SET,
+        TermsContainer::TERMS_TREE, TermsContainer::BIT_SET };
+    srand(31337);
+    for (unsigned k = 0; k < sizeof(types) / sizeof(types[0]); k++) {
+        for (int pos = 0; pos < 2; pos++) {
+            TermsContainer::TermsType tt = pos? TermsContainer::MAXTERMS: TermsContainer::MINTERMS;
+            TermsContainer *tc = TermsContainer::create(6, tt, types[k]);
+            for (int i = 0; i < 10; i++) {
+                if (types[k] == TermsContainer::BIT_SET)
+                    tc->pushTerm(rand() % 64, rand() % 4 == 0);
+                else {
+                    Term::bits_t liters, missing;
+                    for (unsigned v = 0; v < 6; v++) {
+                        int r = rand() % 3;
+                        if (r == 2)
+                            missing.set(v);
+                        else if (r == 1)
+                            liters.set(v);
+                    }
+                    tc->pushTerm(Term(liters, missing, 6, (rand() % 4)? Term::ONE: Term::DC));
+                }
+            }
+
+            multiset<pair<int, bool> > lazy, expanded;
+            for (TermsContainer::minterm_iterator it = tc->mintermsBegin(); it != tc->mintermsEnd(); ++it)
+                lazy.insert(make_pair(it.idx(), it->isDC()));
+            vector<Term> v = pos? tc->getMaxterms(): tc->getMinterms();
+            for (unsigned i = 0; i < v.size(); i++)
+                expanded.insert(make_pair(v[i].getIdx(), v[i].isDC()));
+            CHECK(lazy == expanded, "minterm iterator type " << k << (pos? " POS": " SOP")
+                  << ": " << lazy.size() << " minterms (expanded " << expanded.size() << ")");
+            delete tc;
+        }
+    }
+}
+
+// returns sorted indexes and dont care flags of terms
+static vector<pair<int, bool> > termsIdx(const vector<Term> &v)
+{
+    vector<pair<int, bool> > idxs;
+    for (unsigned i = 0; i < v.size(); i++)
+        idxs.push_back(make_pair(v[i].getIdx(), v[i].isDC()));
+    sort(idxs.begin(), idxs.end());
+    return idxs;
+}
+
+// complement is the same for all container types, BIT_SET is equal to the
+// other types with the same terms
+static void testComplement()
+{
+    TermsContainer::ContainerType types[] = { TermsContainer::STL_VECTOR, TermsContainer::STL_SET,
+        TermsContainer::TERMS_TREE, TermsContainer::BIT_SET };
+    srand(4242);
+    for (int iter = 0; iter < 20; iter++) {
+        unsigned n = 2 + rand() % 8;
+        vector<int> values(1 << n);
+        for (unsigned i = 0; i < values.size(); i++)
+            values[i] = rand() % 3;
+
+        for (int pos = 0; pos < 2; pos++) {
+            TermsContainer::TermsType tt = pos? TermsContainer::MAXTERMS: TermsContainer::MINTERMS;
+            int savedValue = pos? 0: 1;
+            // expected saved (on-set or off-set) and complement with dont cares
+            vector<pair<int, bool> > expSaved, expComplement;
+            for (unsigned i = 0; i < values.size(); i++) {
+                if (values[i] == 2) {
+                    expSaved.push_back(make_pair(int(i), true));
+                    expComplement.push_back(make_pair(int(i), true));
+                }
+                else if (values[i] == savedValue)
+                    expSaved.push_back(make_pair(int(i), false));
+                else
+                    expComplement.push_back(make_pair(int(i), false));
+            }
+
+            TermsContainer *containers[4];
+            for (unsigned k = 0; k < 4; k++) {
+                TermsContainer *tc = TermsContainer::create(n, tt, types[k]);
+                for (unsigned i = 0; i < values.size(); i++) {
+                    if (values[i] == 2 || values[i] == savedValue)
+                        tc->pushTerm(i, values[i] == 2);
+                }
+                // saved maxterms are returned by getMinterms for MAXTERMS too
+                CHECK(termsIdx(tc->getMinterms()) == expSaved, "complement type " << k
+                      << (pos? " POS": " SOP") << " iteration " << iter << ": wrong minterms");
+                if (pos) {
+                    vector<int> ones = tc->getTermsIdx(OutputValue::ONE);
+                    vector<pair<int, bool> > complement;
+                    for (unsigned i = 0; i < ones.size(); i++)
+                        complement.push_back(make_pair(ones[i], false));
+                    vector<int> dcs = tc->getTermsIdx(OutputValue::DC);
+                    for (unsigned i = 0; i < dcs.size(); i++)
+                        complement.push_back(make_pair(dcs[i], true));
+                    sort(complement.begin(), complement.end());
+                    CHECK(complement == expComplement, "complement type " << k
+                          << " POS iteration " << iter << ": wrong complement");
+                }
+                else {
+                    CHECK(termsIdx(tc->getMaxterms()) == expComplement, "complement type " << k
+                          << " SOP iteration " << iter << ": wrong complement");
+                }
+                containers[k] = tc;
+            }
+            for (unsigned k = 0; k < 4; k++) {
+                for (unsigned l = 0; l < 4; l++) {
+                    CHECK(*containers[k] == *containers[l], "complement types " << k << " and "
+                          << l << " iteration " << iter << ": containers aren't equal");
+                }
+            }
+            // one changed dont care makes them different
+            if (!expSaved.empty()) {
+                containers[0]->pushTerm(expSaved[0].first, !expSaved[0].second);
+                CHECK(*containers[0] != *containers[3] && *containers[3] != *containers[0],
+                      "complement iteration " << iter << ": changed dont care isn't found");
+            }
+            for (unsigned k = 0; k < 4; k++)
+                delete containers[k];
+        }
+    }
+
+    // complement of cubes is made from the expanded minterms
+    TermsContainer *tc = TermsContainer::create(4);
+    Term::bits_t liters, missing;
+    liters.set(3);
+    missing.set(1);
+    missing.set(2);
+    tc->pushTerm(Term(liters, missing, 4));
+    tc->pushTerm(3, true);
+    vector<pair<int, bool> > complement = termsIdx(tc->getMaxterms());
+    CHECK(complement.size() == 12, "cube complement: " << complement.size() << " maxterms");
+    CHECK(find(complement.begin(), complement.end(), make_pair(3, true)) != complement.end(),
+          "cube complement: dont care is missing");
+    delete tc;
+
+    // indexes out of the bitmaps aren't found
+    tc = TermsContainer::create(4, TermsContainer::MINTERMS, TermsContainer::BIT_SET);
+    tc->pushTerm(5);
+    CHECK(!tc->pushTerm(16) && !tc->pushTerm(-1) && !tc->removeTerm(1000) && !tc->removeTerm(-3)
+          && tc->getTermValue(1000) == OutputValue::ZERO && tc->getTermValue(-1) == OutputValue::ZERO
+          && tc->getSize() == 1, "bit set: index out of range was found");
+    delete tc;
+    Formula dense(4, string("f"));
+    int rejected = 0;
+    int badIdx[] = { -1, 16, 1000 };
+    for (unsigned i = 0; i < 3; i++) {
+        try {
+            dense.getTermValue(badIdx[i]);
+        }
+        catch (InvalidIndexExc &) {
+            rejected++;
+        }
+        try {
+            dense.setTermValue(badIdx[i], OutputValue::ONE);
+        }
+        catch (InvalidIndexExc &) {
+            rejected++;
+        }
+    }
+    CHECK(rejected == 6, "formula: " << 6 - rejected << " invalid indexes weren't rejected");
+
+    // functions with too many variables for bitmaps are complemented by cubes
+    const unsigned n = 40;
+    Formula wide(n, string("f"));
+    wide.setTermValue(wideCube(n, "1"), OutputValue::ONE);
+    wide.setTermValue(wideCube(n, "01"), OutputValue::DC);
+    wide.setRepre(Formula::REP_POS);
+    CHECK(wide.getSize() > 0 && !wide.isTautology(), "wide complement: constant function");
+    bool ok = true;
+    for (int i = 0; i < 500 && ok; i++) {
+        Term m = randomCube(n, 0);
+        bool zero = false, dc = false;
+        for (Formula::const_iterator it = wide.begin(); it != wide.end(); ++it) {
+            if (it->implies(m))
+                (it->isDC()? dc: zero) = true;
+        }
+        int value = m.at(0).isOne()? 1: (m.at(1).isOne()? 2: 0);
+        ok = (value == 0) == zero && (value == 2) == dc;
+    }
+    CHECK(ok, "wide complement: wrong off-set");
+}
+
+// functions of few cubes with many missings - the bitmap is filled by words
+// and primes are deposited from the bitmaps of missings
+static void testBitmapCubes()
+{
+    srand(1818);
+    for (int iter = 0; iter < 10; iter++) {
+        unsigned n = 8 + iter / 2;
+        Formula f(n, string("f"));
+        vector<int> values(1 << n, 0);
+        for (unsigned c = 0; c < 4; c++) {
+            Term::bits_t liters, missing;
+            for (unsigned v = 0; v < n; v++) {
+                if (rand() % 4)
+                    missing.set(v);
+                else if (rand() % 2)
+                    liters.set(v);
+            }
+            Term t(liters, missing, n);
+            f.setTermValue(t, (c == 3)? OutputValue::DC: OutputValue::ONE);
+            for (unsigned i = 0; i < values.size(); i++) {
+                if (t.implies(Term(int(i), n)) && values[i] != 1)
+                    values[i] = (c == 3)? 2: 1;
+            }
+        }
+
+        QuineMcCluskey qm;
+        qm.setExactCover(true);
+        Formula *qmf = qm.minimize(&f, false);
+        BitmapQuineMcCluskey bqm;
+        bqm.setExactCover(true);
+        Formula *mf = bqm.minimize(&f, false);
+        CHECK(hasValues(mf, values, n), "Bitmap QM cubes " << n
+              << " variables: wrong minimized function");
+        CHECK(mf->getSize() == qmf->getSize(), "Bitmap QM cubes " << n << " variables: "
+              << mf->getSize() << " implicants (QM " << qmf->getSize() << ")");
+        delete mf;
+        delete qmf;
+    }
+}
+
+// dense functions generate too many consensus cubes, QM is used instead
+static void testDenseConsensus()
+{
+    srand(2026);
+    for (int iter = 0; iter < 5; iter++) {
+        unsigned n = 10;
+        vector<int> values(1 << n);
+        for (unsigned i = 0; i < values.size(); i++)
+            values[i] = rand() % 2;
+
+        Formula *f = makeFormula(values, n, true);
+        QuineMcCluskey qm;
+        Formula *qmf = qm.minimize(f, false);
+        Consensus cs;
+        Formula *mf = cs.minimize(f, false);
+        CHECK(hasValues(mf, values, n), "Consensus dense iteration " << iter
+              << ": wrong minimized function");
+        CHECK(mf->getSize() == qmf->getSize(), "Consensus dense iteration " << iter
+              << ": " << mf->getSize() << " implicants (QM " << qmf->getSize() << ")");
+        CHECK(cs.getFallback() == Consensus::QM_FALLBACK, "Consensus dense iteration "
+              << iter << ": QM fallback isn't reported");
+        delete mf;
+        delete qmf;
+        delete f;
+    }
+
+    // all prime implicants are generated, so the exact covers have the same size
+    for (int iter = 0; iter < 50; iter++) {
+        unsigned n = 6;
+        vector<int> values(1 << n);
+        for (unsigned i = 0; i < values.size(); i++)
+            values[i] = (rand() % 3 == 0)? 1: ((rand() % 8 == 0)? 2: 0);
+
+        Formula *f = makeFormula(values, n, true);
+        QuineMcCluskey qm;
+        qm.setExactCover(true);
+        Formula *qmf = qm.minimize(f, false);
+        Consensus cs;
+        cs.setExactCover(true);
+        Formula *mf = cs.minimize(f, false);
+        CHECK(cs.getFallback() == Consensus::NO_FALLBACK, "Consensus sparse iteration "
+              << iter << ": fallback was used");
+        CHECK(mf->getSize() == qmf->getSize(), "Consensus sparse iteration " << iter
+              << ": " << mf->getSize() << " implicants (QM " << qmf->getSize() << ")");
+        delete mf;
+        delete qmf;
+        delete f;
+    }
+}
+
+// combinable terms found by the batch kernels (32 and 64 bits words) are
+// the same as the ones found term by term
+static void testTermsBatch()
+{
+    unsigned widths[] = { 12, 32, 40, 130 };
+    srand(1212);
+    for (unsigned w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        unsigned n = widths[w];
+        // few missing variables, so there are terms with the same missings
+        TermsBatch batch(n);
+        vector<Term> terms;
+        for (unsigned i = 0; i < 300; i++) {
+            Term::bits_t liters, missing;
+            for (unsigned v = 0; v < n; v++) {
+                if (v < 3 && rand() % 2)
+                    missing.set(v);
+                else if (v < 8 && rand() % 2)
+                    liters.set(v);
+            }
+            Term t(liters, missing, n);
+            terms.push_back(t);
+            batch.add(t.getLiters(), t.getMissing(), Term::ONE);
+        }
+        CHECK(batch.isNarrow() == (n <= TermsBatch::NARROW_VARS), "terms batch " << n
+              << " variables: wrong words");
+
+        bool ok = true;
+        for (unsigned i = 0; i < terms.size() && ok; i++) {
+            vector<unsigned> found, expected;
+            batch.findCombinable(batch, i, found);
+            for (unsigned j = 0; j < terms.size(); j++) {
+                Term::bits_t d = terms[i].getLiters() ^ terms[j].getLiters();
+                if (terms[i].getMissing() == terms[j].getMissing() && d.count() == 1)
+                    expected.push_back(j);
+            }
+            ok = (found == expected);
+            if (ok && !found.empty()) {
+                TermsBatch out(n);
+                vector<unsigned> first(1, found[0]);
+                batch.combine(batch, i, first, out, Term::ONE);
+                Term::bits_t d = terms[i].getLiters() ^ terms[found[0]].getLiters();
+                ok = out.getMissing<Term::bits_t>(0) == (terms[i].getMissing() | d)
+                        && out.getLiters<Term::bits_t>(0) == (terms[i].getLiters() & ~d);
+            }
+        }
+        CHECK(ok, "terms batch " << n << " variables: wrong combinable terms");
+    }
+}
+
+// flags of cover cubes are kept when the cubes are appended, sorted and removed
+static void testEspressoCover()
+{
+    srand(606);
+    EspressoCover c(10), d(10);
+    vector<Term> terms;
+    for (unsigned i = 0; i < 150; i++) {
+        Term::bits_t liters, missing;
+        for (unsigned v = 0; v < 10; v++) {
+            int r = rand() % 3;
+            if (r == 2)
+                missing.set(v);
+            else if (r == 1)
+                liters.set(v);
+        }
+        int flags = Term::ONE | ((rand() % 2)? Term::PRIME: 0) | ((rand() % 3)? Term::REDUND: 0);
+        Term t(liters, missing, 10, flags);
+        if (find(terms.begin(), terms.end(), t) != terms.end()) {
+            i--;
+            continue;
+        }
+        terms.push_back(t);
+        if (i < 70)
+            c.add(t);
+        else
+            d.add(t);
+    }
+    c.appendDC(d);
+    CHECK(c.count() == 150, "espresso cover: " << c.count() << " cubes");
+    bool ok = true;
+    for (unsigned i = 0; i < c.count(); i++) {
+        int flags = terms[i].getFlags() | ((i >= 70)? Term::DC: 0);
+        ok = ok && c.getFlags(i) == flags && c.at(i) == terms[i];
+    }
+    CHECK(ok, "espresso cover: wrong flags of appended cubes");
+
+    c.setCovered(true);
+    CHECK(c.isCovered(), "espresso cover: cubes aren't covered");
+    c.setFlag(149, Term::COVERED, false);
+    CHECK(!c.isCovered(), "espresso cover: the last cube is covered");
+
+    c.sort();
+    c.removeRedundant();
+    unsigned kept = 0;
+    ok = true;
+    for (unsigned i = 0; i < terms.size(); i++)
+        kept += !terms[i].isRedundant();
+    for (unsigned i = 0; i < c.count(); i++) {
+        Term t = c.at(i);
+        vector<Term>::const_iterator it = find(terms.begin(), terms.end(), t);
+        ok = ok && it != terms.end() && !c.hasFlags(i, Term::REDUND)
+                && c.hasFlags(i, Term::PRIME) == it->isPrime()
+                && c.hasFlags(i, Term::DC) == (it - terms.begin() >= 70);
+    }
+    CHECK(ok && c.count() == kept, "espresso cover: wrong cubes after removing");
+
+    c.setCovered(false);
+    c.setActived(true);
+    for (unsigned i = 0; i < c.count(); i += 2)
+        c.setFlag(i, Term::ACTIVE, false);
+    c.removeInactived();
+    c.removeDC();
+    ok = true;
+    for (unsigned i = 0; i < c.count(); i++) {
+        ok = ok && c.hasFlags(i, Term::ACTIVE) && !c.hasFlags(i, Term::DC | Term::COVERED)
+                && c.hasFlags(i, Term::ONE);
+    }
+    CHECK(ok, "espresso cover: wrong flags after removing");
+}
+
+// statistics of columns are the same as naive counts of bits with every
+// counting kernel which CPU supports (widths aren't multiples of lanes)
+static void testBitMatrix()
+{
+    ColumnStats::Counter counters[] = { ColumnStats::SCALAR_COUNTER, ColumnStats::AVX2_COUNTER,
+        ColumnStats::AVX512_COUNTER };
+    ColumnStats::Counter defaultCounter = ColumnStats::getCounter();
+    unsigned widths[] = { 5, 63, 70, 130, 300, 511 };
+    unsigned rowsCounts[] = { 1, 7, 33, 150 };
+    srand(707);
+    for (unsigned k = 0; k < 3; k++) {
+        if (!ColumnStats::setCounter(counters[k]))
+            continue;
+        for (unsigned w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+            for (unsigned r = 0; r < sizeof(rowsCounts) / sizeof(rowsCounts[0]); r++) {
+                unsigned cols = widths[w], rows = rowsCounts[r];
+                BitMatrix ones(cols), zeros(cols);
+                vector<vector<bool> > bits(rows, vector<bool>(cols));
+                for (unsigned i = 0; i < rows; i++) {
+                    uint64_t *o = ones.addRow();
+                    uint64_t *z = zeros.addRow();
+                    // some rows have a single one
+                    unsigned single = (i % 3 == 0)? rand() % cols: cols;
+                    for (unsigned c = 0; c < cols; c++) {
+                        bool b = (single < cols)? c == single: rand() % 4 == 0;
+                        bits[i][c] = b;
+                        (b? o: z)[c / 64] |= uint64_t(1) << (c % 64);
+                    }
+                }
+                // some columns are eliminated
+                vector<uint64_t> masked(ones.wordsCount(), 0);
+                for (unsigned c = 0; c < cols; c += 7 + r)
+                    masked[c / 64] |= uint64_t(1) << (c % 64);
+                ones.maskColumns(&masked[0]);
+
+                ColumnStats st, zst;
+                ones.stats(st);
+                zeros.stats(zst);
+                bool ok = true;
+                int maxCol = -1;
+                unsigned maxCount = 0;
+                vector<uint64_t> singles(ones.wordsCount(), 0);
+                for (unsigned c = 0; c < cols; c++) {
+                    unsigned count = 0;
+                    for (unsigned i = 0; i < rows; i++)
+                        count += bits[i][c];
+                    bool isMasked = (masked[c / 64] >> (c % 64)) & 1;
+                    bool nonzero = (st.nonzero()[c / 64] >> (c % 64)) & 1;
+                    ok = ok && st.ones(c) == count && zst.ones(c) == rows - count
+                            && nonzero == (count > 0);
+                    if (!isMasked && count > maxCount) {
+                        maxCol = c;
+                        maxCount = count;
+                    }
+                }
+                for (unsigned i = 0; i < rows; i++) {
+                    int one = -1, found = 0;
+                    for (unsigned c = 0; c < cols; c++) {
+                        if (bits[i][c] && !((masked[c / 64] >> (c % 64)) & 1)) {
+                            one = c;
+                            found++;
+                        }
+                    }
+                    if (found == 1)
+                        singles[one / 64] |= uint64_t(1) << (one % 64);
+                }
+                for (unsigned i = 0; i < ones.wordsCount(); i++)
+                    ok = ok && st.singles()[i] == singles[i];
+                CHECK(ok && st.maxColumn() == maxCol, "bit matrix counter " << k << ": wrong stats of "
+                      << rows << " rows and " << cols << " columns");
+            }
+        }
+    }
+    ColumnStats::setCounter(defaultCounter);
+}
+
+typedef EspressoEngine<Term::storage_type> EspressoTestEngine;
+
+// cover of n variables with cubes of strings (the last character is the first
+// variable), the list of strings ends by 0
+static EspressoCover makeCover(unsigned n, const char *const *cubes)
+{
+    EspressoCover c(n);
+    for (; *cubes; cubes++)
+        c.add(Term(string(*cubes), n));
+    return c;
+}
+
+// whether minterm idx is covered by some cube of c
+static bool coverHas(const EspressoCover &c, int idx)
+{
+    Term m(idx, c.varsCount());
+    for (unsigned i = 0; i < c.count(); i++) {
+        if (c.at(i).implies(m))
+            return true;
+    }
+    return false;
+}
+
+// whether no cube of c is contained in another cube of c
+static bool isContainmentFree(const EspressoCover &c)
+{
+    for (unsigned i = 0; i < c.count(); i++) {
+        for (unsigned j = 0; j < c.count(); j++) {
+            if (i != j && c.contains(i, c, j))
+                return false;
+        }
+    }
+    return true;
+}
+
+// unate recursive complement of hand made covers (empty, single cube, unate
+// with the merge of contained complements, binate with the containment merge)
+// and of random covers against truth tables
+static void testEspressoComplement()
+{
+    const unsigned n = 4;
+    const char *empty[] = { 0 };
+    const char *single[] = { "-101", 0 };
+    const char *unate[] = { "--11", "-11-", 0 };
+    const char *unate3[] = { "--11", "-1-1", "1---", 0 };
+    const char *merged[] = { "--11", "-110", 0 };
+    const char *binate[] = { "--11", "-1-0", 0 };
+    const char *withDc[] = { "--11", 0 };
+    const char *dc[] = { "---0", 0 };
+    struct {
+        const char *const *f;
+        const char *const *d;
+        unsigned cubes;
+    } cases[] = {
+        { empty, empty, 1 }, { single, empty, 3 }, { unate, empty, 2 }, { unate3, empty, 2 },
+        { merged, empty, 2 }, { binate, empty, 2 }, { withDc, dc, 1 }
+    };
+
+    for (unsigned k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        EspressoCover f = makeCover(n, cases[k].f), d = makeCover(n, cases[k].d), r(n);
+        EspressoTestEngine engine(n);
+        engine.complement(f, d, r);
+        bool ok = true;
+        for (int idx = 0; idx < (1 << n); idx++)
+            ok = ok && coverHas(r, idx) == !(coverHas(f, idx) || coverHas(d, idx));
+        CHECK(ok, "espresso complement case " << k << ": wrong truth table");
+        CHECK(r.count() == cases[k].cubes && isContainmentFree(r), "espresso complement case "
+              << k << ": " << r.count() << " cubes instead of " << cases[k].cubes);
+    }
+
+    srand(404);
+    for (int iter = 0; iter < 50; iter++) {
+        unsigned vc = 3 + iter % 6;
+        EspressoCover f(vc), d(vc), r(vc);
+        unsigned count = 1 + rand() % 12;
+        for (unsigned i = 0; i < count; i++)
+            (i % 4 == 3? d: f).add(randomCube(vc));
+        EspressoTestEngine engine(vc);
+        engine.complement(f, d, r);
+        bool ok = true;
+        for (int idx = 0; idx < (1 << vc); idx++)
+            ok = ok && coverHas(r, idx) == !(coverHas(f, idx) || coverHas(d, idx));
+        CHECK(ok, "espresso complement iteration " << iter << ": wrong truth table");
+    }
+}
+
+typedef BasicCofactorView<Term::storage_type> TestView;
+
+// cube of n variables (bits of missing variables are cleared)
+static Term normCube(const Term::bits_t &l, const Term::bits_t &m, unsigned n)
+{
+    Term::bits_t full = Term::getFullLiters(n);
+    return Term(l & ~m & full, m & full, n);
+}
+
+// sorted rows of view v
+static vector<Term> viewRows(const TestView &v, unsigned n)
+{
+    vector<Term> rows;
+    foreach_row(v, i)
+        rows.push_back(normCube(v.getLiters(i), v.getMissing(i), n));
+    sort(rows.begin(), rows.end());
+    return rows;
+}
+
+// sorted cubes of cofactor of cover c with respect to cube (cl, cm)
+static vector<Term> cofactorRows(const EspressoCover &c, const Term::bits_t &cl,
+        const Term::bits_t &cm)
+{
+    unsigned n = c.varsCount();
+    Term::bits_t full = Term::getFullLiters(n);
+    Term::bits_t fixed = ~cm & full;
+    EspressoCover r(n);
+    for (unsigned i = 0; i < c.count(); i++) {
+        if (((c.getLiters(i) ^ cl) & fixed & ~c.getMissing(i)).none())
+            r.add(c.getLiters(i) & ~fixed, (c.getMissing(i) | fixed) & full);
+    }
+    vector<Term> rows;
+    for (unsigned i = 0; i < r.count(); i++)
+        rows.push_back(normCube(r.getLiters(i), r.getMissing(i), n));
+    sort(rows.begin(), rows.end());
+    return rows;
+}
+
+// cofactor views are cofactored by Shannon expansion until they are sparse,
+// rows of views (copied or not) are the same as rows of cover cofactors,
+// selecting of rows and unateness of views are compared with the rows
+static void testCofactorView()
+{
+    const unsigned n = 10;
+    Term::bits_t full = Term::getFullLiters(n);
+    srand(909);
+    for (int iter = 0; iter < 10; iter++) {
+        EspressoCover c(n);
+        for (unsigned i = 0; i < 256; i++)
+            c.add(randomCube(n));
+
+        Arena arena;
+        vector<TestView *> views;
+        TestView *view = new TestView(n, &arena);
+        views.push_back(view);
+        view->cofactor(c, Term::bits_t(), full);
+        Term::bits_t cl, cm = full;
+        // rows of the parent cover of the view (copied rows if the view was sparse)
+        unsigned parentRows = c.count();
+        bool ok = viewRows(*view, n) == cofactorRows(c, cl, cm);
+        unsigned copied = 0;
+        for (unsigned pos = 0; pos < n && ok && !view->isEmpty(); pos++) {
+            TestView *v0 = new TestView(n, &arena), *v1 = new TestView(n, &arena);
+            views.push_back(v0);
+            views.push_back(v1);
+            view->shannon(pos, *v0, *v1);
+            Term::bits_t bit = Term::bits_t::bit(pos);
+            cm &= ~bit;
+            ok = ok && viewRows(*v0, n) == cofactorRows(c, cl, cm)
+                    && viewRows(*v1, n) == cofactorRows(c, cl | bit, cm);
+            bool one = rand() % 2;
+            if (one)
+                cl |= bit;
+            view = one? v1: v0;
+
+            // only sparse view has copied rows indexed from zero
+            bool sparse = parentRows >= TestView::SPARSE_MIN
+                    && view->count() * TestView::SPARSE_RATIO < parentRows;
+            bool indexed = true;
+            unsigned k = 0;
+            foreach_row(*view, i)
+                indexed = indexed && i == int(k++);
+            ok = ok && (view->count() < 2 || sparse == indexed);
+            if (sparse) {
+                parentRows = view->count();
+                copied++;
+            }
+
+            // rows with or without a bound variable in columns
+            Term::bits_t columns = randomCube(n).getLiters() & full;
+            TestView with(n, &arena), without(n, &arena);
+            with.select(*view, columns, true);
+            without.select(*view, columns, false);
+            vector<Term> expWith, expWithout;
+            foreach_row(*view, i) {
+                Term t = normCube(view->getLiters(i), view->getMissing(i), n);
+                ((~t.getMissing() & columns).any()? expWith: expWithout).push_back(t);
+            }
+            sort(expWith.begin(), expWith.end());
+            sort(expWithout.begin(), expWithout.end());
+            ok = ok && viewRows(with, n) == expWith && viewRows(without, n) == expWithout;
+
+            // unate if no variable is bound to one and zero
+            Term::bits_t ones, zeros;
+            foreach_row(*view, i) {
+                Term::bits_t bound = ~view->getMissing(i) & full;
+                ones |= view->getLiters(i) & bound;
+                zeros |= ~view->getLiters(i) & bound;
+            }
+            Term prod;
+            bool unate = view->isUnate(&prod);
+            ok = ok && unate == (ones & zeros).none() && (!unate
+                    || (prod.getMissing() & full) == (~(ones | zeros) & full));
+        }
+        CHECK(ok && copied > 0, "cofactor view iteration " << iter << ": wrong rows ("
+              << copied << " copied views)");
+        for (unsigned i = views.size(); i > 0; i--)
+            delete views[i - 1];
+    }
+}
+
+// tautology by unate recursive paradigm - hand made covers for each early
+// exit (unate leaf, unate reduction, volume, components, binate split)
+// and random covers are compared with the truth table
+static void testTautology()
+{
+    const unsigned n = 4;
+    const char *unateLeaf[] = { "--01", "-1--", 0 };
+    const char *allMissing[] = { "--01", "----", 0 };
+    const char *unateReduced[] = { "-1--", "---1", "---0", 0 };
+    const char *smallVolume[] = { "--11", "--00", 0 };
+    const char *component[] = { "---1", "---0", "-11-", "-00-", 0 };
+    const char *noComponent[] = { "--11", "--00", "11--", "00--", 0 };
+    const char *split[] = { "--11", "--10", "--0-", 0 };
+    const char *noSplit[] = { "--11", "--00", "--01", "-1-1", "-0-0", 0 };
+    struct {
+        const char *const *f;
+        bool tautology;
+    } cases[] = {
+        { unateLeaf, false }, { allMissing, true }, { unateReduced, true },
+        { smallVolume, false }, { component, true }, { noComponent, false },
+        { split, true }, { noSplit, false }
+    };
+
+    for (unsigned k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        EspressoCover f = makeCover(n, cases[k].f);
+        bool all = true;
+        for (int idx = 0; idx < (1 << n); idx++)
+            all = all && coverHas(f, idx);
+        EspressoTestEngine engine(n);
+        CHECK(all == cases[k].tautology && engine.isTautology(f) == all,
+              "tautology case " << k << ": wrong result");
+    }
+
+    srand(505);
+    for (int iter = 0; iter < 200; iter++) {
+        unsigned vc = 2 + iter % 5;
+        EspressoCover f(vc);
+        unsigned count = 1 + rand() % 10;
+        for (unsigned i = 0; i < count; i++)
+            f.add(randomCube(vc, 2));
+        bool all = true;
+        for (int idx = 0; idx < (1 << vc); idx++)
+            all = all && coverHas(f, idx);
+        EspressoTestEngine engine(vc);
+        CHECK(engine.isTautology(f) == all, "tautology iteration " << iter << ": wrong result");
+    }
+}
+
+// packed covering table with columns in two words
+static void testCoverTable()
+{
+    CoverTable t(3, 70);
+    unsigned cells[][2] = { { 0, 0 }, { 0, 2 }, { 0, 64 }, { 0, 66 }, { 1, 2 }, { 1, 3 },
+        { 1, 66 }, { 1, 69 }, { 2, 1 }, { 2, 69 } };
+    for (unsigned i = 0; i < sizeof(cells) / sizeof(cells[0]); i++)
+        t.set(cells[i][0], cells[i][1]);
+
+    CHECK(t.rowOnes(0) == 4 && t.rowOnes(1) == 4 && t.rowOnes(2) == 2,
+          "cover table: wrong counts of rows");
+    CHECK(t.colOnes(2) == 2 && t.colOnes(1) == 1 && t.colOnes(5) == 0,
+          "cover table: wrong counts of columns");
+    CHECK(t.test(1, 66) && !t.test(2, 66) && t.firstRow(3) == 1 && t.firstRow(5) == -1,
+          "cover table: wrong cells");
+
+    t.cover(0);
+    CHECK(!t.isActive(2) && !t.isActive(64) && t.isActive(3) && !t.test(1, 66),
+          "cover table: covered columns weren't removed");
+    CHECK(t.rowOnes(0) == 0 && t.rowOnes(1) == 2 && t.colOnes(2) == 0,
+          "cover table: wrong counts after covering");
+
+    vector<unsigned> selected;
+    t.coverEssentials(selected);
+    CHECK(selected.size() == 2 && selected[0] == 2 && selected[1] == 1,
+          "cover table: wrong essential rows");
+    CHECK(t.rowOnes(1) == 0 && t.rowOnes(2) == 0 && !t.isActive(69),
+          "cover table: essential columns weren't removed");
+}
+
+// makes covering table from rows (columns of row are ended by -1)
+static void makeCoverTable(CoverTable &t, unsigned colsCount, const int rows[][5], unsigned rowsCount)
+{
+    t.reset(rowsCount, colsCount);
+    for (unsigned i = 0; i < rowsCount; i++) {
+        for (unsigned j = 0; rows[i][j] >= 0; j++)
+            t.set(i, rows[i][j]);
+    }
+}
+
+// greedy covering selects essential rows first, then the largest rows
+static void testGreedyCover()
+{
+    CoverTable t;
+    const int essential[][5] = { { 0, 1, -1 }, { 1, 2, 3, -1 }, { 0, 4, -1 } };
+    makeCoverTable(t, 5, essential, 3);
+    vector<unsigned> selected;
+    GreedyCover(t).solve(selected);
+    CHECK(selected.size() == 2 && selected[0] == 1 && selected[1] == 2,
+          "greedy cover: essential rows weren't selected");
+
+    // the largest row isn't in the minimum cover (rows 0 and 1)
+    const int largest[][5] = { { 0, 1, 2, -1 }, { 3, 4, 5, -1 }, { 1, 2, 3, 4, -1 },
+        { 0, -1 }, { 5, -1 } };
+    makeCoverTable(t, 6, largest, 5);
+    GreedyCover greedy(t);
+    selected.clear();
+    greedy.solve(selected);
+    CHECK(selected.size() == 3 && selected[0] == 2 && selected[1] == 0 && selected[2] == 1,
+          "greedy cover: wrong order of the largest rows");
+    CHECK(greedy.next() == -1, "greedy cover: row selected after covering");
+}
+
+// exact covering finds the minimum cover which greedy one misses and
+// the minimum cover of the cyclic core
+static void testExactCoverTable()
+{
+    CoverTable t, greedyTable;
+    const int largest[][5] = { { 0, 1, 2, -1 }, { 3, 4, 5, -1 }, { 1, 2, 3, 4, -1 },
+        { 0, -1 }, { 5, -1 } };
+    makeCoverTable(t, 6, largest, 5);
+    makeCoverTable(greedyTable, 6, largest, 5);
+    vector<unsigned> selected;
+    GreedyCover(greedyTable).solve(selected);
+    ExactCover exact(t);
+    CHECK(exact.solve(selected), "exact cover: nodes limit exceeded");
+    sort(selected.begin(), selected.end());
+    CHECK(selected.size() == 2 && selected[0] == 0 && selected[1] == 1,
+          "exact cover: " << selected.size() << " rows (2 expected)");
+
+    // prime implicants of f(a,b,c) = sum m(0,1,2,5,6,7) - no essential row
+    // and no dominance, every row covers two columns of the cycle
+    const int cyclic[][5] = { { 0, 1, -1 }, { 1, 2, -1 }, { 2, 3, -1 }, { 3, 4, -1 },
+        { 4, 5, -1 }, { 5, 0, -1 } };
+    makeCoverTable(t, 6, cyclic, 6);
+    selected.clear();
+    for (unsigned i = 0; i < 6; i++)
+        selected.push_back(i);
+    CHECK(ExactCover(t).solve(selected) && selected.size() == 3,
+          "exact cover cyclic core: " << selected.size() << " rows (3 expected)");
+}
+
+// cyclic function by kernel - exact covering doesn't give more implicants
+// than greedy one and gives the minimum
+static void testCyclicCore()
+{
+    int v[] = { 1, 1, 1, 0, 0, 1, 1, 1 };
+    vector<int> values(v, v + 8);
+    Kernel *kernel = Kernel::instance();
+    kernel->setAlgorithm(Kernel::QM);
+    kernel->setExactCover(false);
+    kernel->setFormula(makeFormula(values, 3, true));
+    kernel->minimizeFormula();
+    unsigned greedySize = kernel->getMinimizedFormula()->getSize();
+
+    kernel->setExactCover(true);
+    kernel->minimizeFormula();
+    const Formula *mf = kernel->getMinimizedFormula();
+    CHECK(hasValues(mf, values, 3), "Kernel cyclic core: wrong minimized function");
+    CHECK(mf->getSize() <= greedySize && mf->getSize() == 3, "Kernel cyclic core: "
+          << mf->getSize() << " implicants (greedy " << greedySize << ")");
+    kernel->setExactCover(false);
+    Kernel::destroy();
+}
+
+// independent blocks of covering table (rows without columns are skipped)
+static void testCoverBlocks()
+{
+    CoverTable t;
+    const int rows[][5] = { { 0, 1, -1 }, { 2, -1 }, { 1, 5, -1 }, { 2, 3, -1 }, { 4, -1 } };
+    makeCoverTable(t, 6, rows, 5);
+    t.cover(4);
+    CoverBlocks blocks(t);
+    CHECK(blocks.count() == 2, "cover blocks: " << blocks.count() << " blocks");
+    if (blocks.count() != 2)
+        return;
+
+    unsigned r0[] = { 0, 2 }, c0[] = { 0, 1, 5 }, r1[] = { 1, 3 }, c1[] = { 2, 3 };
+    CHECK(blocks.rows(0) == vector<unsigned>(r0, r0 + 2)
+          && blocks.columns(0) == vector<unsigned>(c0, c0 + 3)
+          && blocks.rows(1) == vector<unsigned>(r1, r1 + 2)
+          && blocks.columns(1) == vector<unsigned>(c1, c1 + 2),
+          "cover blocks: wrong rows or columns of blocks");
+
+    CoverTable bt;
+    blocks.makeTable(1, bt);
+    CHECK(bt.rowsCount() == 2 && bt.colsCount() == 2 && bt.test(0, 0) && !bt.test(0, 1)
+          && bt.test(1, 0) && bt.test(1, 1), "cover blocks: wrong table of the block");
+}
+
+// exact covering set by kernel doesn't give more implicants than greedy one
+static void testExactCover()
+{
+    Kernel *kernel = Kernel::instance();
+    kernel->setAlgorithm(Kernel::QM);
+    srand(54321);
+    for (int iter = 0; iter < 100; iter++) {
+        unsigned n = 3 + rand() % 6;
+        vector<int> values(1 << n);
+        for (unsigned i = 0; i < values.size(); i++)
+            values[i] = (rand() % 10 < 4)? 1: ((rand() % 10 == 0)? 2: 0);
+
+        kernel->setExactCover(false);
+        kernel->setFormula(makeFormula(values, n, true));
+        kernel->minimizeFormula();
+        unsigned greedySize = kernel->getMinimizedFormula()->getSize();
+
+        kernel->setExactCover(true);
+        kernel->minimizeFormula();
+        const Formula *mf = kernel->getMinimizedFormula();
+        CHECK(hasValues(mf, values, n), "Kernel exact cover iteration " << iter
+              << ": wrong minimized function");
+        CHECK(mf->getSize() <= greedySize, "Kernel exact cover iteration " << iter
+              << ": " << mf->getSize() << " implicants (greedy " << greedySize << ")");
+    }
+    kernel->setExactCover(false);
+    Kernel::destroy();
+}
+
+// task counting runs of indexes
+class CountTask : public ThreadTask
+{
+public:
+    CountTask(unsigned n) : runs(n, 0) {}
+    void run(unsigned idx)
+    {
+        MutexLocker locker(mutex);
+        runs[idx]++;
+    }
+
+    vector<int> runs;
+
+private:
+    Mutex mutex;
+};
+
+// every index of the task is run once for any number of threads
+static void testThreadPool()
+{
+    ThreadPool *pool = ThreadPool::instance();
+    unsigned counts[] = { 1, 2, 4 };
+    for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        pool->setThreadsCount(counts[c]);
+        for (unsigned n = 0; n < 300; n += 37) {
+            CountTask task(n);
+            pool->run(task, n);
+            CHECK(count(task.runs.begin(), task.runs.end(), 1) == int(n), "thread pool "
+                  << counts[c] << " threads: indexes of " << n << " weren't run once");
+        }
+    }
+    ThreadPool::destroy();
+}
+
+// names are kept once, references to names stay valid when the table grows
+static void testSymbolTable()
+{
+    SymbolTable *st = SymbolTable::instance();
+    int id = st->intern("first_name");
+    const string &name = st->getName(id);
+    for (int i = 0; i < 1000; i++)
+        st->intern(string("v") + char('a' + i % 26) + char('a' + i / 26));
+    CHECK(name == "first_name", "symbol table: name reference was moved");
+    CHECK(st->intern("first_name") == id && st->find("first_name") == id,
+          "symbol table: name was added twice");
+    CHECK(st->find("unknown_name") == -1, "symbol table: unknown name was found");
+
+    CHECK(SymbolTable::isValidName("x_1[2]"), "symbol table: valid name refused");
+    CHECK(!SymbolTable::isValidName("1x") && !SymbolTable::isValidName(""),
+          "symbol table: invalid name accepted");
+    CHECK(!SymbolTable::isValidName("\xe9t\xe9") && !SymbolTable::isValidName("a\xff"),
+          "symbol table: name with high bytes accepted");
+
+    // names of formulas are kept after the kernel is deleted
+    Formula *f = new Formula(3, string("outlives"));
+    string var = f->getVar(0);
+    Kernel::instance();
+    Kernel::destroy();
+    SymbolTable::instance()->intern("after_kernel");
+    CHECK(SymbolTable::instance() == st && f->getName() == "outlives" && f->getVar(0) == var,
+          "symbol table: names were lost with the kernel");
+    delete f;
+}
+
+// functions with more variables than Formula::MAX_INDEX_VARS are kept
+// as cubes (minterms couldn't be saved)
+static void testWideFunctions()
+{
+    const unsigned n = 40;
+    Formula *f = new Formula(n, string("f"));
+    f->setTermValue(wideCube(n, "11"), OutputValue::ONE);
+    f->setTermValue(wideCube(n, "10"), OutputValue::ONE);
+    f->setTermValue(wideCube(n, "0110"), OutputValue::ONE);
+
+    QuineMcCluskey qm;
+    bool refused = false;
+    try {
+        delete qm.minimize(f, false);
+    }
+    catch (InvalidVarsExc &) {
+        refused = true;
+    }
+    CHECK(refused, "wide function: QM didn't refuse " << n << " variables");
+
+    Espresso es;
+    Formula *mf = es.minimize(f, false);
+    CHECK(mf->getSize() == 2, "wide function: Espresso gives " << mf->getSize() << " cubes");
+    for (Formula::const_iterator it = f->begin(); it != f->end(); ++it) {
+        bool covered = false;
+        for (Formula::const_iterator mit = mf->begin(); mit != mf->end() && !covered; ++mit)
+            covered = mit->implies(*it);
+        CHECK(covered, "wide function: cube isn't covered by Espresso");
+    }
+    delete mf;
+
+    // selected output of multi-output function isn't expanded to minterms
+    Formula *g = new Formula(n, string("g"));
+    g->setTermValue(wideCube(n, "001"), OutputValue::ONE);
+    vector<Formula *> fs;
+    fs.push_back(f);
+    fs.push_back(g);
+    Kernel *kernel = Kernel::instance();
+    kernel->setFormulas(fs);
+    kernel->selectFormula(0);
+    CHECK(kernel->getFormula() && kernel->getFormula()->getSize() == 3,
+          "wide function: selected output wasn't kept as cubes");
+    kernel->setAlgorithm(Kernel::QM);
+    kernel->minimizeFormula();
+    CHECK(kernel->getMinimizedFormula() == 0, "wide function: QM result by kernel");
+    kernel->setAlgorithm(Kernel::ESPRESSO);
+    kernel->minimizeFormula();
+    CHECK(kernel->getMinimizedFormula() && kernel->getMinimizedFormula()->getSize() == 2,
+          "wide function: no Espresso result by kernel");
+    kernel->setAlgorithm(Kernel::QM);
+    Kernel::destroy();
+}
+
+int main()
+{
+    testThreadPool();
+    testSymbolTable();
+    testContainerWidths();
+    testTermsHash();
+    testTermsTree();
+    testArena();
+    testCopyOnWrite();
+    testConstIterator();
+    testMintermIterator();
+    testComplement();
+    testTermsBatch();
+    testBitMatrix();
+    testEspressoCover();
+    testEspressoComplement();
+    testCofactorView();
+    testTautology();
+
+    QuineMcCluskey qm;
+    testPos(&qm, "QM");
+    testRandom(&qm, "QM");
+
+    BitmapQuineMcCluskey bqm;
+    testPos(&bqm, "Bitmap QM");
+    testRandom(&bqm, "Bitmap QM");
+    testBitmapCubes();
+
+    Consensus cs;
+    testPos(&cs, "Consensus");
+    testRandom(&cs, "Consensus");
+    testDenseConsensus();
+
+    Espresso es;
+    testPos(&es, "Espresso");
+    testRandom(&es, "Espresso");
+    testPosWidths();
+
+    testCoverTable();
+    testGreedyCover();
+    testExactCoverTable();
+    testCoverBlocks();
+    testExactCover();
+    testCyclicCore();
+    testWideFunctions();
+
+    if (failures)
+        cerr << failures << " checks failed" << endl;
+    else
+        cout << "All tests passed" << endl;
+    return failures? 1: 0;
+}
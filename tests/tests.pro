@@ -0,0 +1,9 @@
+# Bmin kernel tests (console application without Qt)
+TEMPLATE = app
+CONFIG += console \
+    warn_on
+CONFIG -= qt
+TARGET = kerneltest
+SOURCES += kerneltest.cpp
+unix:LIBS += -lpthread
+include(../kernel/kernel.pri)